@@ -0,0 +1,423 @@
+#ifndef EYTZINGER_INDEX_HPP
+# define EYTZINGER_INDEX_HPP
+
+# include <memory>
+# include <functional>
+# include "../Vector/vector.hpp"
+# include "map.hpp"
+# ifdef __AVX2__
+#  include <immintrin.h>
+# endif
+
+// https://arxiv.org/abs/1509.05053 (Khuong y Morin, "Array layouts for comparison-based searching")
+// Índice estático de solo lectura para claves ordenadas. En lugar de guardar las claves en orden (como en
+// un vector ordenado sobre el que se haría una búsqueda binaria) se guardan en el orden en que se
+// visitarían recorriendo por niveles (BFS) un árbol binario de búsqueda completo: la raíz en la posición 1,
+// y los hijos del nodo i en las posiciones 2i y 2i+1. Es la misma numeración que usa un heap.
+//
+//				orden:	1 2 3 4 5 6 7					   4
+//				eytzinger:	_ 4 2 6 1 3 5 7			   2       6
+//											 		 1   3   5   7
+//
+// La ventaja es que los primeros niveles del árbol quedan juntos al principio del array (y por tanto
+// siempre en caché), y los 16 descendientes de un nodo 4 niveles más abajo (para claves de 4 bytes)
+// están seguidos en la misma línea de caché, así que se pueden pedir por adelantado con un prefetch
+// mientras se comparan los niveles intermedios.
+// La búsqueda no tiene saltos condicionales que dependan de la clave: en cada nivel se avanza a 2i o a
+// 2i+1 sumando directamente el resultado de la comparación, así que no hay fallos de predicción.
+// El índice no se puede modificar una vez construido. Si cambian las claves hay que volver a construirlo.
+
+namespace ft
+{
+	// Búsqueda de varias claves a la vez con AVX2. Por defecto no procesa ninguna (devuelve 0) y el
+	// índice hace la búsqueda escalar. Solo se especializa para claves int comparadas con std::less, que es
+	// lo que se puede cargar con un gather de 8 enteros de 32 bits.
+
+	template <class Key, class Compare>
+	struct eytzinger_batch
+	{
+		static size_t search(const Key*, size_t, const Key*, size_t, size_t*)
+		{
+			return (0);
+		}
+	};
+
+# ifdef __AVX2__
+
+	// Cada iteración del bucle baja un nivel en las 8 búsquedas a la vez. Las que ya se han salido del
+	// árbol (índice > n) quedan desactivadas en la máscara y no vuelven a leer memoria ni a cambiar.
+	// Los índices se guardan en enteros de 32 bits, así que solo se usa si 2n+1 cabe en un int.
+
+	template <>
+	struct eytzinger_batch<int, std::less<int> >
+	{
+		static size_t search(const int* keys, size_t n, const int* queries, size_t count, size_t* slots)
+		{
+			if (n >= (static_cast<size_t>(1) << 30))
+				return (0);
+
+			const __m256i	one = _mm256_set1_epi32(1);
+			const __m256i	limit = _mm256_set1_epi32(static_cast<int>(n) + 1);
+			size_t			done = 0;
+			int				tmp[8];
+
+			for (; done + 8 <= count; done += 8)
+			{
+				__m256i	q = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(queries + done));
+				__m256i	idx = one;
+				__m256i	active = _mm256_cmpgt_epi32(limit, idx);
+
+				while (!_mm256_testz_si256(active, active))
+				{
+					__m256i	val = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), keys, idx, active, 4);
+					__m256i	lt = _mm256_cmpgt_epi32(q, val);						// -1 si la clave del nodo es < que la buscada
+					__m256i	next = _mm256_sub_epi32(_mm256_add_epi32(idx, idx), lt);	// 2i + 1 o 2i
+					idx = _mm256_blendv_epi8(idx, next, active);
+					active = _mm256_cmpgt_epi32(limit, idx);
+				}
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp), idx);
+				for (int j = 0; j < 8; j++)
+					slots[done + j] = static_cast<size_t>(tmp[j]);
+			}
+			return (done);
+		}
+	};
+
+# endif
+
+	template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key> >
+	class eytzinger_index
+	{
+		public:
+			typedef Key											key_type;
+			typedef Compare										key_compare;
+			typedef Alloc										allocator_type;
+			typedef size_t										size_type;
+
+		private:
+			size_type				_size;
+			size_type				_line;			// Claves que caben en una línea de caché de 64 bytes
+			size_type				_block_len;		// Claves reservadas en _block (incluye el hueco para alinear)
+			allocator_type			_alloc;
+			key_compare				_key_cmp;
+			key_type*				_block;			// Memoria tal y como la devuelve el allocator
+			key_type*				_keys;			// _keys[1] es la raíz. _keys[0] no se usa
+			size_type				_height;		// Nivel del último nivel del árbol (la raíz es el 0)
+			size_type				_last;			// Claves que hay en el último nivel
+
+		public:
+
+		/////////////////////////     Constructors      /////////////////////////////////
+
+			// Recibe un vector que ya debe estar ordenado según Compare. La posición que devuelve lower_bound()
+			// es la misma que tiene la clave en este vector, así que se puede usar directamente como índice.
+
+			explicit eytzinger_index(const ft::vector<key_type>& sorted, const key_compare& comp = key_compare(),
+				const allocator_type& alloc = allocator_type()) :
+				_size(0),
+				_line(1),
+				_block_len(0),
+				_alloc(alloc),
+				_key_cmp(comp),
+				_block(NULL),
+				_keys(NULL),
+				_height(0),
+				_last(0)
+			{
+				this->_init(sorted.size());
+				this->_build(sorted.begin(), 1);
+			}
+
+			// Construye el índice con las claves de un mapa (que ya están ordenadas). La posición que devuelve
+			// lower_bound() es el número de veces que habría que incrementar begin() para llegar al elemento.
+
+			template <class T, class MapAlloc, size_t N, class P>
+			explicit eytzinger_index(const ft::map<key_type, T, key_compare, MapAlloc, N, P>& src,
+				const allocator_type& alloc = allocator_type()) :
+				_size(0),
+				_line(1),
+				_block_len(0),
+				_alloc(alloc),
+				_key_cmp(src.key_comp()),
+				_block(NULL),
+				_keys(NULL),
+				_height(0),
+				_last(0)
+			{
+				this->_init(src.size());
+				this->_build(src.begin(), 1);
+			}
+
+			eytzinger_index(const eytzinger_index& src) :
+				_size(0),
+				_line(src._line),
+				_block_len(0),
+				_alloc(src._alloc),
+				_key_cmp(src._key_cmp),
+				_block(NULL),
+				_keys(NULL),
+				_height(0),
+				_last(0)
+			{
+				this->_init(src._size);
+				for (size_type i = 1; i <= this->_size; i++)
+					this->_alloc.construct(this->_keys + i, src._keys[i]);
+			}
+
+
+		///////////////////////////     Destructor      /////////////////////////////////
+
+			~eytzinger_index(void)
+			{
+				this->_release();
+			}
+
+
+		///////////////////////////     Operator=      /////////////////////////////////
+
+			eytzinger_index& operator= (const eytzinger_index& rhs)
+			{
+				if (this != &rhs)
+				{
+					this->_release();
+					this->_key_cmp = rhs._key_cmp;
+					this->_init(rhs._size);
+					for (size_type i = 1; i <= this->_size; i++)
+						this->_alloc.construct(this->_keys + i, rhs._keys[i]);
+				}
+				return (*this);
+			}
+
+
+		///////////////////////////     Capacity      /////////////////////////////////
+
+			bool empty(void) const
+			{
+				return (this->_size == 0);
+			}
+
+			size_type size(void) const
+			{
+				return (this->_size);
+			}
+
+
+		////////////////////////////     Operations      ///////////////////////////////
+
+			// Devuelve la posición en orden de la primera clave que no es menor que k, o size() si no hay
+			// ninguna. Al salir del bucle, i es el nodo hoja donde terminaría la búsqueda. Los bits a 1 del
+			// final de i son los pasos en los que se bajó por la derecha (la clave era menor), y el candidato
+			// es el último nodo en el que se bajó por la izquierda, así que basta con quitar esos bits a 1 y
+			// uno más. Si i se queda a 0 es que todas las claves eran menores.
+
+			size_type lower_bound(const key_type& k) const
+			{
+				size_type	i = 1;
+
+				while (i <= this->_size)
+				{
+					this->_prefetch(i);
+					i = 2 * i + this->_key_cmp(this->_keys[i], k);
+				}
+				return (this->_rank_of(i));
+			}
+
+			// Igual que lower_bound() pero se baja por la derecha también cuando la clave es igual.
+
+			size_type upper_bound(const key_type& k) const
+			{
+				size_type	i = 1;
+
+				while (i <= this->_size)
+				{
+					this->_prefetch(i);
+					i = 2 * i + !this->_key_cmp(k, this->_keys[i]);
+				}
+				return (this->_rank_of(i));
+			}
+
+			// Hace lower_bound() para todas las claves en [first, last) y guarda los resultados en out, que
+			// debe tener sitio para last - first posiciones. Para claves int con AVX2 disponible se resuelven
+			// de 8 en 8. Las que sobran (o todas, si no hay AVX2) se buscan una a una.
+
+			void lower_bound(const key_type* first, const key_type* last, size_type* out) const
+			{
+				size_type	count = last - first;
+				size_type	done = ft::eytzinger_batch<key_type, key_compare>::search(this->_keys, this->_size,
+								first, count, out);
+
+				for (size_type j = 0; j < done; j++)
+					out[j] = this->_rank_of(out[j]);
+				for (; done < count; done++)
+					out[done] = this->lower_bound(first[done]);
+			}
+
+			size_type count(const key_type& k) const
+			{
+				size_type	i = this->lower_bound(k);
+
+				return (i != this->_size && !this->_key_cmp(k, this->key(i)) ? 1 : 0);
+			}
+
+			// Devuelve la clave que ocupa la posición rank en orden. La posición en el array se calcula en O(1)
+			// (ver _slot_of()), pero la clave no está cerca de las de sus vecinas como en un vector.
+
+			const key_type& key(size_type rank) const
+			{
+				return (this->_keys[this->_slot_of(rank)]);
+			}
+
+			key_compare key_comp(void) const
+			{
+				return (this->_key_cmp);
+			}
+
+
+		////////////////////////     Private functions      ///////////////////////////
+
+		private:
+
+			// Reserva sitio para n claves más el hueco necesario para que _keys quede alineado a 64 bytes.
+			// Así los 64 / sizeof(Key) hijos de un mismo nivel que se piden en el prefetch empiezan justo al
+			// principio de una línea de caché.
+
+			void _init(size_type n)
+			{
+				this->_size = n;
+				this->_line = (sizeof(key_type) < 64 && 64 % sizeof(key_type) == 0) ? 64 / sizeof(key_type) : 1;
+				this->_block_len = n + 1 + this->_line;
+				this->_block = this->_alloc.allocate(this->_block_len);
+				this->_keys = this->_block;
+				if (this->_line > 1)
+				{
+					size_t	misalign = reinterpret_cast<size_t>(this->_block) % 64;
+					if (misalign)
+						this->_keys += (64 - misalign) / sizeof(key_type);
+				}
+				this->_height = (n ? _log2(n) : 0);
+				this->_last = n - ((static_cast<size_type>(1) << this->_height) - 1);
+			}
+
+			void _release(void)
+			{
+				if (this->_block == NULL)
+					return ;
+				for (size_type i = 1; i <= this->_size; i++)
+					this->_alloc.destroy(this->_keys + i);
+				this->_alloc.deallocate(this->_block, this->_block_len);
+				this->_block = NULL;
+				this->_keys = NULL;
+				this->_size = 0;
+			}
+
+			// Recorre el árbol implícito en orden (izquierda, nodo, derecha) a la vez que avanza por la
+			// secuencia ordenada, así cada clave cae en la posición BFS que le corresponde.
+
+			template <class Iterator>
+			Iterator _build(Iterator it, size_type i)
+			{
+				if (i <= this->_size)
+				{
+					it = this->_build(it, 2 * i);
+					this->_alloc.construct(this->_keys + i, _key_of(*it));
+					++it;
+					it = this->_build(it, 2 * i + 1);
+				}
+				return (it);
+			}
+
+			static const key_type& _key_of(const key_type& k)
+			{
+				return (k);
+			}
+
+			template <class T>
+			static const key_type& _key_of(const ft::pair<const key_type, T>& p)
+			{
+				return (p.first);
+			}
+
+			size_type _rank_of(size_type i) const
+			{
+# if defined(__GNUC__)
+				i >>= __builtin_ffsl(~static_cast<long>(i));
+# else
+				while (i & 1)
+					i >>= 1;
+				i >>= 1;
+# endif
+				return (i == 0 ? this->_size : this->_rank_in_order(i));
+			}
+
+			// Las posiciones en orden salen de la forma del árbol, sin guardarlas. Si el árbol estuviera lleno
+			// hasta el último nivel (2^(_height+1) - 1 claves), el nodo p-ésimo del nivel d tendría la posición
+			// (2p+1) * 2^(_height-d) - 1, y las del último nivel serían las pares: 0, 2, 4... Como el último
+			// nivel solo tiene sus _last primeros nodos, a esa posición se le restan los huecos del último nivel
+			// que quedan antes. _slot_of() hace la cuenta al revés: hasta 2 * _last las posiciones son las del
+			// árbol lleno, y a partir de ahí solo quedan las impares.
+
+			size_type _rank_in_order(size_type i) const
+			{
+				size_type	d = _log2(i);
+				size_type	r = ((2 * (i - (static_cast<size_type>(1) << d)) + 1) << (this->_height - d)) - 1;
+				size_type	before = (r + 1) / 2;			// Nodos del último nivel (del árbol lleno) antes de r
+
+				return (before > this->_last ? r - (before - this->_last) : r);
+			}
+
+			size_type _slot_of(size_type rank) const
+			{
+				size_type	r = (rank < 2 * this->_last ? rank : 2 * (rank - this->_last) + 1);
+				size_type	up = _trailing_zeros(r + 1);	// Niveles por encima del último
+
+				return ((static_cast<size_type>(1) << (this->_height - up)) + ((r + 1) >> (up + 1)));
+			}
+
+			static size_type _log2(size_type x)
+			{
+# if defined(__GNUC__)
+				return (sizeof(unsigned long) * 8 - 1 - __builtin_clzl(x));
+# else
+				size_type	l = 0;
+
+				while (x >>= 1)
+					l++;
+				return (l);
+# endif
+			}
+
+			static size_type _trailing_zeros(size_type x)
+			{
+# if defined(__GNUC__)
+				return (__builtin_ctzl(x));
+# else
+				size_type	t = 0;
+
+				while (!(x & 1))
+				{
+					x >>= 1;
+					t++;
+				}
+				return (t);
+# endif
+			}
+
+			// Pide la línea de caché donde empiezan los descendientes de i varios niveles más abajo. En los
+			// últimos niveles esa posición ya está fuera del array, y aunque el prefetch no fallaría, calcular
+			// un puntero fuera del bloque no es válido, así que se pide la última clave en su lugar (el
+			// compilador lo hace con un cmov, sin saltos).
+
+			void _prefetch(size_type i) const
+			{
+# if defined(__GNUC__)
+				size_type	j = i * this->_line;
+
+				__builtin_prefetch(this->_keys + (j < this->_size ? j : this->_size));
+# else
+				static_cast<void>(i);
+# endif
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef KEY_PREFIX_HPP
+# define KEY_PREFIX_HPP
+
+# include <string>
+# include <functional>
+
+// Caché del principio de la clave en cada nodo, para los árboles con claves std::string.
+// Comparar dos std::string obliga a leer el buffer de cada una, que está en otro sitio de la memoria,
+// así que al bajar por el árbol cada nivel cuesta un fallo de caché más: el del nodo y el del texto de
+// su clave. Para evitarlo cada nodo guarda, junto a los punteros, los 8 primeros bytes de la clave como
+// un entero (ver string_prefix()), y la clave buscada se convierte igual una sola vez al empezar. Si los
+// dos enteros son distintos ya dicen cuál va antes sin leer las cadenas, y solo si son iguales (las dos
+// claves empiezan por los mismos 8 bytes) se llama al comparador.
+// Es opcional, porque cada nodo ocupa 8 bytes más y solo ahorra algo en los niveles de arriba del
+// árbol: más abajo las claves de cada subárbol se parecen cada vez más, casi siempre empiezan por los
+// mismos 8 bytes y hay que compararlas enteras igualmente. Solo se puede hacer si el orden del
+// comparador es el de los bytes de la cadena, así que se pide usando prefix_less como comparador.
+// key_prefix<Key, Compare> dice si se usa para ese par de tipos y cómo se calcula el prefijo de una
+// clave, y node_prefix<true> es la parte del nodo que lo guarda (node_prefix<false> está vacía y no
+// ocupa nada). Para usarlo con otro tipo de clave o de comparador basta con especializar key_prefix.
+
+namespace ft
+{
+	// Los 8 primeros bytes de s, el primero en el byte más alto y rellenando con ceros si es más corta.
+	// Como std::string compara los bytes sin signo, si dos prefijos son distintos el menor es el de la
+	// cadena menor (una cadena más corta que otra que empieza igual tiene ceros donde la otra tiene
+	// algo). Si son iguales no se sabe nada: o las dos empiezan por los mismos 8 bytes o solo se
+	// diferencian en ceros del final.
+
+	inline unsigned long long string_prefix(const std::string& s)
+	{
+		unsigned long long	ret = 0;
+		size_t				len = (s.size() < 8 ? s.size() : 8);
+
+		for (size_t i = 0; i < len; i++)
+			ret |= static_cast<unsigned long long>(static_cast<unsigned char>(s[i])) << (56 - 8 * i);
+		return (ret);
+	}
+
+	// Ordena igual que std::less, pero con claves std::string le dice al árbol que guarde y use el prefijo
+	// (ft::map<std::string, T, ft::prefix_less<std::string> >).
+
+	template <class Key>
+	struct prefix_less : public std::binary_function<Key, Key, bool>
+	{
+		bool operator() (const Key& a, const Key& b) const
+		{
+			return (a < b);
+		}
+	};
+
+	template <class Key, class Compare>
+	struct key_prefix
+	{
+		static const bool	enabled = false;
+
+		static unsigned long long get(const Key&)
+		{
+			return (0);
+		}
+	};
+
+	template <>
+	struct key_prefix<std::string, ft::prefix_less<std::string> >
+	{
+		static const bool	enabled = true;
+
+		static unsigned long long get(const std::string& k)
+		{
+			return (ft::string_prefix(k));
+		}
+	};
+
+	// La parte del nodo que guarda el prefijo. El árbol lo pone al crear cada nodo.
+
+	template <bool Cached>
+	struct node_prefix
+	{
+		void set_key_prefix(unsigned long long)
+		{}
+
+		unsigned long long key_prefix(void) const
+		{
+			return (0);
+		}
+	};
+
+	template <>
+	struct node_prefix<true>
+	{
+		unsigned long long	prefix;
+
+		node_prefix(void) :
+			prefix(0)
+		{}
+
+		void set_key_prefix(unsigned long long p)
+		{
+			this->prefix = p;
+		}
+
+		unsigned long long key_prefix(void) const
+		{
+			return (this->prefix);
+		}
+	};
+}
+
+#endif
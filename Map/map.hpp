@@ -1,6 +1,8 @@
 #ifndef MAP_HPP
 #define MAP_HPP
 
+# include <iostream>
+# include <memory>
 # include "../common/reverse_iterator.hpp"
 # include "../common/enable_if.hpp"
 # include "../common/is_integral.hpp"
@@ -8,12 +10,23 @@
 # include "../common/equal.hpp"
 # include "pair.hpp"
 # include "tree_iterator.hpp"
+# include "tree.hpp"
 
 namespace ft
 {
 
+	// InlineN no es de la stl: es el número de elementos que el mapa guarda dentro del propio objeto, sin
+	// reservar memoria (ver tree.hpp). Con el 0 por defecto el mapa es el de siempre. Sirve para cuando hay
+	// muchísimos mapas con muy pocos elementos, por ejemplo ft::map<int, int, std::less<int>,
+	// std::allocator<ft::node<ft::pair<const int, int> > >, 8>.
+	// Policy tampoco es de la stl: con ft::splay_tree_policy o ft::sampled_splay_tree_policy find() e
+	// insert() suben el elemento a la raíz (siempre, o una de cada 32 veces), para cuando unas pocas claves
+	// se buscan muchísimo más que el resto (ver tree_policy.hpp). Con el ft::plain_tree_policy por defecto
+	// el mapa es el de siempre.
+
 	template <class Key, class T, class Compare = std::less<Key>,
-		class Alloc = std::allocator<ft::node<ft::pair<const Key,T> > > >
+		class Alloc = std::allocator<ft::node<ft::pair<const Key,T> > >, size_t InlineN = 0,
+		class Policy = ft::plain_tree_policy>
 	class map
 	{
 		public:
@@ -27,7 +40,7 @@ namespace ft
 			typedef typename allocator_type::const_reference					const_reference;
 			typedef typename allocator_type::pointer							pointer;
 			typedef typename allocator_type::const_pointer						const_pointer;
-			typedef ft::node<value_type>										node_type;
+			typedef ft::node<value_type, ft::key_prefix<Key, Compare>::enabled>	node_type;
 			typedef node_type*													node_ptr;
 			typedef ft::tree_iterator<value_type, node_type>					iterator;
 			typedef ft::tree_iterator<const value_type, node_type>				const_iterator;
@@ -56,12 +69,48 @@ namespace ft
 					}
 			};
 
+			typedef ft::tree<key_type, value_type, ft::select_first<value_type>, key_compare, allocator_type, InlineN, Policy>	tree_type;
+
+			// Cursor para buscar claves cercanas a la anterior (una serie temporal recorrida con saltos
+			// pequeños, o la mezcla de varias secuencias ordenadas). Recuerda el último elemento encontrado y
+			// la siguiente búsqueda empieza desde él: sube solo hasta donde hace falta y baja desde ahí, así
+			// que una clave a d elementos de distancia cuesta O(log d) en lugar de O(log n) (ver
+			// tree::finger_lower_bound()). Puede ir hacia delante y hacia atrás. Con claves al azar no
+			// compensa: sube hasta la raíz y vuelve a bajar, el doble de nodos que find().
+			// Igual que un iterador, deja de ser válido si se borra el elemento en el que está (o con clear(),
+			// compact() o swap()); reset() lo vuelve a dejar en la raíz. Insertar y borrar otros elementos no
+			// le afecta.
+
+			class finger
+			{
+				private:
+					map*		_map;
+					node_ptr	_node;					// Último elemento encontrado, o NULL para empezar desde la raíz
+
+				public:
+					explicit finger(map& m) :
+						_map(&m),
+						_node(NULL)
+					{}
+
+					iterator find(const key_type& k)
+					{
+						return (this->_map->get_tree().finger_find(this->_node, k));
+					}
+
+					iterator lower_bound(const key_type& k)
+					{
+						return (this->_map->get_tree().finger_lower_bound(this->_node, k));
+					}
+
+					void reset(void)
+					{
+						this->_node = NULL;
+					}
+			};
+
 		private:
-			node_ptr		_root;
-			allocator_type	_alloc;
-			size_type		_size;
-			key_compare		_key_cmp;
-			value_compare	_val_cmp;
+			tree_type		_tree;
 
 		public:
 
@@ -71,21 +120,13 @@ namespace ft
 			// Construye un objeto del tipo key_compare, que us usado por el contenedor para comparar las claves. Por
 			// defecto es un objeto de tipo "less". Para usarlo se le pasan dos claves y devuelve "true" si la primera
 			// debe ir antes que la segunda y "false" en el resto de casos.
-			// También construye por defecto otro objeto de tipo allocator_type (para gestionar la memoria). Este objeto
-			// se usa primero para reservar memoria para el elemento raíz. Y después para construir el nodo raíz con el
-			// metodo construct() que recibe como primer parámetro un puntero al espacio reservado en la instrucción
-			// anterior y como segundo el objeto que se debe construir en el espacio apuntado.
+			// También construye por defecto otro objeto de tipo allocator_type (para gestionar la memoria). Los dos
+			// se le pasan al árbol (ver tree.hpp), que es quien guarda los elementos. No se reserva
+			// nada hasta la primera inserción.
 
 			explicit map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
-				_root(),
-				_alloc(alloc),
-				_size(0),
-				_key_cmp(comp),
-				_val_cmp(_key_cmp)
-			{
-				this->_root = this->_alloc.allocate(1);
-				this->_alloc.construct(this->_root, node_type());
-			}
+				_tree(comp, alloc)
+			{}
 
 			// Constuye un map con los elementos en el rango determinado por los iteradores "first" y "last".
 			// Es como el constructor anterior solo que hace una inserción de elmentos.
@@ -93,39 +134,22 @@ namespace ft
 			template <class InputIterator>
 			map(typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type first, InputIterator last,
 				const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
-				_root(),
-				_alloc(alloc),
-				_size(0),
-				_key_cmp(comp),
-				_val_cmp(_key_cmp)
-			{
-				this->_root = this->_alloc.allocate(1);
-				this->_alloc.construct(this->_root, node_type());
+				_tree(comp, alloc)
+			{
 				this->insert(first, last);
 			}
 
 			// Constructor copia
 
 			map(const map& src) :
-				_root(),
-				_alloc(allocator_type()),
-				_size(0),
-				_key_cmp(key_compare()),
-				_val_cmp(_key_cmp)
-			{
-				this->_root = this->_alloc.allocate(1);
-				this->_alloc.construct(this->_root, node_type());
-				*this = src;
-			}
+				_tree(src._tree)
+			{}
 
 
 		///////////////////////////     Destructor      /////////////////////////////////
 
-			virtual ~map(void)
-			{
-				this->clear();
-				this->_alloc.deallocate(this->_root, 1);
-			}
+			~map(void)
+			{}
 
 
 		///////////////////////////     Operator=      /////////////////////////////////
@@ -133,40 +157,36 @@ namespace ft
 			map& operator= (map const &rhs)
 			{
 				if (this != &rhs)
-				{
-					this->clear();
-					this->insert(rhs.begin(), rhs.end());
-				}
+					this->_tree = rhs._tree;
 				return (*this);
 			}
 
 
 		///////////////////////////     Iterators      /////////////////////////////////
 
-			// Devuelve el resultado de llamar al constructor iterator() que es un alias para tree_iterator
-			// al que se le pasa como parámetro la función leftmost(), que devuelve la posición más a la
-			// izquierda del árbol.
+			// Devuelve un iterador a la posición más a la izquierda del árbol, que es la del elemento con
+			// la clave más pequeña.
 
 			iterator begin(void)
 			{
-				return (iterator(leftmost(this->_root)));
+				return (this->_tree.begin());
 			}
 
 			const_iterator begin(void) const
 			{
-				return (const_iterator(leftmost(this->_root)));
+				return (this->_tree.begin());
 			}
 
 			// Igual que begin() pero en este caso devuelve la posición final, la más a la derecha.
 
 			iterator end(void)
 			{
-				return (iterator(rightmost(this->_root)));
+				return (this->_tree.end());
 			}
 
 			const_iterator end(void) const
 			{
-				return (const_iterator(rightmost(this->_root)));
+				return (this->_tree.end());
 			}
 
 			reverse_iterator rbegin(void)
@@ -194,17 +214,17 @@ namespace ft
 
 			bool empty(void) const
 			{
-				return (this->_size == 0 ? true : false);
+				return (this->_tree.empty());
 			}
 
 			size_type size(void) const
 			{
-				return (this->_size);
+				return (this->_tree.size());
 			}
 
 			size_type max_size(void) const
 			{
-				return (this->_alloc.max_size());
+				return (this->_tree.max_size());
 			}
 
 
@@ -250,27 +270,13 @@ namespace ft
 			// insertado o a un elemento que ya existía previamente con esa clave. Y el booleano será
 			// "true" si se ha insertado un nuevo objeto o "false" si ya existía un elemento con dicha
 			// clave y por tanto no se ha hecho la inserción.
-			// Lo primero que debe hacer la función es chequear si ya existe una clave igual que la que
-			// se ha pasado como parámetro. Porque en el mapa las claves deben ser únicas. Y si ya
-			// existe no se hará la inserción y se devolverá un puntero al elemento donde se encontro
-			// dicha clave.
+			// Como en el mapa las claves deben ser únicas se usa insert_unique() del árbol, que antes
+			// de insertar comprueba si ya existe una clave igual que la que se ha pasado como parámetro.
 			// En cplusplus indican que una manera alternativa de insertar es con map::operator[]
 
 			ft::pair<iterator, bool> insert(const value_type& val)
 			{
-				ft::pair<iterator, bool> ret;							// Par donde guardamos los valores de retorno
-				ret.first = this->find(val.first);						// Si la clave pasada existe se guarda la posición. Si no, find() devuelve end()
-				if (ret.first == this->end())							// Si devolvió end() porque la clave no existía se mete en el if
-				{
-					node_ptr	newnode = this->_alloc.allocate(1);		// Se reserva sitio para crear un nuevo nodo
-					this->_alloc.construct(newnode, node_type(val));	// Se crea el nuevo nodo con los valores pasados como parámetro a la función insert()
-					this->_add_node(newnode);							// Se inserta el nodo creado en el mapa
-					ret.first = iterator(newnode);						// Se guarda el primer valor del par de retorno con el iterador al nuevo nodo insertado
-					ret.second = true;
-				}
-				else
-					ret.second = false;
-				return (ret);
+				return (this->_tree.insert_unique(val));
 			}
 
 			// La posición indicada como parámetro no fuerza a que el elemento sea insertado ahí, puesto que
@@ -299,54 +305,34 @@ namespace ft
 
 			void erase(iterator position)
 			{
-				this->_del_node(position.base());
+				this->_tree.erase(position);
 			}
 
 			size_type erase(const key_type& k)
 			{
-				iterator it = this->find(k);
-
-				if (it == this->end())
-					return (0);
-				this->_del_node(it.base());
-				return (1);									// Devuelve el número de elementos eliminados
+				return (this->_tree.erase_unique(k));		// Devuelve el número de elementos eliminados
 			}
 
 			void erase(iterator first, iterator last)
 			{
-				while (first != last) this->erase(first++);
+				this->_tree.erase(first, last);
 			}
 
 			// https://www.cplusplus.com/reference/map/map/swap/
 			// Cambia el contenido del mapa por el del parámetro pasado, que debe ser otro mapa del mismo
 			// tipo, aunque los tamaños pueden no ser iguales. Los iteradores y punteros existentes deben
 			// permanecer válidos (excepto los que apuntan al final del mapa).
-			// Lo que se hace es cambiar los valores necesarios usando un temporal como paso intermedio.
+			// Lo que se hace es intercambiar las raíces de los dos árboles (y sus comparadores y
+			// allocators), sin mover ningún nodo.
 
 			void swap(map& x)
 			{
-				node_ptr		tmp_root = this->_root;
-				key_compare		tmp_cmp = this->_key_cmp;
-				allocator_type	tmp_alloc = this->_alloc;
-				size_type		tmp_size = this->_size;
-
-				this->_root = x._root;
-				x._root = tmp_root;
-				this->_key_cmp = x._key_cmp;
-				x._key_cmp = tmp_cmp;
-				this->_alloc = x._alloc;
-				x._alloc = tmp_alloc;
-				this->_size = x._size;
-				x._size = tmp_size;
+				this->_tree.swap(x._tree);
 			}
 
 			void clear(void)
 			{
-				node_ptr endnode = this->end().base();			
-				endnode->parent->right = NULL;					
-				this->_recursive_clear(this->_root);
-				this->_root = endnode;
-				this->_size = 0;
+				this->_tree.clear();
 			}
 
 
@@ -357,62 +343,28 @@ namespace ft
 
 			key_compare key_comp(void) const
 			{
-				return (this->_key_cmp);
-				//return (key_compare());						
+				return (this->_tree.key_comp());
 			}
 
 			value_compare value_comp(void) const
 			{
-				return (this->_val_cmp);
-				//return (value_compare(key_compare()));
+				return (value_compare(this->key_comp()));			// Se construye al pedirlo en lugar de guardar otra copia del comparador
 			}
 
 
 		////////////////////////////     Operations      ///////////////////////////////
 
 			// Busca en el mapa un elemento con la clave pasada como parámetro y devuelve un iterador al mismo
-			// si lo encuentra. Si no, devuelve un iterador a map::end
-			// Primero crea un puntero a nodo que inicializa con la raíz del mapa pasado como this.
-			// Luego inicia el bucle para recorrer los elementos y buscar si hay coincidencia. Primero se chequea
-			// que no se haya llegado al final (que exista el elemento actual), y luego que la clave del
-			// elemento actual sea diferente a la pasada. Para hacer esto último se usa _key_cmp() que es como
-			// llamar a less. Less es una "class object function", que son instancias de una clase con una
-			// función miembro operator(). Esta función miembro permite al objeto ser usado con la misma
-			// sintaxis que una llamada a función. En este caso retorna 1 si el primer parámetro es menor
-			// que el segundo.
+			// si lo encuentra. Si no, devuelve un iterador a map::end. La búsqueda la hace el árbol.
 
 			iterator find(const key_type& k)
 			{
-				node_ptr	curr = this->_root;
-
-				while (curr && (this->_key_cmp(curr->data.first, k) || this->_key_cmp(k, curr->data.first)))
-				{
-					if (this->_key_cmp(k, curr->data.first))	// Si la clave pasada es < que la del elemento actual mueve este hacia la izquierda
-						curr = curr->left;
-					else
-						curr = curr->right;						// En caso contrario a la derecha
-				}
-				if (curr)										// Cuando el bucle termina, si current existe es que ha encontrado una coincidencia
-					return (iterator(curr));
-				else
-					return (this->end());
+				return (this->_tree.find(k));
 			}
 
 			const_iterator find(const key_type& k) const
 			{
-				node_ptr	curr = this->_root;
-
-				while (curr && (this->_key_cmp(curr->data.first, k) || this->_key_cmp(k, curr->data.first)))
-				{
-					if (this->_key_cmp(k, curr->data.first))
-						curr = curr->left;
-					else
-						curr = curr->right;
-				}
-				if (curr)
-					return (const_iterator(curr));
-				else
-					return (this->end());
+				return (this->_tree.find(k));
 			}
 
 			size_type count(const key_type& k) const
@@ -425,30 +377,12 @@ namespace ft
 
 			iterator lower_bound(const key_type& k)
 			{
-				iterator	it_beg = this->begin();
-				iterator	it_end = this->end();
-
-				while (it_beg != it_end)
-				{
-					if (!this->_key_cmp(it_beg->first, k))		// _key_cmp() funciona como less(). Devuelve 1 si el 1er parámetro es menor que el 2o
-						break;									// Así que cuando encuentre uno que no sea más pequeño (que sea = o >) saldrá del bucle
-					++it_beg;
-				}
-				return (it_beg);
+				return (this->_tree.lower_bound(k));
 			}
 
 			const_iterator lower_bound(const key_type& k) const
 			{
-				const_iterator	it_beg = this->begin();
-				const_iterator	it_end = this->end();
-
-				while (it_beg != it_end)
-				{
-					if (!this->_key_cmp(it_beg->first, k))
-						break;
-					++it_beg;
-				}
-				return (it_beg);
+				return (this->_tree.lower_bound(k));
 			}
 
 			// Devuelve un iterador apuntando al primer elemento en el contenedor cuya clave va detrás
@@ -457,30 +391,12 @@ namespace ft
 
 			iterator upper_bound(const key_type& k)
 			{
-				iterator	it_beg = this->begin();
-				iterator	it_end = this->end();
-
-				while (it_beg != it_end)
-				{
-					if (this->_key_cmp(k, it_beg->first))		// Devuelve 1 si el 1er parámetro es menor que el 2o
-						break;									// Solo entra al bucle cuando el 2o elemento es mayor que la clave pasada
-					++it_beg;
-				}
-				return (it_beg);
+				return (this->_tree.upper_bound(k));
 			}
 
 			const_iterator upper_bound(const key_type& k) const
 			{
-				const_iterator	it_beg = this->begin();
-				const_iterator	it_end = this->end();
-
-				while (it_beg != it_end)
-				{
-				if (this->_key_cmp(k, it_beg->first))
-						break;
-					++it_beg;
-				}
-				return (it_beg);
+				return (this->_tree.upper_bound(k));
 			}
 
 			// Se supone que devuelve el rango de elementos que contienen la clave pasada como parámetro.
@@ -493,20 +409,12 @@ namespace ft
 
 			ft::pair<iterator,iterator> equal_range(const key_type& k)
 			{
-				ft::pair<iterator, iterator> ret;
-
-				ret.first = this->lower_bound(k);
-				ret.second = this->upper_bound(k);
-				return (ret);
+				return (this->_tree.equal_range(k));
 			}
 
 			ft::pair<const_iterator,const_iterator>	equal_range(const key_type& k) const
 			{
-				ft::pair<const_iterator, const_iterator> ret;
-
-				ret.first = this->lower_bound(k);
-				ret.second = this->upper_bound(k);
-				return (ret);
+				return (this->_tree.equal_range(k));
 			}
 
 
@@ -514,7 +422,7 @@ namespace ft
 
 			allocator_type get_allocator(void) const
 			{
-				return (this->_alloc);
+				return (allocator_type(this->_tree.get_allocator()));
 			}
 
 
@@ -545,139 +453,72 @@ namespace ft
 				print_tree(root->left, space);
 			}
 
+			// Reemplaza el contenido del mapa por los n elementos a los que apunta first, que ya deben estar
+			// ordenados según key_comp() y sin claves repetidas (por ejemplo los de otro mapa o los de un
+			// snapshot guardado en disco). Se construyen en O(n) en un único bloque de nodos (ver
+			// tree::assign_sorted()).
+
+			template <class InputIterator>
+			void assign_sorted(InputIterator first, size_type n)
+			{
+				this->_tree.assign_sorted(first, n);
+			}
+
+			// Reemplaza el contenido del mapa por los elementos de [first, last), sin ordenar y quizá con
+			// claves repetidas (se queda el primero de cada clave, como con insert()). Los ordena y construye
+			// el árbol ya equilibrado usando threads hilos (ver tree::build_parallel()). Los iteradores tienen
+			// que poder recorrerse dos veces.
+
+			template <class ForwardIterator>
+			void build_parallel(ForwardIterator first, ForwardIterator last, size_type threads)
+			{
+				this->_tree.build_parallel(first, last, threads, true);
+			}
+
+			// Pone todos los nodos seguidos y en orden en un único bloque, y deja el árbol equilibrado (ver
+			// tree::compact()). Para mapas que viven mucho tiempo y han tenido muchas inserciones y borrados.
+			// Invalida todos los iteradores menos end().
+
+			void compact(void)
+			{
+				this->_tree.compact();
+			}
+
 		/////////////////////////     Getter      ///////////////////////////
 
-			node_ptr get_root()
+			node_ptr get_root() const
 			{
-				return (_root);
+				return (this->_tree.root());
 			}
 
+			// El árbol que hay debajo, para las funciones que trabajan con varios mapas a la vez (ver
+			// map_algebra.hpp).
 
-		////////////////////////     Private functions      ///////////////////////////
+			tree_type& get_tree()
+			{
+				return (this->_tree);
+			}
 
-		private:
+			const tree_type& get_tree() const
+			{
+				return (this->_tree);
+			}
 
-			// https://www.youtube.com/watch?v=gcULXE7ViZw&list=PL2_aWCzGMAwI3W_JlcBbtYTwiQSsOTa6P&index=36
-			// Va haciendo llamadas recursivas para borrar el árbol (o subárbol) a partir del nodo dado.
-			// Si como argumento se pasa la raíz se borrará el árbol entero.
-
-			void _recursive_clear(node_ptr curr)
-			{
-				if (curr == NULL)
-					return ;
-				this->_recursive_clear(curr->left);
-				this->_recursive_clear(curr->right);
-				this->_alloc.deallocate(curr, 1);
-			}
-
-			// Primero se comprobaría si el mapa está vació. En ese caso simplemente habría que
-			// asignar el nuevo nodo a la raíz. En caso contrario se crea un nuevo puntero
-			// apuntando a la raíz para usarlo como iterador e ir recorriendo el árbol hasta
-			// encontrar la posición en la que se debe insertar el nuevo nodo. En un árbol de
-			// tipo BST (binary search tree) cada nodo tiene solo dos posibles hijos. En los de
-			// la izquierda estarán los valores más pequeños que el de la reíz del nodo, y en la
-			// la derecha estarán los que sean más grandes. No se pueden repetir los valores de
-			// la clave (dentro del par que guarda como datos cada nodo).
-			// Para encontrar la posición solo hay que ir preguntando si el valor (en este caso
-			// de la clave) es mayor o menor que el del nodo pasado como parámetro. Si es menor
-			// hay que mover el puntero hacia el nodo de la izquierda (de modo que la raíz de
-			// ese nodo que actua como iterador sea ahora el nodo que había a la izquierda). Y si
-			// es mayor, pues lo mismo pero hacia la derecha. Y así sucesivamente hasta que se
-			// Así hasta que llegues a un sitio vacío (el puntero-iterador apunte a NULL). Y ese
-			// será el lugar donde habrá que insertar el valor. Y habrá que sumar uno a _size.
-
-			void _add_node(node_ptr to_add)
-			{
-				node_ptr*	parent = &this->_root;					// Puntero a node_ptr inicializado con la raíz del árbol
-				node_ptr*	curr = &this->_root;					// Puntero a node_ptr inicializado con la raíz del árbol
-				node_ptr	endnode = rightmost(this->_root);		// Node_ptr incializado con la dirección del nodo más a la derecha (el último=) del árbol
-				bool		which_direction;						// Boolean para ver si hay que ir hacia la izquierda o la derecha
-
-				++this->_size;										// Se aumenta el tamaño del árbol
-				while (*curr && *curr != endnode)					// La primera vez no entra pero luego creo que entra siempre
-				{
-					parent = curr;									// Cada vez que entra al bucle se igualan, pero curr cambia antes de salir y parent no
-					which_direction = _val_cmp(to_add->data, (*curr)->data);	// _val_cmp es una comparación de tipo less() que devuelve 1 si el 1er parám es < que el 2o
-					curr = (which_direction ? &(*curr)->left : &(*curr)->right);	// Si antes dio 1 guarda en curr la dirección del nodo de la izq, si no de la dcha
-				}
-				if (*curr == NULL)									// Entra cuando llega a un sitio donde insertar el nuevo elemento, y no es el último lugar del árbol
-				{
-					to_add->parent = *parent;						// Se enlaza el nuevo nodo con el nodo padre que le corresponde
-					*curr = to_add;									// Se le asigna a la dirección donde apunta curr la del nuevo nodo (curr había...
-				}													// ...sido asignado en el bucle a la correspondiente posición vacía en el árbol según su clave)
-				else
-				{													// Entra cuando hay que insertar al final del árbol, porque hay que actulizar tb el endnode (no como en el if)
-					*curr = to_add;									// Cambia el nodo vacío anclado al árbol por el nodo que hay que insertar
-					to_add->parent = endnode->parent;				// Pone como padre el padre del último nodo (en la primera inserción es NULL)
-					endnode->parent = rightmost(to_add);			// Pone como padre del ultimo nodo (que ahora es el nodo vacío) el nuevo nodo
-					rightmost(to_add)->right = endnode;				// Pone como hijo hacia la derecha al último nodo (que ahora es el nodo vacío)
-				}
-			}
-
-			// https://www.youtube.com/watch?v=gcULXE7ViZw&list=PL2_aWCzGMAwI3W_JlcBbtYTwiQSsOTa6P&index=36
-			// Si el nodo a borrar no tiene hijos o tiene solo 1 el proceso es fácil, porque solo hay
-			// que enlazar su hijo (que puede tener a su vez los hijos que sea) con su padre. Si tiene
-			// 2 hijos la cosa es más complicada y es cuando entraría en el else. En el árbol de ejemplo
-			// de abajo, si queremos borrar el 5 (que tiene 2 hijos) hay que sustituirlo por el 6 (para
-			// que se mantengan las propiedades de un árbol binario de búsqueda de a la izquierda más
-			// pequeño y a la derecha más grande) que es el más a la izquierda de la rama derecha del
-			// nodo a borrar.
-			//
-			//						10
-			//				  5           12
-			//			  2   	  4
-			//				   7     9
-			//				 6
-
-			void _del_node(node_ptr to_del)
-			{
-				if (!to_del->left)											// Si el nodo a borrar no tiene hijo a la izquierda...
-				{
-					if (!to_del->parent)									// Si no tiene padre (es la raíz)...
-						this->_root = to_del->right;						// ...se sustituye el nodo a borrar por su hijo derecho como raíz del árbol
-					else if (to_del == to_del->parent->left)				// Si el nodo a borrar tiene padre y está a la izquierda de su padre...
-						to_del->parent->left = to_del->right;				// ...se sustituye el nodo a borrar por el de la derecha (que puede estar poblado o no)
-					else													// Si el nodo a borrar tiene padre y está a la derecha de su padre...
-						to_del->parent->right = to_del->right;				// ...se sustituye el nodo a borrar por el de la derecha (que puede estar poblado o no)
-					if (to_del->right)										// Si el nodo de la derecha del nodo a borrar existe...
-						to_del->right->parent = to_del->parent;				// ...se enlaza al padre del nodo a borrar, para que no se quede descolgado tras su eliminación
-				}
-				else if (!to_del->right)									// El mismo proceso que arriba pero si el nodo a borrar no tiene hijo a la derecha
-				{															// Cuando el nodo a borrar no tiene hijos o tiene sólo a un lado, es muy fácil
-					if (!to_del->parent)									// El problema es cuando tiene dos hijos
-						this->_root = to_del->left;
-					else if (to_del == to_del->parent->left)
-						to_del->parent->left = to_del->left;
-					else
-						to_del->parent->right = to_del->left;
-					to_del->left->parent = to_del->parent;
-				}
-				else														// Si entra aquí es porque el nodo a borrar tiene hijos tanto a derecha como a izquierda
-				{
-					node_ptr	successor = leftmost(to_del->right);		// El nodo que debe ocupar la posición del nodo borrado es el más a la izquierda de la rama derecha de este
-					if (!(to_del == successor->parent))						// Si el sucesor NO es hijo directo del nodo a borrar entra en el if
-					{
-						if (successor == successor->parent->left)			// Si el sucesor está situado a la izquierda de su propio padre ...
-							successor->parent->left = successor->right;		// ...el nodo a la derecha del padre del sucesor pasaría a estar directamente a la derecha del sucesor
-						else												// CREO QUE AQUÍ NO ENTRARÍA NUNCA porque para no entrar en el if anterior el sucesor tendria que estar a la
-							successor->parent->right = successor->right;	// dcha de su propio padre y eso solo puede ser si es hijo directo (y no entraría al if anterior del anterior)
-						if (successor->right != NULL)						// Si el sucesor tiene hijo a la derecha (a la izq no podría porque entonces sería ese el sucesor)...
-							successor->right->parent = successor->parent;	// este hijo pasa a ser ahora hijo del que era el abuelo.
-						successor->right = to_del->right;					// Y como el sucesor va a ocupar el sitio del nodo a borrar, se apunta el dcho del sucesor al dcho de este
-						successor->right->parent = successor;				// Y se actuliza tb el padre del nodo a la dcha del nodo a borrar por el del sucesor, que ahora va a ser su padre
-					}
-					if (!to_del->parent)									// Si el nodo a borrar no tiene padre (es la raíz)...
-						this->_root = successor;							// ..se sustituye la raíz por el sucesor
-					else if (to_del == to_del->parent->left)				// Si el nodo a borrar está a la izquierda de su padre...
-						to_del->parent->left = successor;					// ...se actualiza ese enlace para que ahora el padre, por su izquierda, tenga al sucesor
-					else													// Si no entró en el if anterior es porque el nodo a borrar está a la derecha de su padre y entonces...
-						to_del->parent->right = successor;					// ...hay que actualizar el enclace para que ahora el padre, por su derecha, tenga al sucesor
-					successor->parent = to_del->parent;						// Se actualiza el enlace para que ahora el padre del sucesor sea el padre que tenía el nodo a borrar
-					successor->left = to_del->left;							// Se actualiza el enlace para que ahora el nodo a la izquierda del sucesor sea el que tenía el nodo a borrar
-					successor->left->parent = successor;					// Y se actualiza tb este otro enlace
-				}
-				--this->_size;
-				this->_alloc.deallocate(to_del, 1);							// Se elimina finalmente el nodo a borrar
+
+		/////////////////////////     Statistics      ///////////////////////////
+
+			// Contadores del árbol (comparaciones, nodos visitados por búsqueda, altura, nodos creados...).
+			// Solo se llevan si se compila con -DFT_TREE_STATS; si no, stats() devuelve todo a cero (ver
+			// Map/tree_stats.hpp).
+
+			ft::tree_stats stats(void) const
+			{
+				return (this->_tree.stats());
+			}
+
+			void reset_stats(void)
+			{
+				this->_tree.reset_stats();
 			}
 
 	};
@@ -685,46 +526,46 @@ namespace ft
 
 	////////////////////////////     Non member overloads      ///////////////////////////////
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator== (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	bool operator== (const map<Key, T, Compare, Alloc, N, P>& lhs, const map<Key, T, Compare, Alloc, N, P>& rhs)
 	{
 		if (lhs.size() != rhs.size())
 			return (false);
 		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator!= (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	bool operator!= (const map<Key, T, Compare, Alloc, N, P>& lhs, const map<Key, T, Compare, Alloc, N, P>& rhs)
 	{
 		return !(lhs == rhs);
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator< (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	bool operator< (const map<Key, T, Compare, Alloc, N, P>& lhs, const map<Key, T, Compare, Alloc, N, P>& rhs)
 	{
 		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator<= (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	bool operator<= (const map<Key, T, Compare, Alloc, N, P>& lhs, const map<Key, T, Compare, Alloc, N, P>& rhs)
 	{
 		return !(rhs < lhs);
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator> (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	bool operator> (const map<Key, T, Compare, Alloc, N, P>& lhs, const map<Key, T, Compare, Alloc, N, P>& rhs)
 	{
 		return (rhs < lhs);
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator>= (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs)
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	bool operator>= (const map<Key, T, Compare, Alloc, N, P>& lhs, const map<Key, T, Compare, Alloc, N, P>& rhs)
 	{
 		return !(lhs < rhs);
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	void swap(map<Key, T, Compare, Alloc>& x, map<Key, T, Compare, Alloc>& y)
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	void swap(map<Key, T, Compare, Alloc, N, P>& x, map<Key, T, Compare, Alloc, N, P>& y)
 	{
 		x.swap(y);
 	}
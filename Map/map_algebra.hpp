@@ -0,0 +1,78 @@
+#ifndef MAP_ALGEBRA_HPP
+# define MAP_ALGEBRA_HPP
+
+# include "map.hpp"
+
+// Unión, intersección y diferencia de las claves de dos mapas. Si una clave está en los dos, el resultado
+// se queda con el elemento del primero (como a.insert(b.begin(), b.end())).
+// Las que devuelven un mapa nuevo lo construyen ya equilibrado y en un solo bloque de nodos, a partir
+// de una mezcla lineal (unión) o buscando las claves de uno en el otro en orden, cada búsqueda partiendo
+// de donde terminó la anterior (intersección y diferencia). Las _inplace modifican el primer mapa y
+// recorren el segundo de la misma forma, así que son las que interesan cuando el segundo es pequeño y el
+// primero grande: O(m log(n/m + 1)) en lugar de los O(m log n) de insertar o borrar las claves una a una
+// (con el primero equilibrado). Las claves que caen en el mismo hueco del primero que la anterior no se
+// buscan, y map_union_inplace() las engancha en ese hueco como un subárbol equilibrado, así que un segundo
+// mapa que cae entero entre dos claves del primero cuesta O(m). Ver tree::merge_unique() y los que le siguen.
+
+namespace ft
+{
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	map<Key, T, Compare, Alloc, N, P> map_union(const map<Key, T, Compare, Alloc, N, P>& a, const map<Key, T, Compare, Alloc, N, P>& b)
+	{
+		map<Key, T, Compare, Alloc, N, P>	ret(a.key_comp());
+
+		ret.get_tree().assign_union(a.get_tree(), b.get_tree());
+		return (ret);
+	}
+
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	map<Key, T, Compare, Alloc, N, P> map_intersection(const map<Key, T, Compare, Alloc, N, P>& a, const map<Key, T, Compare, Alloc, N, P>& b)
+	{
+		map<Key, T, Compare, Alloc, N, P>	ret(a.key_comp());
+
+		ret.get_tree().assign_intersection(a.get_tree(), b.get_tree());
+		return (ret);
+	}
+
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	map<Key, T, Compare, Alloc, N, P> map_difference(const map<Key, T, Compare, Alloc, N, P>& a, const map<Key, T, Compare, Alloc, N, P>& b)
+	{
+		map<Key, T, Compare, Alloc, N, P>	ret(a.key_comp());
+
+		ret.get_tree().assign_difference(a.get_tree(), b.get_tree());
+		return (ret);
+	}
+
+	// a pasa a ser a ∪ b: se insertan los elementos de b cuya clave no esté ya en a.
+
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	void map_union_inplace(map<Key, T, Compare, Alloc, N, P>& a, const map<Key, T, Compare, Alloc, N, P>& b)
+	{
+		a.get_tree().merge_unique(b.get_tree());
+	}
+
+	// a pasa a ser a ∩ b. Se construye el resultado aparte (solo se busca en a cada clave de b, o al revés
+	// si a es el pequeño) y se intercambia con a.
+
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	void map_intersection_inplace(map<Key, T, Compare, Alloc, N, P>& a, const map<Key, T, Compare, Alloc, N, P>& b)
+	{
+		if (&a == &b)
+			return ;
+
+		map<Key, T, Compare, Alloc, N, P>	ret(a.key_comp());
+
+		ret.get_tree().assign_intersection(a.get_tree(), b.get_tree());
+		a.swap(ret);
+	}
+
+	// a pasa a ser a - b: se borran de a las claves de b.
+
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	void map_difference_inplace(map<Key, T, Compare, Alloc, N, P>& a, const map<Key, T, Compare, Alloc, N, P>& b)
+	{
+		a.get_tree().subtract(b.get_tree());
+	}
+}
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef MAP_PARALLEL_HPP
+# define MAP_PARALLEL_HPP
+
+# include <pthread.h>
+# include <unistd.h>
+# include "map.hpp"
+# include "../Vector/vector.hpp"
+
+// Recorridos de un mapa repartidos entre varios hilos, para agregaciones sobre mapas grandes.
+// El árbol se corta en trozos disjuntos: se baja unos pocos niveles desde la raíz y cada subárbol que
+// queda por debajo es un trozo, y cada nodo de los niveles de arriba es un trozo de un solo elemento.
+// Los trozos salen ya en orden, y los hilos los van cogiendo de uno en uno hasta que no queda ninguno
+// (así, si un subárbol es mucho más grande que otros, los demás hilos siguen con el resto). Los hilos se
+// crean en cada llamada y se esperan antes de volver. Si el árbol está muy desequilibrado (por ejemplo si
+// se insertó en orden) casi todo cae en un mismo trozo y no se gana nada.
+// threads = 0 usa tantos hilos como procesadores haya.
+
+namespace ft
+{
+	template <class Node>
+	struct tree_chunk
+	{
+		Node*	node;
+		bool	whole;						// Todo el subárbol de node, o solo node
+	};
+
+	// Guarda en out los trozos en orden, bajando como mucho depth niveles.
+
+	template <class Node>
+	void split_tree(Node* root, size_t depth, ft::vector<tree_chunk<Node> >& out)
+	{
+		tree_chunk<Node>	c;
+
+		if (root == NULL)
+			return ;
+		c.node = root;
+		c.whole = (depth == 0 || (root->left == NULL && root->right == NULL));
+		if (c.whole)
+		{
+			out.push_back(c);
+			return ;
+		}
+		split_tree(root->left, depth - 1, out);
+		out.push_back(c);
+		split_tree(root->right, depth - 1, out);
+	}
+
+	// Llama a f con cada elemento del trozo, en orden. Recorre el subárbol subiendo por los padres (como
+	// tree_iterator::operator++) pero se para al volver a la raíz del trozo. El nodo final no guarda ningún
+	// elemento, así que se salta.
+
+	template <class Node, class Function>
+	void visit_chunk(const tree_chunk<Node>& c, Node* endnode, Function& f)
+	{
+		Node*	curr;
+
+		if (!c.whole)
+		{
+			if (c.node != endnode)
+				f(c.node->data);
+			return ;
+		}
+		curr = leftmost(c.node);
+		while (true)
+		{
+			if (curr != endnode)
+				f(curr->data);
+			if (curr->right)
+				curr = leftmost(curr->right);
+			else
+			{
+				while (curr != c.node && curr == curr->parent->right)
+					curr = curr->parent;
+				if (curr == c.node)
+					break ;
+				curr = curr->parent;
+			}
+		}
+	}
+
+	// Reparte los trozos entre threads hilos (el que llama es uno de ellos). Cada hilo coge el siguiente
+	// trozo libre con un incremento atómico y llama a job.run(i, trozo).
+
+	template <class Node, class Job>
+	class chunk_runner
+	{
+		private:
+			const ft::vector<tree_chunk<Node> >&	_chunks;
+			Node*									_endnode;
+			Job&									_job;
+			size_t									_next;
+
+			static void* _work(void* arg)
+			{
+				chunk_runner*	self = static_cast<chunk_runner*>(arg);
+				size_t			i;
+
+				while ((i = __sync_fetch_and_add(&self->_next, 1)) < self->_chunks.size())
+					self->_job.run(i, self->_chunks[i], self->_endnode);
+				return (NULL);
+			}
+
+		public:
+			chunk_runner(const ft::vector<tree_chunk<Node> >& chunks, Node* endnode, Job& job) :
+				_chunks(chunks),
+				_endnode(endnode),
+				_job(job),
+				_next(0)
+			{}
+
+			void run(size_t threads)
+			{
+				ft::vector<pthread_t>	th(threads > 1 ? threads - 1 : 0);
+				size_t					started = 0;
+
+				while (started < th.size() && pthread_create(&th[started], NULL, &chunk_runner::_work, this) == 0)
+					++started;										// Si no se puede crear alguno, los que hay hacen su parte
+				_work(this);
+				for (size_t i = 0; i < started; i++)
+					pthread_join(th[i], NULL);
+			}
+	};
+
+	// Número de hilos a usar y niveles a bajar para que salgan unos 8 trozos por hilo.
+
+	inline size_t parallel_threads(size_t threads)
+	{
+		long	cpus;
+
+		if (threads)
+			return (threads);
+		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		return (cpus > 0 ? static_cast<size_t>(cpus) : 1);
+	}
+
+	inline size_t parallel_depth(size_t threads)
+	{
+		size_t	depth = 0;
+
+		if (threads <= 1)
+			return (0);
+		while ((static_cast<size_t>(1) << depth) < threads * 8)
+			++depth;
+		return (depth);
+	}
+
+	template <class Node, class Function>
+	struct for_each_job
+	{
+		Function&	f;
+
+		void run(size_t, const tree_chunk<Node>& c, Node* endnode)
+		{
+			visit_chunk(c, endnode, this->f);
+		}
+	};
+
+	template <class T, class Op>
+	struct fold_into
+	{
+		T&		acc;
+		Op&		op;
+
+		template <class V>
+		void operator() (const V& v)
+		{
+			this->acc = this->op(this->acc, v);
+		}
+	};
+
+	template <class Node, class T, class Op>
+	struct reduce_job
+	{
+		ft::vector<T>&	partial;
+		Op&				op;
+
+		void run(size_t i, const tree_chunk<Node>& c, Node* endnode)
+		{
+			T					acc = this->partial[i];				// En local, para no escribir en la misma línea de caché que otros hilos
+			fold_into<T, Op>	fold = {acc, this->op};
+
+			visit_chunk(c, endnode, fold);
+			this->partial[i] = acc;
+		}
+	};
+
+
+	///////////////////////////     parallel_for_each      ////////////////////////////
+
+	// Llama a f(elemento) con cada elemento del mapa. f puede modificar el valor asociado (no la clave),
+	// pero se llama desde varios hilos a la vez sobre el mismo objeto f, así que no puede guardar estado
+	// sin protegerlo, y no se llama en orden.
+
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P, class Function>
+	void parallel_for_each(ft::map<Key, T, Compare, Alloc, N, P>& m, Function f, size_t threads = 0)
+	{
+		typedef typename ft::map<Key, T, Compare, Alloc, N, P>::node_type	node_type;
+
+		ft::vector<tree_chunk<node_type> >	chunks;
+		for_each_job<node_type, Function>	job = {f};
+
+		threads = parallel_threads(threads);
+		split_tree(m.get_root(), parallel_depth(threads), chunks);
+		chunk_runner<node_type, for_each_job<node_type, Function> >(chunks, m.end().base(), job).run(threads);
+	}
+
+
+	///////////////////////////     parallel_reduce      ////////////////////////////
+
+	// Devuelve init op e1 op e2 op ... op en, con los elementos en orden. Cada trozo se acumula por su lado
+	// empezando desde init, y luego se juntan los resultados de los trozos en orden, así que init tiene que
+	// ser el elemento neutro de la operación (0 para una suma, 1 para un producto...) y la operación tiene
+	// que ser asociativa, pero no hace falta que sea conmutativa.
+	// op se usa de dos formas: op(Result, value_type) para acumular un elemento y op(Result, Result) para
+	// juntar dos resultados parciales, así que tiene que ser un functor con los dos operator().
+
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P, class Result, class Op>
+	Result parallel_reduce(const ft::map<Key, T, Compare, Alloc, N, P>& m, Result init, Op op, size_t threads = 0)
+	{
+		typedef typename ft::map<Key, T, Compare, Alloc, N, P>::node_type	node_type;
+
+		ft::vector<tree_chunk<node_type> >		chunks;
+
+		threads = parallel_threads(threads);
+		split_tree(m.get_root(), parallel_depth(threads), chunks);
+
+		ft::vector<Result>						partial(chunks.size(), init);
+		reduce_job<node_type, Result, Op>		job = {partial, op};
+
+		chunk_runner<node_type, reduce_job<node_type, Result, Op> >(chunks, m.end().base(), job).run(threads);
+		for (size_t i = 0; i < partial.size(); i++)
+			init = op(init, partial[i]);
+		return (init);
+	}
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef MAP_SNAPSHOT_HPP
+# define MAP_SNAPSHOT_HPP
+
+# include <cstdio>
+# include <cstring>
+# include <stdexcept>
+# include <functional>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include "map.hpp"
+# include "pair.hpp"
+# include "../common/is_trivially_copyable.hpp"
+
+// Guardado y carga de un mapa en un fichero binario. El fichero es una cabecera de 32 bytes seguida de
+// los elementos del mapa en orden, cada uno como un ft::pair<Key, T> tal y como está en memoria. Por eso
+// solo sirve para claves y valores trivialmente copiables (enteros, structs de enteros, arrays de char...)
+// y el fichero solo se puede leer en una máquina con el mismo tamaño y alineación de los tipos. Los
+// tamaños se guardan en la cabecera y se comprueban al cargar.
+// Para cargar no hace falta leer el fichero: se proyecta en memoria con mmap() y, como los elementos ya
+// están ordenados, o bien se construye el mapa en O(n) con map::assign_sorted() (un solo bloque de nodos),
+// o bien se usa map_snapshot para hacer las búsquedas directamente sobre el array proyectado, sin crear
+// ningún nodo.
+
+namespace ft
+{
+	struct snapshot_header
+	{
+		char				magic[8];
+		unsigned long long	count;
+		unsigned int		key_size;
+		unsigned int		mapped_size;
+		unsigned int		record_size;
+		unsigned int		reserved;
+	};
+
+	static const char	snapshot_magic[8] = {'F', 'T', 'M', 'A', 'P', 'S', 'N', '1'};
+
+	// Tipo de cada elemento en el fichero. Usarlo no compila si Key o T no se pueden copiar byte a byte (un
+	// std::string, por ejemplo, escribiría en el fichero un puntero a memoria que al cargar ya no existe),
+	// así que save_map() y map_snapshot solo aceptan mapas que se pueden guardar.
+
+	template <class Key, class T>
+	struct snapshot_record
+	{
+		typedef char				key_must_be_trivially_copyable[ft::is_trivially_copyable<Key>::value ? 1 : -1];
+		typedef char				mapped_must_be_trivially_copyable[ft::is_trivially_copyable<T>::value ? 1 : -1];
+		typedef ft::pair<Key, T>	type;
+	};
+
+	// Vista de solo lectura sobre un fichero guardado con save_map(). No se puede copiar, porque es la
+	// dueña de la proyección del fichero, que se deshace en el destructor.
+
+	template <class Key, class T, class Compare = std::less<Key> >
+	class map_snapshot
+	{
+		public:
+			typedef Key											key_type;
+			typedef T											mapped_type;
+			typedef typename ft::snapshot_record<Key, T>::type	value_type;
+			typedef Compare										key_compare;
+			typedef const value_type*							const_iterator;
+			typedef size_t										size_type;
+
+		private:
+			void*				_addr;
+			size_t				_len;
+			const value_type*	_data;
+			size_type			_size;
+			key_compare			_key_cmp;
+
+			map_snapshot(const map_snapshot&);
+			map_snapshot& operator= (const map_snapshot&);
+
+		public:
+
+		/////////////////////////     Constructors      /////////////////////////////////
+
+			explicit map_snapshot(const char* path, const key_compare& comp = key_compare()) :
+				_addr(MAP_FAILED),
+				_len(0),
+				_data(NULL),
+				_size(0),
+				_key_cmp(comp)
+			{
+				int			fd = open(path, O_RDONLY);
+				struct stat	st;
+
+				if (fd < 0)
+					throw std::runtime_error("map_snapshot: cannot open file");
+				if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(snapshot_header))
+				{
+					close(fd);
+					throw std::runtime_error("map_snapshot: truncated file");
+				}
+				this->_len = st.st_size;
+				this->_addr = mmap(NULL, this->_len, PROT_READ, MAP_PRIVATE, fd, 0);
+				close(fd);													// La proyección sigue siendo válida después de cerrar
+				if (this->_addr == MAP_FAILED)
+					throw std::runtime_error("map_snapshot: mmap failed");
+
+				const snapshot_header*	h = static_cast<const snapshot_header*>(this->_addr);
+				if (memcmp(h->magic, snapshot_magic, sizeof(snapshot_magic)) != 0
+					|| h->key_size != sizeof(Key) || h->mapped_size != sizeof(T)
+					|| h->record_size != sizeof(value_type)
+					|| h->count > (this->_len - sizeof(snapshot_header)) / sizeof(value_type))	// Sin multiplicar count, que podría desbordar
+				{
+					munmap(this->_addr, this->_len);
+					throw std::runtime_error("map_snapshot: bad header");
+				}
+				this->_size = h->count;
+				this->_data = reinterpret_cast<const value_type*>(static_cast<const char*>(this->_addr)
+					+ sizeof(snapshot_header));
+# ifdef MADV_WILLNEED
+				madvise(this->_addr, this->_len, MADV_WILLNEED);			// Se va a leer entero: que el kernel lo vaya trayendo
+# endif
+			}
+
+
+		///////////////////////////     Destructor      /////////////////////////////////
+
+			~map_snapshot(void)
+			{
+				munmap(this->_addr, this->_len);
+			}
+
+
+		///////////////////////////     Iterators      /////////////////////////////////
+
+			const_iterator begin(void) const
+			{
+				return (this->_data);
+			}
+
+			const_iterator end(void) const
+			{
+				return (this->_data + this->_size);
+			}
+
+
+		///////////////////////////     Capacity      /////////////////////////////////
+
+			bool empty(void) const
+			{
+				return (this->_size == 0);
+			}
+
+			size_type size(void) const
+			{
+				return (this->_size);
+			}
+
+
+		////////////////////////////     Operations      ///////////////////////////////
+
+			// Búsqueda binaria sobre el array proyectado. Igual que en map, devuelven end() si no hay ningún
+			// elemento que cumpla la condición.
+
+			const_iterator lower_bound(const key_type& k) const
+			{
+				const_iterator	first = this->_data;
+				size_type		len = this->_size;
+
+				while (len > 0)
+				{
+					size_type	half = len / 2;
+					if (this->_key_cmp(first[half].first, k))
+					{
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return (first);
+			}
+
+			const_iterator upper_bound(const key_type& k) const
+			{
+				const_iterator	first = this->_data;
+				size_type		len = this->_size;
+
+				while (len > 0)
+				{
+					size_type	half = len / 2;
+					if (!this->_key_cmp(k, first[half].first))
+					{
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return (first);
+			}
+
+			const_iterator find(const key_type& k) const
+			{
+				const_iterator	it = this->lower_bound(k);
+
+				if (it != this->end() && !this->_key_cmp(k, it->first))
+					return (it);
+				return (this->end());
+			}
+
+			size_type count(const key_type& k) const
+			{
+				return (this->find(k) != this->end() ? 1 : 0);
+			}
+
+			key_compare key_comp(void) const
+			{
+				return (this->_key_cmp);
+			}
+	};
+
+
+	/////////////////////////////     Save / Load      //////////////////////////////
+
+	// Escribe el mapa en path. Cada elemento se copia en un pair<Key, T> puesto a cero antes, para que los
+	// bytes de relleno entre first y second no dependan de lo que hubiera en memoria y dos mapas iguales
+	// den siempre el mismo fichero.
+
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	void save_map(const ft::map<Key, T, Compare, Alloc, N, P>& src, const char* path)
+	{
+		FILE*										f = fopen(path, "wb");
+		snapshot_header								h;
+		typename ft::snapshot_record<Key, T>::type	rec;
+		bool										ok;
+
+		if (f == NULL)
+			throw std::runtime_error("save_map: cannot open file");
+		memset(&h, 0, sizeof(h));
+		memcpy(h.magic, snapshot_magic, sizeof(snapshot_magic));
+		h.count = src.size();
+		h.key_size = sizeof(Key);
+		h.mapped_size = sizeof(T);
+		h.record_size = sizeof(rec);
+		ok = (fwrite(&h, sizeof(h), 1, f) == 1);
+		for (typename ft::map<Key, T, Compare, Alloc, N, P>::const_iterator it = src.begin(); ok && it != src.end(); ++it)
+		{
+			memset(static_cast<void*>(&rec), 0, sizeof(rec));
+			rec.first = it->first;
+			rec.second = it->second;
+			ok = (fwrite(&rec, sizeof(rec), 1, f) == 1);
+		}
+		if (fclose(f) != 0 || !ok)
+			throw std::runtime_error("save_map: write failed");
+	}
+
+	// Reemplaza el contenido de dst por el del fichero. El fichero se proyecta en memoria y los nodos se
+	// construyen en un único bloque directamente desde ahí, sin buscar la posición de cada elemento.
+
+	template <class Key, class T, class Compare, class Alloc, size_t N, class P>
+	void load_map(ft::map<Key, T, Compare, Alloc, N, P>& dst, const char* path)
+	{
+		ft::map_snapshot<Key, T, Compare>	snap(path, dst.key_comp());
+
+		dst.assign_sorted(snap.begin(), snap.size());
+	}
+}
+
+#endif
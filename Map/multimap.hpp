@@ -0,0 +1,435 @@
+#ifndef MULTIMAP_HPP
+#define MULTIMAP_HPP
+
+# include <memory>
+# include "../common/reverse_iterator.hpp"
+# include "../common/enable_if.hpp"
+# include "../common/is_integral.hpp"
+# include "../common/lexicographical_compare.hpp"
+# include "../common/equal.hpp"
+# include "pair.hpp"
+# include "tree_iterator.hpp"
+# include "tree.hpp"
+
+// https://www.cplusplus.com/reference/map/multimap/
+// Igual que map (ver map.hpp) pero admite claves repetidas. Los elementos con la misma clave quedan
+// seguidos y en el orden en que se insertaron, porque el árbol los inserta siempre detrás de los que ya
+// había. Por eso no tiene operator[]: no sabría a cuál de los elementos con esa clave referirse.
+
+namespace ft
+{
+
+	template <class Key, class T, class Compare = std::less<Key>,
+		class Alloc = std::allocator<ft::node<ft::pair<const Key,T> > > >
+	class multimap
+	{
+		public:
+			typedef Key															key_type;
+			typedef T															mapped_type;
+			typedef ft::pair<const key_type, mapped_type>						value_type;
+			typedef Compare														key_compare;
+			typedef Alloc														allocator_type;
+			typedef typename allocator_type::template rebind<value_type>::other	node_allocator_type;
+			typedef typename allocator_type::reference							reference;
+			typedef typename allocator_type::const_reference					const_reference;
+			typedef typename allocator_type::pointer							pointer;
+			typedef typename allocator_type::const_pointer						const_pointer;
+			typedef ft::node<value_type, ft::key_prefix<Key, Compare>::enabled>	node_type;
+			typedef node_type*													node_ptr;
+			typedef ft::tree_iterator<value_type, node_type>					iterator;
+			typedef ft::tree_iterator<const value_type, node_type>				const_iterator;
+			typedef ft::reverse_iterator<iterator>								reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
+			typedef std::ptrdiff_t												difference_type;
+			typedef size_t														size_type;
+			class	value_compare : public std::binary_function<value_type, value_type, bool>
+			{																					// https://www.cplusplus.com/reference/map/multimap/value_comp/
+				public:
+					typedef bool result_type;
+					typedef value_type first_argument_type;
+					typedef value_type second_argument_type;
+
+				protected:													
+					Compare	comp;
+
+				public:
+					value_compare(Compare c) :
+						comp(c)
+					{}
+
+					bool operator() (const value_type& x, const value_type& y) const
+					{
+						return comp(x.first, y.first);
+					}
+			};
+
+		private:
+			typedef ft::tree<key_type, value_type, ft::select_first<value_type>, key_compare, allocator_type>	tree_type;
+
+			tree_type		_tree;
+
+		public:
+
+		/////////////////////////     Constructors      /////////////////////////////////
+
+			// Este es el constructor por defecto. No recibe parámetros.
+			// Construye un objeto del tipo key_compare, que us usado por el contenedor para comparar las claves. Por
+			// defecto es un objeto de tipo "less". Para usarlo se le pasan dos claves y devuelve "true" si la primera
+			// debe ir antes que la segunda y "false" en el resto de casos.
+			// También construye por defecto otro objeto de tipo allocator_type (para gestionar la memoria). Los dos
+			// se le pasan al árbol (ver tree.hpp), que es quien guarda los elementos. No se reserva
+			// nada hasta la primera inserción.
+
+			explicit multimap(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+				_tree(comp, alloc)
+			{}
+
+			// Constuye un multimap con los elementos en el rango determinado por los iteradores "first" y "last".
+			// Es como el constructor anterior solo que hace una inserción de elmentos.
+
+			template <class InputIterator>
+			multimap(typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type first, InputIterator last,
+				const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+				_tree(comp, alloc)
+			{
+				this->insert(first, last);
+			}
+
+			// Constructor copia
+
+			multimap(const multimap& src) :
+				_tree(src._tree)
+			{}
+
+
+		///////////////////////////     Destructor      /////////////////////////////////
+
+			~multimap(void)
+			{}
+
+
+		///////////////////////////     Operator=      /////////////////////////////////
+
+			multimap& operator= (multimap const &rhs)
+			{
+				if (this != &rhs)
+					this->_tree = rhs._tree;
+				return (*this);
+			}
+
+
+		///////////////////////////     Iterators      /////////////////////////////////
+
+			// Devuelve un iterador a la posición más a la izquierda del árbol, que es la del elemento con
+			// la clave más pequeña.
+
+			iterator begin(void)
+			{
+				return (this->_tree.begin());
+			}
+
+			const_iterator begin(void) const
+			{
+				return (this->_tree.begin());
+			}
+
+			// Igual que begin() pero en este caso devuelve la posición final, la más a la derecha.
+
+			iterator end(void)
+			{
+				return (this->_tree.end());
+			}
+
+			const_iterator end(void) const
+			{
+				return (this->_tree.end());
+			}
+
+			reverse_iterator rbegin(void)
+			{
+				return (reverse_iterator(this->end()));
+			}
+
+			const_reverse_iterator rbegin(void) const
+			{
+				return (const_reverse_iterator(this->end()));
+			}
+
+			reverse_iterator rend(void)
+			{
+				return (reverse_iterator(this->begin()));
+			}
+
+			const_reverse_iterator rend(void) const
+			{
+				return (const_reverse_iterator(this->begin()));
+			}
+
+
+		///////////////////////////     Capacity      /////////////////////////////////
+
+			bool empty(void) const
+			{
+				return (this->_tree.empty());
+			}
+
+			size_type size(void) const
+			{
+				return (this->_tree.size());
+			}
+
+			size_type max_size(void) const
+			{
+				return (this->_tree.max_size());
+			}
+
+
+		////////////////////////////     Modifiers      ///////////////////////////////
+
+			// https://www.cplusplus.com/reference/map/multimap/insert/
+			// Siempre se inserta, aunque ya haya elementos con la misma clave, así que solo devuelve un
+			// iterador al nuevo elemento.
+
+			iterator insert(const value_type& val)
+			{
+				return (this->_tree.insert_equal(val));
+			}
+
+			// Igual que en map, la posición es solo una sugerencia y no se usa.
+
+			iterator insert(iterator position, const value_type& val)
+			{
+				static_cast<void>(position);
+				return this->insert(val);
+			}
+
+			// Se va llamando en bucle a la primera de las funciones insert hasta que se termine de recorrer
+			// el intervalo indicado
+
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				while (first != last)
+					this->insert(*first++);
+			}
+
+			// https://www.cplusplus.com/reference/map/multimap/erase/
+			// Reduce el tamaño del mapa por el número de elementos eliminados, que son destruidos.
+			// Borrar por clave elimina todos los elementos que tengan esa clave.
+
+			void erase(iterator position)
+			{
+				this->_tree.erase(position);
+			}
+
+			size_type erase(const key_type& k)
+			{
+				return (this->_tree.erase_equal(k));		// Devuelve el número de elementos eliminados
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				this->_tree.erase(first, last);
+			}
+
+			// https://www.cplusplus.com/reference/map/multimap/swap/
+			// Cambia el contenido del mapa por el del parámetro pasado, que debe ser otro mapa del mismo
+			// tipo, aunque los tamaños pueden no ser iguales. Los iteradores y punteros existentes deben
+			// permanecer válidos (excepto los que apuntan al final del mapa).
+			// Lo que se hace es intercambiar las raíces de los dos árboles (y sus comparadores y
+			// allocators), sin mover ningún nodo.
+
+			void swap(multimap& x)
+			{
+				this->_tree.swap(x._tree);
+			}
+
+			void clear(void)
+			{
+				this->_tree.clear();
+			}
+
+
+		////////////////////////////     Observers      ///////////////////////////////
+
+			// Devuelve una copia del objeto key_compare usado por el mapa para comparar las claves. Este
+			// objeto se genera durante la construcción del mapa y es el tercer parámetro de la plantilla.
+
+			key_compare key_comp(void) const
+			{
+				return (this->_tree.key_comp());
+			}
+
+			value_compare value_comp(void) const
+			{
+				return (value_compare(this->key_comp()));			// Se construye al pedirlo en lugar de guardar otra copia del comparador
+			}
+
+
+		////////////////////////////     Operations      ///////////////////////////////
+
+			// Busca en el mapa un elemento con la clave pasada como parámetro y devuelve un iterador al mismo
+			// si lo encuentra. Si no, devuelve un iterador a end(). Si hay varios con esa clave puede devolver
+			// cualquiera de ellos. Para recorrerlos todos hay que usar equal_range().
+
+			iterator find(const key_type& k)
+			{
+				return (this->_tree.find(k));
+			}
+
+			const_iterator find(const key_type& k) const
+			{
+				return (this->_tree.find(k));
+			}
+
+			size_type count(const key_type& k) const
+			{
+				return (this->_tree.count(k));
+			}
+
+			// Devuelve un iterador apuntando al primer elemento en el contenedor cuya clave no es más pequeña
+			// (es decir, es igual o más grande) de la que se pasa como parámetro.
+
+			iterator lower_bound(const key_type& k)
+			{
+				return (this->_tree.lower_bound(k));
+			}
+
+			const_iterator lower_bound(const key_type& k) const
+			{
+				return (this->_tree.lower_bound(k));
+			}
+
+			// Devuelve un iterador apuntando al primer elemento en el contenedor cuya clave va detrás
+			// de la que se pasa como parámetro. Es decir, en un mapa ordenado de menor a mayor, devolvería
+			// un iterador al primer elemento cuya clave es mayor que la pasada.
+
+			iterator upper_bound(const key_type& k)
+			{
+				return (this->_tree.upper_bound(k));
+			}
+
+			const_iterator upper_bound(const key_type& k) const
+			{
+				return (this->_tree.upper_bound(k));
+			}
+
+			// Devuelve el rango de elementos que contienen la clave pasada como parámetro.
+			// La función devuelve un objeto de tipo pair, cuyo primer elemento es el equivalente a lo que
+			// devuelve lower_bound (un iterador al 1er elemento que no es menor que el pasado), y como
+			// segundo elemento sería el equivalente a upper_bound (un iterador al 1er elemento mayor que
+			// el que se ha pasado como parámetro). Si no hay un elemento que coincida los dos miembros
+			// del pair serán iguales.
+
+			ft::pair<iterator,iterator> equal_range(const key_type& k)
+			{
+				return (this->_tree.equal_range(k));
+			}
+
+			ft::pair<const_iterator,const_iterator>	equal_range(const key_type& k) const
+			{
+				return (this->_tree.equal_range(k));
+			}
+
+
+		////////////////////////////     Allocator      ///////////////////////////////
+
+			allocator_type get_allocator(void) const
+			{
+				return (allocator_type(this->_tree.get_allocator()));
+			}
+
+
+		//////////////////////////     Extra function      /////////////////////////////
+
+			// Reemplaza el contenido del mapa por los n elementos a los que apunta first, que ya deben estar
+			// ordenados según key_comp() (las claves repetidas quedan seguidas). Se construyen en O(n) en
+			// un único bloque de nodos (ver tree::assign_sorted()).
+
+			template <class InputIterator>
+			void assign_sorted(InputIterator first, size_type n)
+			{
+				this->_tree.assign_sorted(first, n);
+			}
+
+			// Como map::build_parallel(), pero se quedan todos los elementos. Los de claves repetidas
+			// quedan en el orden en que venían.
+
+			template <class ForwardIterator>
+			void build_parallel(ForwardIterator first, ForwardIterator last, size_type threads)
+			{
+				this->_tree.build_parallel(first, last, threads, false);
+			}
+
+			// Como map::compact(): todos los nodos seguidos y en orden en un único bloque.
+
+			void compact(void)
+			{
+				this->_tree.compact();
+			}
+
+
+		/////////////////////////     Statistics      ///////////////////////////
+
+			// Igual que en map: solo cuentan algo si se compila con -DFT_TREE_STATS.
+
+			ft::tree_stats stats(void) const
+			{
+				return (this->_tree.stats());
+			}
+
+			void reset_stats(void)
+			{
+				this->_tree.reset_stats();
+			}
+	};
+
+
+	////////////////////////////     Non member overloads      ///////////////////////////////
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator== (const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator!= (const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator< (const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
+	{
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator<= (const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator> (const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool operator>= (const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	void swap(multimap<Key, T, Compare, Alloc>& x, multimap<Key, T, Compare, Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef PAIR_HPP
 #define PAIR_HPP
 
+# include "../common/is_trivially_relocatable.hpp"
+
 namespace ft
 {
 	template <class T1, class T2>
@@ -93,6 +95,14 @@ namespace ft
 		return (!(lhs < rhs));
 	}
 
+	// pair tiene operator= propio, así que el compilador no lo da por copiable byte a byte, pero solo
+	// contiene sus dos miembros: se puede mover por bytes si ellos se pueden.
+
+	template <class T1, class T2>
+	struct is_trivially_relocatable<ft::pair<T1, T2> >
+	{
+		static const bool value = ft::is_trivially_relocatable<T1>::value && ft::is_trivially_relocatable<T2>::value;
+	};
 }
 
 #endif
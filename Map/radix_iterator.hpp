@@ -0,0 +1,270 @@
+#ifndef RADIX_ITERATOR_HPP
+# define RADIX_ITERATOR_HPP
+
+# include <string>
+# include "../common/iterator_traits.hpp"
+
+// Piezas de radix_map (ver radix_map.hpp): cómo se convierte cada tipo de clave en bytes, los nodos del
+// árbol y el iterador.
+
+namespace ft
+{
+	/////////////////////////////     Claves      /////////////////////////////////
+
+	// radix_key<Key> da los bytes de una clave en el orden en que se comparan: size() es cuántos hay y
+	// at(k, i) el byte i. Ordenar las claves por esos bytes (como cadenas, sin signo, y una clave que es
+	// el principio de otra va antes) tiene que dar el mismo orden que std::less<Key>.
+	// Los enteros se dan del byte más alto al más bajo, y a los que tienen signo se les cambia el bit de
+	// signo para que los negativos queden delante de los positivos. std::string se da tal cual.
+	// No hay versión por defecto: radix_map solo compila con los tipos que tengan una especialización.
+
+	template <class Key>
+	struct radix_key;
+
+	template <class Key>
+	struct radix_unsigned_key
+	{
+		static size_t size(const Key&)
+		{
+			return (sizeof(Key));
+		}
+
+		static unsigned char at(const Key& k, size_t i)
+		{
+			return (static_cast<unsigned char>(static_cast<unsigned long long>(k) >> (8 * (sizeof(Key) - 1 - i))));
+		}
+	};
+
+	template <class Key>
+	struct radix_signed_key
+	{
+		static size_t size(const Key&)
+		{
+			return (sizeof(Key));
+		}
+
+		static unsigned char at(const Key& k, size_t i)
+		{
+			unsigned long long	bits = static_cast<unsigned long long>(k) ^ (1ULL << (8 * sizeof(Key) - 1));
+
+			return (static_cast<unsigned char>(bits >> (8 * (sizeof(Key) - 1 - i))));
+		}
+	};
+
+	template <> struct radix_key<unsigned char> : radix_unsigned_key<unsigned char> {};
+	template <> struct radix_key<unsigned short> : radix_unsigned_key<unsigned short> {};
+	template <> struct radix_key<unsigned int> : radix_unsigned_key<unsigned int> {};
+	template <> struct radix_key<unsigned long> : radix_unsigned_key<unsigned long> {};
+	template <> struct radix_key<unsigned long long> : radix_unsigned_key<unsigned long long> {};
+	template <> struct radix_key<signed char> : radix_signed_key<signed char> {};
+	template <> struct radix_key<short> : radix_signed_key<short> {};
+	template <> struct radix_key<int> : radix_signed_key<int> {};
+	template <> struct radix_key<long> : radix_signed_key<long> {};
+	template <> struct radix_key<long long> : radix_signed_key<long long> {};
+
+	template <>
+	struct radix_key<std::string>
+	{
+		static size_t size(const std::string& k)
+		{
+			return (k.size());
+		}
+
+		static unsigned char at(const std::string& k, size_t i)
+		{
+			return (static_cast<unsigned char>(k[i]));
+		}
+	};
+
+
+	/////////////////////////////     Nodos      /////////////////////////////////
+
+	// Los elementos están en las hojas, y las hojas forman además una lista doblemente enlazada en orden,
+	// que es lo que recorre el iterador. La lista es circular y empieza y termina en un radix_link sin
+	// elemento que está dentro del propio radix_map y hace de end().
+
+	struct radix_link
+	{
+		radix_link*	prev;
+		radix_link*	next;
+	};
+
+	template <class Value>
+	struct radix_leaf : public radix_link
+	{
+		Value	data;
+
+		radix_leaf(const Value& src) :
+			data(src)
+		{
+			this->prev = NULL;
+			this->next = NULL;
+		}
+	};
+
+	// Nodos interiores. Los cuatro tipos empiezan por la misma cabecera y se diferencian en cómo buscan
+	// el hijo de cada byte:
+	//  - radix_node4 y radix_node16: hasta 4 o 16 hijos, con sus bytes ordenados en keys[].
+	//  - radix_node48: index[b] es la posición del hijo del byte b en children[] más uno (0 si no hay).
+	//  - radix_node256: children[b] directamente.
+	// Cada nodo se salta los prefix_len bytes que tienen en común todas las claves que cuelgan de él
+	// (compresión de caminos). Solo se guardan los radix_max_prefix primeros en prefix[]: si hay más, los
+	// que faltan se leen de la clave de cualquier hoja de debajo.
+	// Un hijo puede ser otro nodo interior o directamente una hoja (si no hay ninguna otra clave que
+	// empiece igual); las hojas se distinguen porque su puntero lleva el bit más bajo a 1.
+	// terminal es la hoja cuya clave termina justo en este nodo (solo pasa con claves de longitud
+	// variable, cuando una es el principio de otra), que va antes que todas las de sus hijos.
+
+	static const unsigned int	radix_max_prefix = 8;
+
+	enum radix_type
+	{
+		radix_type4,
+		radix_type16,
+		radix_type48,
+		radix_type256
+	};
+
+	struct radix_node
+	{
+		unsigned char	type;
+		unsigned char	prefix[radix_max_prefix];
+		unsigned short	count;						// Número de hijos (sin contar terminal)
+		unsigned int	prefix_len;
+		radix_node*		terminal;					// Hoja (con el bit de hoja) o NULL
+	};
+
+	struct radix_node4 : public radix_node
+	{
+		unsigned char	keys[4];
+		radix_node*		children[4];
+	};
+
+	struct radix_node16 : public radix_node
+	{
+		unsigned char	keys[16];
+		radix_node*		children[16];
+	};
+
+	struct radix_node48 : public radix_node
+	{
+		unsigned char	index[256];
+		radix_node*		children[48];
+	};
+
+	struct radix_node256 : public radix_node
+	{
+		radix_node*		children[256];
+	};
+
+
+	/////////////////////////////     Iterador      /////////////////////////////////
+
+	// Recorre la lista de hojas, así que avanzar y retroceder cuesta O(1). Igual que tree_iterator, hereda
+	// de iterator_traits con la clase base iterator para decir que es bidireccional.
+
+	template <typename T, typename leaf_type>
+	class radix_iterator : ft::iterator_traits<ft::iterator<std::bidirectional_iterator_tag, T> >
+	{
+		public:
+			typedef typename  ft::iterator_traits<ft::iterator<std::bidirectional_iterator_tag, T> >::iterator_category	iterator_category;
+			typedef typename  ft::iterator_traits<ft::iterator<std::bidirectional_iterator_tag, T> >::value_type		value_type;
+			typedef typename  ft::iterator_traits<ft::iterator<std::bidirectional_iterator_tag, T> >::difference_type	difference_type;
+			typedef typename  ft::iterator_traits<ft::iterator<std::bidirectional_iterator_tag, T> >::reference			reference;
+			typedef typename  ft::iterator_traits<ft::iterator<std::bidirectional_iterator_tag, T> >::pointer			pointer;
+
+		private:
+			radix_link*	_link;
+
+		public:
+
+		///////////////////////////     Constructors      //////////////////////////////
+
+			radix_iterator(radix_link* src = NULL) :
+				_link(src)
+			{}
+
+			radix_iterator(const radix_iterator& src) :
+				_link(src._link)
+			{}
+
+			// Permite construir un const_iterator a partir de un iterator
+
+			template <class U>
+			radix_iterator(const radix_iterator<U, leaf_type>& src) :
+				_link(src.base())
+			{}
+
+
+		///////////////////////////     Destructor     ////////////////////////////////
+
+			~radix_iterator(void)
+			{}
+
+
+		///////////////////////     Operator overloads      ////////////////////////////
+
+			radix_iterator& operator= (const radix_iterator& rhs)
+			{
+				this->_link = rhs._link;
+				return (*this);
+			}
+
+			radix_link* base() const
+			{
+				return (this->_link);
+			}
+
+			reference operator* (void) const
+			{
+				return (static_cast<leaf_type*>(this->_link)->data);
+			}
+
+			pointer operator-> (void) const
+			{
+				return (&static_cast<leaf_type*>(this->_link)->data);
+			}
+
+			radix_iterator& operator++ (void)
+			{
+				this->_link = this->_link->next;
+				return (*this);
+			}
+
+			radix_iterator operator++ (int)
+			{
+				radix_iterator	tmp(*this);
+
+				this->_link = this->_link->next;
+				return (tmp);
+			}
+
+			radix_iterator& operator-- (void)
+			{
+				this->_link = this->_link->prev;
+				return (*this);
+			}
+
+			radix_iterator operator-- (int)
+			{
+				radix_iterator	tmp(*this);
+
+				this->_link = this->_link->prev;
+				return (tmp);
+			}
+
+			template <class U>
+			bool operator== (const radix_iterator<U, leaf_type>& rhs) const
+			{
+				return (this->_link == rhs.base());
+			}
+
+			template <class U>
+			bool operator!= (const radix_iterator<U, leaf_type>& rhs) const
+			{
+				return (this->_link != rhs.base());
+			}
+	};
+}
+
+#endif
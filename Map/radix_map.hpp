@@ -0,0 +1,1185 @@
+#ifndef RADIX_MAP_HPP
+# define RADIX_MAP_HPP
+
+# include <memory>
+# include <cstring>
+# include <functional>
+# include "../common/reverse_iterator.hpp"
+# include "../common/enable_if.hpp"
+# include "../common/is_integral.hpp"
+# include "../common/lexicographical_compare.hpp"
+# include "../common/equal.hpp"
+# include "pair.hpp"
+# include "radix_iterator.hpp"
+# ifdef __SSE2__
+#  include <emmintrin.h>
+# endif
+
+// https://db.in.tum.de/~leis/papers/ART.pdf (Leis, Kemper y Neumann, "The Adaptive Radix Tree")
+// Mapa ordenado para claves enteras y std::string con la misma interfaz que ft::map, pero guardado en un
+// árbol radix adaptativo en lugar de en un árbol binario de búsqueda. Cada nivel del árbol consume un
+// byte de la clave (ver radix_key en radix_iterator.hpp) y elige el hijo de ese byte, sin comparar la
+// clave con ninguna otra hasta llegar a la hoja. Así que una búsqueda cuesta como mucho un nivel por
+// byte de la clave (8 para un uint64_t) sea cual sea el número de elementos, y no log2(n) comparaciones
+// con un salto a otro nodo después de cada una.
+// Para no gastar un array de 256 punteros en cada nodo, cada nodo interior es de uno de cuatro tamaños
+// (4, 16, 48 o 256 hijos) y se cambia al siguiente cuando se llena y al anterior cuando se queda con
+// pocos. En los de 16 el hijo se busca comparando el byte con las 16 claves a la vez con SSE2.
+// Además los caminos sin ramificaciones se comprimen: un nodo se salta los bytes que comparten todas
+// las claves de debajo, y una clave que no comparte nada más con ninguna otra se guarda directamente
+// como hoja en el primer nivel donde se separa de las demás.
+// El orden es el de std::less<Key>. Las hojas forman una lista doblemente enlazada en ese orden, así que
+// el iterador es bidireccional, avanza en O(1) y, como las hojas no se mueven nunca, no deja de ser
+// válido hasta que se borra su elemento (igual que en ft::map).
+
+namespace ft
+{
+	template <class Key, class T, class Alloc = std::allocator<ft::pair<const Key, T> > >
+	class radix_map
+	{
+		public:
+			typedef Key															key_type;
+			typedef T															mapped_type;
+			typedef ft::pair<const key_type, mapped_type>						value_type;
+			typedef std::less<key_type>											key_compare;
+			typedef Alloc														allocator_type;
+			typedef typename allocator_type::reference							reference;
+			typedef typename allocator_type::const_reference					const_reference;
+			typedef typename allocator_type::pointer							pointer;
+			typedef typename allocator_type::const_pointer						const_pointer;
+			typedef ft::radix_leaf<value_type>									leaf_type;
+			typedef ft::radix_iterator<value_type, leaf_type>					iterator;
+			typedef ft::radix_iterator<const value_type, leaf_type>				const_iterator;
+			typedef ft::reverse_iterator<iterator>								reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
+			typedef std::ptrdiff_t												difference_type;
+			typedef size_t														size_type;
+			class	value_compare : public std::binary_function<value_type, value_type, bool>
+			{
+				protected:
+					key_compare	comp;
+
+				public:
+					value_compare(key_compare c) :
+						comp(c)
+					{}
+
+					bool operator() (const value_type& x, const value_type& y) const
+					{
+						return comp(x.first, y.first);
+					}
+			};
+
+		private:
+			typedef ft::radix_key<key_type>										key_traits;
+			typedef typename Alloc::template rebind<leaf_type>::other			leaf_allocator;
+			typedef typename Alloc::template rebind<radix_node4>::other			node4_allocator;
+			typedef typename Alloc::template rebind<radix_node16>::other		node16_allocator;
+			typedef typename Alloc::template rebind<radix_node48>::other		node48_allocator;
+			typedef typename Alloc::template rebind<radix_node256>::other		node256_allocator;
+
+			radix_node*		_root;				// NULL si está vacío. Puede ser directamente una hoja
+			radix_link		_head;				// Principio y final de la lista de hojas: es end()
+			size_type		_size;
+			leaf_allocator	_alloc;
+
+		public:
+
+		/////////////////////////     Constructors      /////////////////////////////////
+
+			explicit radix_map(const allocator_type& alloc = allocator_type()) :
+				_root(NULL),
+				_size(0),
+				_alloc(alloc)
+			{
+				this->_head.prev = &this->_head;
+				this->_head.next = &this->_head;
+			}
+
+			template <class InputIterator>
+			radix_map(typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type first, InputIterator last,
+				const allocator_type& alloc = allocator_type()) :
+				_root(NULL),
+				_size(0),
+				_alloc(alloc)
+			{
+				this->_head.prev = &this->_head;
+				this->_head.next = &this->_head;
+				this->insert(first, last);
+			}
+
+			radix_map(const radix_map& src) :
+				_root(NULL),
+				_size(0),
+				_alloc(src._alloc)
+			{
+				this->_head.prev = &this->_head;
+				this->_head.next = &this->_head;
+				this->insert(src.begin(), src.end());
+			}
+
+
+		///////////////////////////     Destructor      /////////////////////////////////
+
+			~radix_map(void)
+			{
+				this->clear();
+			}
+
+
+		///////////////////////////     Operator=      /////////////////////////////////
+
+			radix_map& operator= (const radix_map& rhs)
+			{
+				if (this != &rhs)
+				{
+					this->clear();
+					this->insert(rhs.begin(), rhs.end());
+				}
+				return (*this);
+			}
+
+
+		///////////////////////////     Iterators      /////////////////////////////////
+
+			iterator begin(void)
+			{
+				return (iterator(this->_head.next));
+			}
+
+			const_iterator begin(void) const
+			{
+				return (const_iterator(const_cast<radix_link*>(this->_head.next)));
+			}
+
+			iterator end(void)
+			{
+				return (iterator(&this->_head));
+			}
+
+			const_iterator end(void) const
+			{
+				return (const_iterator(const_cast<radix_link*>(&this->_head)));
+			}
+
+			reverse_iterator rbegin(void)
+			{
+				return (reverse_iterator(this->end()));
+			}
+
+			const_reverse_iterator rbegin(void) const
+			{
+				return (const_reverse_iterator(this->end()));
+			}
+
+			reverse_iterator rend(void)
+			{
+				return (reverse_iterator(this->begin()));
+			}
+
+			const_reverse_iterator rend(void) const
+			{
+				return (const_reverse_iterator(this->begin()));
+			}
+
+
+		///////////////////////////     Capacity      /////////////////////////////////
+
+			bool empty(void) const
+			{
+				return (this->_size == 0);
+			}
+
+			size_type size(void) const
+			{
+				return (this->_size);
+			}
+
+			size_type max_size(void) const
+			{
+				return (this->_alloc.max_size());
+			}
+
+
+		///////////////////////////     Element access      /////////////////////////////////
+
+			mapped_type& operator[] (const key_type& k)
+			{
+				return ((*(this->insert(ft::make_pair(k, mapped_type())).first)).second);
+			}
+
+
+		////////////////////////////     Modifiers      ///////////////////////////////
+
+			// Baja por el árbol hasta donde debería estar la clave. Si ya está no hace nada; si no, cuelga
+			// una hoja nueva en el primer sitio libre que encuentra (un hijo vacío, o el hueco de terminal
+			// si la clave se acaba en un nodo), o parte en dos el camino si la clave se separa a mitad del
+			// prefijo de un nodo o de la clave de una hoja. La hoja nueva se engancha en la lista junto a la
+			// hoja que le toca por orden, que se encuentra bajando por el hermano de al lado.
+
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{
+				const key_type&	k = val.first;
+				size_type		len = key_traits::size(k);
+				radix_node**	ref = &this->_root;
+				size_type		depth = 0;
+
+				while (*ref && !_is_leaf(*ref))
+				{
+					radix_node*	n = *ref;
+					size_type	p = this->_prefix_mismatch(n, k, depth);
+
+					if (p < n->prefix_len)								// k se separa a mitad del prefijo de n
+						return (this->_split_prefix(ref, val, depth, p));
+					depth += n->prefix_len;
+					if (depth == len)									// k se acaba justo en n
+					{
+						if (n->terminal)
+							return (ft::pair<iterator, bool>(iterator(_leaf(n->terminal)), false));
+						leaf_type*	leaf = this->_new_leaf(val);
+						this->_link_before(_minimum(n), leaf);
+						n->terminal = _tag(leaf);
+						return (ft::pair<iterator, bool>(iterator(leaf), true));
+					}
+
+					unsigned char	b = key_traits::at(k, depth);
+					radix_node**	child = _find_child(n, b);
+
+					if (child == NULL)									// No hay ninguna clave que siga por b: la hoja va aquí
+					{
+						leaf_type*	leaf = this->_new_leaf(val);
+						radix_node*	next = _next_child(n, b);
+
+						if (next)
+							this->_link_before(_minimum(next), leaf);
+						else
+							this->_link_before(_maximum(n)->next, leaf);
+						this->_add_child(ref, b, _tag(leaf));
+						return (ft::pair<iterator, bool>(iterator(leaf), true));
+					}
+					ref = child;
+					++depth;
+				}
+				if (*ref == NULL)										// Árbol vacío
+				{
+					leaf_type*	leaf = this->_new_leaf(val);
+
+					this->_link_before(&this->_head, leaf);
+					*ref = _tag(leaf);
+					return (ft::pair<iterator, bool>(iterator(leaf), true));
+				}
+				return (this->_split_leaf(ref, val, depth));
+			}
+
+			iterator insert(iterator position, const value_type& val)
+			{
+				static_cast<void>(position);
+				return (this->insert(val).first);
+			}
+
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				while (first != last)
+					this->insert(*first++);
+			}
+
+			void erase(iterator position)
+			{
+				this->erase(position->first);
+			}
+
+			// Quita la hoja de su nodo y, si el nodo se queda con pocos hijos, lo cambia por uno más pequeño,
+			// o lo quita del todo si le queda uno solo (juntando su prefijo con el del hijo).
+
+			size_type erase(const key_type& k)
+			{
+				size_type		len = key_traits::size(k);
+				radix_node**	ref = &this->_root;
+				radix_node**	parent = NULL;
+				size_type		depth = 0;
+
+				while (*ref && !_is_leaf(*ref))
+				{
+					radix_node*	n = *ref;
+
+					if (!this->_prefix_matches(n, k, depth))
+						return (0);
+					depth += n->prefix_len;
+					if (depth >= len)
+					{
+						if (depth > len || n->terminal == NULL || !(_key(n->terminal) == k))
+							return (0);
+						leaf_type*	leaf = _leaf(n->terminal);
+						n->terminal = NULL;
+						if (n->count == 1)
+							this->_collapse(ref);
+						this->_del_leaf(leaf);
+						return (1);
+					}
+					parent = ref;
+					ref = _find_child(n, key_traits::at(k, depth));
+					if (ref == NULL)
+						return (0);
+					++depth;
+				}
+				if (*ref == NULL || !(_key(*ref) == k))
+					return (0);
+
+				leaf_type*	leaf = _leaf(*ref);
+				if (parent == NULL)
+					this->_root = NULL;
+				else
+					this->_remove_child(parent, key_traits::at(k, depth - 1));
+				this->_del_leaf(leaf);
+				return (1);
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				while (first != last)
+					this->erase(first++);
+			}
+
+			// Los nodos se quedan donde están; solo hay que cambiar las raíces y volver a enganchar la lista
+			// de hojas de cada uno a su propio _head.
+
+			void swap(radix_map& x)
+			{
+				radix_node*		tmp_root = this->_root;
+				size_type		tmp_size = this->_size;
+				leaf_allocator	tmp_alloc = this->_alloc;
+				radix_link		tmp_head = this->_head;
+
+				this->_root = x._root;
+				x._root = tmp_root;
+				this->_size = x._size;
+				x._size = tmp_size;
+				this->_alloc = x._alloc;
+				x._alloc = tmp_alloc;
+				this->_relink_head(x._head, &x._head);
+				x._relink_head(tmp_head, &this->_head);
+			}
+
+			void clear(void)
+			{
+				if (this->_root)
+					this->_destroy(this->_root);
+				this->_root = NULL;
+				this->_size = 0;
+				this->_head.prev = &this->_head;
+				this->_head.next = &this->_head;
+			}
+
+
+		////////////////////////////     Observers      ///////////////////////////////
+
+			key_compare key_comp(void) const
+			{
+				return (key_compare());
+			}
+
+			value_compare value_comp(void) const
+			{
+				return (value_compare(key_compare()));
+			}
+
+
+		////////////////////////////     Operations      ///////////////////////////////
+
+			// Baja consumiendo un byte por nivel. Los prefijos de los nodos solo se comparan en los bytes que
+			// están guardados en el nodo (el resto se salta), porque al final se compara la clave de la hoja
+			// entera.
+
+			iterator find(const key_type& k)
+			{
+				leaf_type*	leaf = this->_find(k);
+
+				return (leaf ? iterator(leaf) : this->end());
+			}
+
+			const_iterator find(const key_type& k) const
+			{
+				leaf_type*	leaf = this->_find(k);
+
+				return (leaf ? const_iterator(leaf) : this->end());
+			}
+
+			size_type count(const key_type& k) const
+			{
+				return (this->_find(k) ? 1 : 0);
+			}
+
+			iterator lower_bound(const key_type& k)
+			{
+				leaf_type*	leaf = (this->_root ? this->_lower_bound(this->_root, k, 0) : NULL);
+
+				return (leaf ? iterator(leaf) : this->end());
+			}
+
+			const_iterator lower_bound(const key_type& k) const
+			{
+				leaf_type*	leaf = (this->_root ? this->_lower_bound(this->_root, k, 0) : NULL);
+
+				return (leaf ? const_iterator(leaf) : this->end());
+			}
+
+			iterator upper_bound(const key_type& k)
+			{
+				iterator	it = this->lower_bound(k);
+
+				if (it != this->end() && it->first == k)
+					++it;
+				return (it);
+			}
+
+			const_iterator upper_bound(const key_type& k) const
+			{
+				const_iterator	it = this->lower_bound(k);
+
+				if (it != this->end() && it->first == k)
+					++it;
+				return (it);
+			}
+
+			ft::pair<iterator, iterator> equal_range(const key_type& k)
+			{
+				return (ft::pair<iterator, iterator>(this->lower_bound(k), this->upper_bound(k)));
+			}
+
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+			{
+				return (ft::pair<const_iterator, const_iterator>(this->lower_bound(k), this->upper_bound(k)));
+			}
+
+
+		////////////////////////////     Allocator      ///////////////////////////////
+
+			allocator_type get_allocator(void) const
+			{
+				return (allocator_type(this->_alloc));
+			}
+
+
+		////////////////////////     Private functions      ///////////////////////////
+
+		private:
+
+			// Las hojas se guardan en los punteros a hijos con el bit más bajo a 1 (las hojas están
+			// alineadas al menos a 8 bytes, así que nunca lo tienen).
+
+			static bool _is_leaf(const radix_node* p)
+			{
+				return (reinterpret_cast<size_t>(p) & 1);
+			}
+
+			static leaf_type* _leaf(const radix_node* p)
+			{
+				return (reinterpret_cast<leaf_type*>(reinterpret_cast<size_t>(p) & ~static_cast<size_t>(1)));
+			}
+
+			static radix_node* _tag(leaf_type* leaf)
+			{
+				return (reinterpret_cast<radix_node*>(reinterpret_cast<size_t>(leaf) | 1));
+			}
+
+			static const key_type& _key(const radix_node* p)
+			{
+				return (_leaf(p)->data.first);
+			}
+
+			leaf_type* _find(const key_type& k) const
+			{
+				size_type	len = key_traits::size(k);
+				radix_node*	n = this->_root;
+				size_type	depth = 0;
+
+				while (n && !_is_leaf(n))
+				{
+					if (!this->_prefix_matches(n, k, depth))
+						return (NULL);
+					depth += n->prefix_len;
+					if (depth >= len)
+					{
+						n = (depth == len ? n->terminal : NULL);
+						break ;
+					}
+
+					radix_node**	child = _find_child(n, key_traits::at(k, depth));
+					n = (child ? *child : NULL);
+					++depth;
+				}
+				if (n && _key(n) == k)
+					return (_leaf(n));
+				return (NULL);
+			}
+
+			// Primera hoja de debajo de n con clave >= k, o NULL si todas son menores. depth es el byte de k
+			// por el que va n.
+
+			leaf_type* _lower_bound(radix_node* n, const key_type& k, size_type depth) const
+			{
+				if (_is_leaf(n))
+					return (_key(n) < k ? NULL : _leaf(n));
+
+				size_type	len = key_traits::size(k);
+				size_type	p = this->_prefix_mismatch(n, k, depth);
+
+				if (p < n->prefix_len)									// k se separa del prefijo: o todo n es mayor, o todo menor
+				{
+					if (depth + p == len || key_traits::at(k, depth + p) < this->_prefix_byte(n, depth, p))
+						return (_minimum(n));
+					return (NULL);
+				}
+				depth += n->prefix_len;
+				if (depth == len)										// terminal (si hay) es igual a k, y el resto mayores
+					return (_minimum(n));
+
+				unsigned char	b = key_traits::at(k, depth);
+				radix_node**	child = _find_child(n, b);
+
+				if (child)
+				{
+					leaf_type*	ret = this->_lower_bound(*child, k, depth + 1);
+					if (ret)
+						return (ret);
+				}
+				radix_node*	next = _next_child(n, b);
+				return (next ? _minimum(next) : NULL);
+			}
+
+			// Mira solo los bytes del prefijo de n que están guardados en el nodo (y que k no se acabe antes
+			// del final del prefijo). Sirve para buscar, porque luego se compara la clave de la hoja.
+
+			bool _prefix_matches(const radix_node* n, const key_type& k, size_type depth) const
+			{
+				size_type	stored = (n->prefix_len < radix_max_prefix ? n->prefix_len : radix_max_prefix);
+
+				if (depth + n->prefix_len > key_traits::size(k))
+					return (false);
+				for (size_type i = 0; i < stored; i++)
+				{
+					if (n->prefix[i] != key_traits::at(k, depth + i))
+						return (false);
+				}
+				return (true);
+			}
+
+			// Cuántos bytes del prefijo de n coinciden con los de k a partir de depth (prefix_len si
+			// coinciden todos). Los que no están guardados en el nodo se leen de la menor hoja de debajo,
+			// ya que todas las hojas de n comparten el prefijo entero.
+
+			size_type _prefix_mismatch(const radix_node* n, const key_type& k, size_type depth) const
+			{
+				size_type	len = key_traits::size(k);
+				size_type	stored = (n->prefix_len < radix_max_prefix ? n->prefix_len : radix_max_prefix);
+				size_type	i = 0;
+
+				for (; i < stored; i++)
+				{
+					if (depth + i >= len || n->prefix[i] != key_traits::at(k, depth + i))
+						return (i);
+				}
+				if (i == n->prefix_len)
+					return (i);
+
+				const key_type&	other = _minimum(n)->data.first;
+				for (; i < n->prefix_len; i++)
+				{
+					if (depth + i >= len || key_traits::at(other, depth + i) != key_traits::at(k, depth + i))
+						return (i);
+				}
+				return (i);
+			}
+
+			unsigned char _prefix_byte(const radix_node* n, size_type depth, size_type i) const
+			{
+				if (i < radix_max_prefix)
+					return (n->prefix[i]);
+				return (key_traits::at(_minimum(n)->data.first, depth + i));
+			}
+
+			// Quita los cut primeros bytes del prefijo de n (que empieza en el byte depth de las claves).
+
+			void _cut_prefix(radix_node* n, size_type depth, size_type cut)
+			{
+				size_type	new_len = n->prefix_len - cut;
+				size_type	stored = (new_len < radix_max_prefix ? new_len : radix_max_prefix);
+
+				if (n->prefix_len <= radix_max_prefix)
+					memmove(n->prefix, n->prefix + cut, stored);
+				else
+				{
+					const key_type&	other = _minimum(n)->data.first;
+					for (size_type i = 0; i < stored; i++)
+						n->prefix[i] = key_traits::at(other, depth + cut + i);
+				}
+				n->prefix_len = new_len;
+			}
+
+			// k se separa en el byte p del prefijo de *ref: se pone en su lugar un nodo nuevo con los p bytes
+			// comunes, y de él cuelgan el nodo antiguo (sin esos p bytes ni el siguiente, que pasa a ser el
+			// byte por el que cuelga) y la hoja nueva.
+
+			ft::pair<iterator, bool> _split_prefix(radix_node** ref, const value_type& val, size_type depth, size_type p)
+			{
+				const key_type&	k = val.first;
+				radix_node*		n = *ref;
+				radix_node*		top = this->_new_node(radix_type4);
+				unsigned char	n_byte = this->_prefix_byte(n, depth, p);
+				leaf_type*		leaf = this->_new_leaf(val);
+
+				memcpy(top->prefix, n->prefix, (p < radix_max_prefix ? p : radix_max_prefix));
+				top->prefix_len = p;
+				if (depth + p == key_traits::size(k))					// k es el principio del prefijo de n: va antes que todo n
+				{
+					this->_link_before(_minimum(n), leaf);
+					top->terminal = _tag(leaf);
+				}
+				else
+				{
+					unsigned char	b = key_traits::at(k, depth + p);
+
+					if (b < n_byte)
+						this->_link_before(_minimum(n), leaf);
+					else
+						this->_link_before(_maximum(n)->next, leaf);
+					this->_add_child(&top, b, _tag(leaf));
+				}
+				this->_cut_prefix(n, depth, p + 1);
+				this->_add_child(&top, n_byte, n);
+				*ref = top;
+				return (ft::pair<iterator, bool>(iterator(leaf), true));
+			}
+
+			// Se ha llegado a la hoja *ref: si tiene la misma clave ya existe, y si no se pone en su lugar un
+			// nodo con los bytes que tienen en común las dos claves del que cuelgan las dos hojas.
+
+			ft::pair<iterator, bool> _split_leaf(radix_node** ref, const value_type& val, size_type depth)
+			{
+				const key_type&	k = val.first;
+				leaf_type*		old = _leaf(*ref);
+				const key_type&	old_k = old->data.first;
+
+				if (old_k == k)
+					return (ft::pair<iterator, bool>(iterator(old), false));
+
+				size_type		len = key_traits::size(k);
+				size_type		old_len = key_traits::size(old_k);
+				size_type		common = 0;
+
+				while (depth + common < len && depth + common < old_len
+					&& key_traits::at(k, depth + common) == key_traits::at(old_k, depth + common))
+					++common;
+
+				radix_node*		n = this->_new_node(radix_type4);
+				leaf_type*		leaf = this->_new_leaf(val);
+
+				for (size_type i = 0; i < common && i < radix_max_prefix; i++)
+					n->prefix[i] = key_traits::at(k, depth + i);
+				n->prefix_len = common;
+				depth += common;
+				this->_hang(&n, old, depth);
+				this->_hang(&n, leaf, depth);
+				if (k < old_k)
+					this->_link_before(old, leaf);
+				else
+					this->_link_before(old->next, leaf);
+				*ref = n;
+				return (ft::pair<iterator, bool>(iterator(leaf), true));
+			}
+
+			// Cuelga la hoja de *ref por su byte depth, o como terminal si su clave se acaba ahí.
+
+			void _hang(radix_node** ref, leaf_type* leaf, size_type depth)
+			{
+				if (depth == key_traits::size(leaf->data.first))
+					(*ref)->terminal = _tag(leaf);
+				else
+					this->_add_child(ref, key_traits::at(leaf->data.first, depth), _tag(leaf));
+			}
+
+
+		///////////////////////     Nodes      ///////////////////////////
+
+			radix_node* _new_node(unsigned char type)
+			{
+				radix_node*	n;
+
+				if (type == radix_type4)
+				{
+					n = node4_allocator(this->_alloc).allocate(1);
+					memset(static_cast<void*>(n), 0, sizeof(radix_node4));
+				}
+				else if (type == radix_type16)
+				{
+					n = node16_allocator(this->_alloc).allocate(1);
+					memset(static_cast<void*>(n), 0, sizeof(radix_node16));
+				}
+				else if (type == radix_type48)
+				{
+					n = node48_allocator(this->_alloc).allocate(1);
+					memset(static_cast<void*>(n), 0, sizeof(radix_node48));
+				}
+				else
+				{
+					n = node256_allocator(this->_alloc).allocate(1);
+					memset(static_cast<void*>(n), 0, sizeof(radix_node256));
+				}
+				n->type = type;
+				return (n);
+			}
+
+			void _free_node(radix_node* n)
+			{
+				if (n->type == radix_type4)
+					node4_allocator(this->_alloc).deallocate(static_cast<radix_node4*>(n), 1);
+				else if (n->type == radix_type16)
+					node16_allocator(this->_alloc).deallocate(static_cast<radix_node16*>(n), 1);
+				else if (n->type == radix_type48)
+					node48_allocator(this->_alloc).deallocate(static_cast<radix_node48*>(n), 1);
+				else
+					node256_allocator(this->_alloc).deallocate(static_cast<radix_node256*>(n), 1);
+			}
+
+			// Crea un nodo de otro tipo con la misma cabecera (prefijo y terminal) y los mismos hijos, y libera
+			// el antiguo.
+
+			radix_node* _resize(radix_node* n, unsigned char type)
+			{
+				radix_node*		ret = this->_new_node(type);
+				unsigned char	b;
+				int				i = -1;
+
+				*ret = *n;
+				ret->type = type;
+				ret->count = 0;
+				while ((i = _next_index(n, i, &b)) >= 0)
+					_append_child(ret, b, _child_at(n, i));
+				this->_free_node(n);
+				return (ret);
+			}
+
+			// Añade un hijo a un nodo que aún no tenía ninguno para ese byte y con sitio para él, en orden.
+			// Se usa al copiar los hijos de un nodo a otro de otro tipo, que ya vienen ordenados.
+
+			static void _append_child(radix_node* n, unsigned char b, radix_node* child)
+			{
+				if (n->type == radix_type4)
+				{
+					static_cast<radix_node4*>(n)->keys[n->count] = b;
+					static_cast<radix_node4*>(n)->children[n->count] = child;
+				}
+				else if (n->type == radix_type16)
+				{
+					static_cast<radix_node16*>(n)->keys[n->count] = b;
+					static_cast<radix_node16*>(n)->children[n->count] = child;
+				}
+				else if (n->type == radix_type48)
+				{
+					static_cast<radix_node48*>(n)->children[n->count] = child;
+					static_cast<radix_node48*>(n)->index[b] = static_cast<unsigned char>(n->count + 1);
+				}
+				else
+					static_cast<radix_node256*>(n)->children[b] = child;
+				++n->count;
+			}
+
+			// Añade el hijo b a *ref, cambiándolo antes por el siguiente tipo de nodo si está lleno.
+
+			void _add_child(radix_node** ref, unsigned char b, radix_node* child)
+			{
+				radix_node*	n = *ref;
+
+				if ((n->type == radix_type4 && n->count == 4) || (n->type == radix_type16 && n->count == 16)
+					|| (n->type == radix_type48 && n->count == 48))
+				{
+					n = this->_resize(n, n->type + 1);
+					*ref = n;
+				}
+				if (n->type == radix_type4 || n->type == radix_type16)
+				{
+					unsigned char*	keys = (n->type == radix_type4 ? static_cast<radix_node4*>(n)->keys : static_cast<radix_node16*>(n)->keys);
+					radix_node**	children = (n->type == radix_type4 ? static_cast<radix_node4*>(n)->children : static_cast<radix_node16*>(n)->children);
+					size_type		pos = _upper_index(n, b);
+
+					memmove(keys + pos + 1, keys + pos, n->count - pos);
+					memmove(children + pos + 1, children + pos, (n->count - pos) * sizeof(radix_node*));
+					keys[pos] = b;
+					children[pos] = child;
+					++n->count;
+				}
+				else if (n->type == radix_type48)
+				{
+					radix_node48*	x = static_cast<radix_node48*>(n);
+					size_type		slot = 0;
+
+					while (x->children[slot])							// Con los borrados pueden quedar huecos en medio
+						++slot;
+					x->children[slot] = child;
+					x->index[b] = static_cast<unsigned char>(slot + 1);
+					++n->count;
+				}
+				else
+				{
+					static_cast<radix_node256*>(n)->children[b] = child;
+					++n->count;
+				}
+			}
+
+			// Quita el hijo b de *ref. Si se queda con pocos hijos lo cambia por el tipo de nodo anterior
+			// (con algo de margen, para que insertar y borrar alrededor del límite no lo cambie cada vez), y
+			// si se queda con un solo hijo y sin terminal lo quita.
+
+			void _remove_child(radix_node** ref, unsigned char b)
+			{
+				radix_node*	n = *ref;
+
+				if (n->type == radix_type4 || n->type == radix_type16)
+				{
+					unsigned char*	keys = (n->type == radix_type4 ? static_cast<radix_node4*>(n)->keys : static_cast<radix_node16*>(n)->keys);
+					radix_node**	children = (n->type == radix_type4 ? static_cast<radix_node4*>(n)->children : static_cast<radix_node16*>(n)->children);
+					size_type		pos = 0;
+
+					while (keys[pos] != b)
+						++pos;
+					memmove(keys + pos, keys + pos + 1, n->count - pos - 1);
+					memmove(children + pos, children + pos + 1, (n->count - pos - 1) * sizeof(radix_node*));
+				}
+				else if (n->type == radix_type48)
+				{
+					radix_node48*	x = static_cast<radix_node48*>(n);
+
+					x->children[x->index[b] - 1] = NULL;
+					x->index[b] = 0;
+				}
+				else
+					static_cast<radix_node256*>(n)->children[b] = NULL;
+				--n->count;
+
+				if (n->type == radix_type256 && n->count <= 37)
+					*ref = this->_resize(n, radix_type48);
+				else if (n->type == radix_type48 && n->count <= 12)
+					*ref = this->_resize(n, radix_type16);
+				else if (n->type == radix_type16 && n->count <= 3)
+					*ref = this->_resize(n, radix_type4);
+				else if (n->count == 1 && n->terminal == NULL)
+					this->_collapse(ref);
+				else if (n->count == 0)									// Solo queda terminal: la hoja ocupa el sitio del nodo
+				{
+					*ref = n->terminal;
+					this->_free_node(n);
+				}
+			}
+
+			// *ref tiene un solo hijo y ninguna hoja terminal: el hijo ocupa su lugar. Si es un nodo interior,
+			// su prefijo pasa a ser el de *ref, el byte por el que colgaba y su propio prefijo.
+
+			void _collapse(radix_node** ref)
+			{
+				radix_node*		n = *ref;
+				unsigned char	b;
+				int				i = _next_index(n, -1, &b);
+				radix_node*		child = _child_at(n, i);
+
+				if (!_is_leaf(child))
+				{
+					unsigned char	prefix[radix_max_prefix];
+					size_type		j = 0;
+
+					for (size_type k = 0; k < n->prefix_len && j < radix_max_prefix; k++)
+						prefix[j++] = n->prefix[k];
+					if (j < radix_max_prefix)
+						prefix[j++] = b;
+					for (size_type k = 0; k < child->prefix_len && j < radix_max_prefix; k++)
+						prefix[j++] = child->prefix[k];
+					memcpy(child->prefix, prefix, j);
+					child->prefix_len += n->prefix_len + 1;
+				}
+				*ref = child;
+				this->_free_node(n);
+			}
+
+			// Libera todos los nodos y hojas del subárbol n.
+
+			void _destroy(radix_node* n)
+			{
+				if (_is_leaf(n))
+				{
+					leaf_type*	leaf = _leaf(n);
+					this->_alloc.destroy(leaf);
+					this->_alloc.deallocate(leaf, 1);
+					return ;
+				}
+
+				unsigned char	b;
+				int				i = -1;
+
+				if (n->terminal)
+					this->_destroy(n->terminal);
+				while ((i = _next_index(n, i, &b)) >= 0)
+					this->_destroy(_child_at(n, i));
+				this->_free_node(n);
+			}
+
+
+		///////////////////////     Children      ///////////////////////////
+
+			// Dirección del hijo b de n, o NULL si no tiene.
+
+			static radix_node** _find_child(radix_node* n, unsigned char b)
+			{
+				if (n->type == radix_type4)
+				{
+					radix_node4*	x = static_cast<radix_node4*>(n);
+					for (size_type i = 0; i < n->count; i++)
+					{
+						if (x->keys[i] == b)
+							return (&x->children[i]);
+					}
+					return (NULL);
+				}
+				if (n->type == radix_type16)
+				{
+					radix_node16*	x = static_cast<radix_node16*>(n);
+# ifdef __SSE2__
+					__m128i	cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(b)),
+						_mm_loadu_si128(reinterpret_cast<const __m128i*>(x->keys)));
+					int		mask = _mm_movemask_epi8(cmp) & ((1 << n->count) - 1);
+
+					return (mask ? &x->children[__builtin_ctz(mask)] : NULL);
+# else
+					for (size_type i = 0; i < n->count; i++)
+					{
+						if (x->keys[i] == b)
+							return (&x->children[i]);
+					}
+					return (NULL);
+# endif
+				}
+				if (n->type == radix_type48)
+				{
+					radix_node48*	x = static_cast<radix_node48*>(n);
+					return (x->index[b] ? &x->children[x->index[b] - 1] : NULL);
+				}
+				radix_node256*	x = static_cast<radix_node256*>(n);
+				return (x->children[b] ? &x->children[b] : NULL);
+			}
+
+			// En un nodo de 4 o de 16, posición del primer byte mayor que b (count si no hay ninguno). Los de
+			// 16 comparan los 16 a la vez: SSE2 solo compara bytes con signo, así que se les cambia antes el
+			// bit más alto para que el orden sea el de los bytes sin signo.
+
+			static size_type _upper_index(const radix_node* n, unsigned char b)
+			{
+				const unsigned char*	keys;
+
+				if (n->type == radix_type4)
+					keys = static_cast<const radix_node4*>(n)->keys;
+				else
+				{
+					keys = static_cast<const radix_node16*>(n)->keys;
+# ifdef __SSE2__
+					const __m128i	flip = _mm_set1_epi8(static_cast<char>(0x80));
+					__m128i			k = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys)), flip);
+					__m128i			q = _mm_xor_si128(_mm_set1_epi8(static_cast<char>(b)), flip);
+					int				mask = _mm_movemask_epi8(_mm_cmpgt_epi8(k, q)) & ((1 << n->count) - 1);
+
+					return (mask ? static_cast<size_type>(__builtin_ctz(mask)) : n->count);
+# endif
+				}
+				size_type	i = 0;
+				while (i < n->count && keys[i] <= b)
+					++i;
+				return (i);
+			}
+
+			// Recorre los hijos en orden: devuelve la posición del siguiente hijo después de la posición i (-1
+			// para empezar) y deja su byte en b, o -1 si no hay más. Para los nodos de 4 y 16 la posición es
+			// la de keys[] y para los de 48 y 256 es el propio byte.
+
+			static int _next_index(const radix_node* n, int i, unsigned char* b)
+			{
+				if (n->type == radix_type4 || n->type == radix_type16)
+				{
+					if (i + 1 >= n->count)
+						return (-1);
+					*b = (n->type == radix_type4 ? static_cast<const radix_node4*>(n)->keys[i + 1]
+						: static_cast<const radix_node16*>(n)->keys[i + 1]);
+					return (i + 1);
+				}
+				for (++i; i < 256; i++)
+				{
+					if (n->type == radix_type48 ? static_cast<const radix_node48*>(n)->index[i] != 0
+						: static_cast<const radix_node256*>(n)->children[i] != NULL)
+					{
+						*b = static_cast<unsigned char>(i);
+						return (i);
+					}
+				}
+				return (-1);
+			}
+
+			static int _prev_index(const radix_node* n, int i)
+			{
+				if (n->type == radix_type4 || n->type == radix_type16)
+					return (i - 1);
+				for (--i; i >= 0; i--)
+				{
+					if (n->type == radix_type48 ? static_cast<const radix_node48*>(n)->index[i] != 0
+						: static_cast<const radix_node256*>(n)->children[i] != NULL)
+						return (i);
+				}
+				return (-1);
+			}
+
+			static radix_node* _child_at(const radix_node* n, int i)
+			{
+				if (n->type == radix_type4)
+					return (static_cast<const radix_node4*>(n)->children[i]);
+				if (n->type == radix_type16)
+					return (static_cast<const radix_node16*>(n)->children[i]);
+				if (n->type == radix_type48)
+				{
+					const radix_node48*	x = static_cast<const radix_node48*>(n);
+					return (x->children[x->index[i] - 1]);
+				}
+				return (static_cast<const radix_node256*>(n)->children[i]);
+			}
+
+			// Hijo con el menor byte mayor que b, o NULL si no hay.
+
+			static radix_node* _next_child(const radix_node* n, unsigned char b)
+			{
+				if (n->type == radix_type4 || n->type == radix_type16)
+				{
+					size_type	i = _upper_index(n, b);
+					return (i < n->count ? _child_at(n, static_cast<int>(i)) : NULL);
+				}
+
+				unsigned char	next;
+				int				i = _next_index(n, b, &next);
+				return (i >= 0 ? _child_at(n, i) : NULL);
+			}
+
+			// La menor y la mayor hoja del subárbol n. La terminal, si hay, va antes que todos los hijos.
+
+			static leaf_type* _minimum(const radix_node* n)
+			{
+				unsigned char	b;
+
+				while (!_is_leaf(n))
+				{
+					if (n->terminal)
+						return (_leaf(n->terminal));
+					n = _child_at(n, _next_index(n, -1, &b));
+				}
+				return (_leaf(n));
+			}
+
+			static leaf_type* _maximum(const radix_node* n)
+			{
+				while (!_is_leaf(n))
+				{
+					if (n->count == 0)
+						return (_leaf(n->terminal));
+					n = _child_at(n, _prev_index(n, (n->type == radix_type4 || n->type == radix_type16) ? n->count : 256));
+				}
+				return (_leaf(n));
+			}
+
+
+		///////////////////////     Leaves      ///////////////////////////
+
+			leaf_type* _new_leaf(const value_type& val)
+			{
+				leaf_type*	leaf = this->_alloc.allocate(1);
+
+				this->_alloc.construct(leaf, leaf_type(val));
+				++this->_size;
+				return (leaf);
+			}
+
+			void _del_leaf(leaf_type* leaf)
+			{
+				leaf->prev->next = leaf->next;
+				leaf->next->prev = leaf->prev;
+				this->_alloc.destroy(leaf);
+				this->_alloc.deallocate(leaf, 1);
+				--this->_size;
+			}
+
+			void _link_before(radix_link* pos, leaf_type* leaf)
+			{
+				leaf->next = pos;
+				leaf->prev = pos->prev;
+				pos->prev->next = leaf;
+				pos->prev = leaf;
+			}
+
+			// Pone en _head la lista que empezaba y terminaba en old (una copia del _head de otro mapa, que
+			// estaba en old_addr).
+
+			void _relink_head(const radix_link& old, radix_link* old_addr)
+			{
+				if (old.next == old_addr)								// Vacía
+				{
+					this->_head.prev = &this->_head;
+					this->_head.next = &this->_head;
+					return ;
+				}
+				this->_head = old;
+				this->_head.next->prev = &this->_head;
+				this->_head.prev->next = &this->_head;
+			}
+	};
+
+
+	////////////////////////////     Non member overloads      ///////////////////////////////
+
+	template <class Key, class T, class Alloc>
+	bool operator== (const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class T, class Alloc>
+	bool operator!= (const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class Key, class T, class Alloc>
+	bool operator< (const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs)
+	{
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class Key, class T, class Alloc>
+	bool operator<= (const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class Key, class T, class Alloc>
+	bool operator> (const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class T, class Alloc>
+	bool operator>= (const radix_map<Key, T, Alloc>& lhs, const radix_map<Key, T, Alloc>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+
+	template <class Key, class T, class Alloc>
+	void swap(radix_map<Key, T, Alloc>& x, radix_map<Key, T, Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
@@ -0,0 +1,1851 @@
+#ifndef TREE_HPP
+# define TREE_HPP
+
+# include <memory>
+# include <new>
+# include <functional>
+# include <pthread.h>
+# include "pair.hpp"
+# include "tree_iterator.hpp"
+# include "tree_stats.hpp"
+# include "tree_policy.hpp"
+# include "../common/is_empty.hpp"
+
+// Árbol binario de búsqueda común a map, multimap, set y multiset. El árbol no sabe qué guarda cada
+// nodo: solo guarda objetos de tipo Value y usa KeyOfValue para sacar de cada uno la clave por la que se
+// ordena. En map y multimap Value es un ft::pair<const Key, T> y la clave es su primer miembro. En set y
+// multiset Value es la propia clave, así que los nodos no llevan ningún valor asociado de relleno.
+// Las funciones terminadas en _unique no insertan (ni cuentan) claves repetidas, que es lo que usan map
+// y set, y las terminadas en _equal sí, que es lo que usan multimap y multiset.
+// El último nodo del árbol (el que está más a la derecha) es siempre un nodo vacío que no guarda ningún
+// elemento y que hace de end(). Cuando el árbol está vacío ese nodo es la raíz. Va dentro del propio
+// objeto (ver inline_nodes), así que existe desde que se construye el árbol sin reservar nada, end() no
+// tiene que bajar por la derecha para encontrarlo y un end() pedido con el árbol vacío sigue siendo
+// end() después de insertar.
+// Si se compila con -DFT_TREE_STATS el árbol cuenta comparaciones, nodos visitados, altura y nodos
+// creados y destruidos (ver tree_stats.hpp). Todas las comparaciones pasan por _less() y todas las
+// búsquedas terminan en _lookup_done() para eso; sin la macro las dos se quedan en nada al compilar.
+// Las búsquedas comparan la clave buscada con la de cada nodo a través de un key_probe, que lleva la
+// clave y su prefijo. Con claves std::string y std::less se mira primero el prefijo guardado en el nodo
+// y solo si coincide se llama al comparador (ver key_prefix.hpp). Con el resto de tipos el prefijo no
+// existe y el compilador deja solo la llamada al comparador.
+
+namespace ft
+{
+	// Extractores de clave. identity devuelve el propio valor (set, multiset) y select_first el primer
+	// miembro del par (map, multimap).
+
+	template <class T>
+	struct identity
+	{
+		const T& operator() (const T& x) const
+		{
+			return (x);
+		}
+	};
+
+	template <class Pair>
+	struct select_first
+	{
+		const typename Pair::first_type& operator() (const Pair& x) const
+		{
+			return (x.first);
+		}
+	};
+
+	// Sitio para N nodos y para el nodo final dentro del propio objeto, para que los árboles pequeños no
+	// tengan que reservar memoria (ver el parámetro N de tree). Los huecos libres se llevan en los bits de
+	// used, así que N no puede ser mayor que 64. El nodo final siempre va en el último hueco, que no se
+	// cuenta en used: lo construye y lo destruye tree.
+
+	template <class Node, size_t N>
+	class inline_nodes
+	{
+		private:
+			typedef char	n_must_be_at_most_64[N <= 64 ? 1 : -1];
+
+			union
+			{
+				char		bytes[sizeof(Node) * (N + 1)];
+				long double	align_ld;							// Solo para que el array quede alineado como cualquier tipo
+				long long	align_ll;
+				void*		align_p;
+			}					_storage;
+			unsigned long long	_used;
+
+			Node* _slot(size_t i)
+			{
+				return (reinterpret_cast<Node*>(this->_storage.bytes) + i);
+			}
+
+		protected:
+			inline_nodes(void) :
+				_used(0)
+			{}
+
+			// Copiar un árbol no copia sus nodos de esta forma: cada uno empieza con todos sus huecos libres.
+
+			inline_nodes(const inline_nodes&) :
+				_used(0)
+			{}
+
+			Node* _inline_endnode(void) const
+			{
+				return (const_cast<inline_nodes*>(this)->_slot(N));
+			}
+
+			bool _inline_contains(Node* p)
+			{
+				return (p >= this->_slot(0) && p < this->_slot(N));
+			}
+
+			// Devuelve un hueco libre, o NULL si están todos ocupados.
+
+			Node* _inline_take(void)
+			{
+				if (N == 0 || (~this->_used & (~0ULL >> (64 - N))) == 0)
+					return (NULL);
+
+				size_t	i = __builtin_ctzll(~this->_used);
+
+				this->_used |= 1ULL << i;
+				return (this->_slot(i));
+			}
+
+			void _inline_give_back(Node* p)
+			{
+				this->_used &= ~(1ULL << (p - this->_slot(0)));
+			}
+	};
+
+	// Sin nodos dentro (el caso normal): solo el sitio del nodo final. Los demás se reservan con el allocator.
+
+	template <class Node>
+	class inline_nodes<Node, 0>
+	{
+		private:
+			union
+			{
+				char		bytes[sizeof(Node)];
+				long double	align_ld;
+				long long	align_ll;
+				void*		align_p;
+			}					_storage;
+
+		protected:
+			inline_nodes(void)
+			{}
+
+			inline_nodes(const inline_nodes&)
+			{}
+
+			Node* _inline_endnode(void) const
+			{
+				return (reinterpret_cast<Node*>(const_cast<char*>(this->_storage.bytes)));
+			}
+
+			bool _inline_contains(Node*)
+			{
+				return (false);
+			}
+
+			Node* _inline_take(void)
+			{
+				return (NULL);
+			}
+
+			void _inline_give_back(Node*)
+			{}
+	};
+
+	// Guarda un objeto de tipo T. Si T es una clase vacía (un comparador o un allocator sin estado, que es lo
+	// normal) en lugar de guardarlo como miembro hereda de él, y así no ocupa nada: un miembro vacío ocupa
+	// al menos un byte, más el relleno hasta el siguiente puntero, pero una clase base vacía no ocupa nada.
+	// Tag sirve para que los ebo_holder de dos miembros del mismo tipo sean clases distintas.
+
+	template <class T, int Tag, bool Empty = ft::is_empty<T>::value>
+	class ebo_holder
+	{
+		private:
+			T	_value;
+
+		public:
+			ebo_holder(const T& value) :
+				_value(value)
+			{}
+
+			T& get(void)
+			{
+				return (this->_value);
+			}
+
+			const T& get(void) const
+			{
+				return (this->_value);
+			}
+	};
+
+	template <class T, int Tag>
+	class ebo_holder<T, Tag, true> : private T
+	{
+		public:
+			ebo_holder(const T& value) :
+				T(value)
+			{}
+
+			T& get(void)
+			{
+				return (*this);
+			}
+
+			const T& get(void) const
+			{
+				return (*this);
+			}
+	};
+
+	// N es el número de elementos que caben dentro del propio árbol sin reservar memoria (0 por defecto).
+	// El nodo final va siempre dentro, así que un árbol que nunca pasa de N elementos no reserva nada en
+	// toda su vida. Los elementos que pasen de N van en nodos reservados con el allocator, igual
+	// que si N fuera 0, y el árbol sigue funcionando igual (el orden lo da el árbol, no dónde esté cada
+	// nodo). A cambio el objeto ocupa N + 1 nodos más, y swap() ya no puede intercambiar solo los punteros:
+	// copia los dos árboles, en O(n + m), e invalida los iteradores.
+
+	// El allocator, el comparador y el extractor de claves se guardan en ebo_holder (de los que hereda el
+	// árbol), así que si son clases vacías no ocupan sitio. Se usan a través de _alloc(), _key_cmp() y
+	// _key_of().
+	// Policy dice si el árbol se reorganiza al buscar (ver tree_policy.hpp; por defecto no), y también se
+	// guarda en un ebo_holder, ya que casi todas las políticas son clases vacías.
+
+	template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t N = 0,
+		class Policy = ft::plain_tree_policy>
+	class tree :
+		private ft::inline_nodes<ft::node<Value, ft::key_prefix<Key, Compare>::enabled>, N>,
+		private ft::ebo_holder<typename Alloc::template rebind<ft::node<Value, ft::key_prefix<Key, Compare>::enabled> >::other, 0>,
+		private ft::ebo_holder<Compare, 1>,
+		private ft::ebo_holder<KeyOfValue, 2>,
+		private ft::ebo_holder<Policy, 3>
+	{
+		public:
+			typedef Key																key_type;
+			typedef Value															value_type;
+			typedef Compare															key_compare;
+			typedef ft::node<value_type, ft::key_prefix<Key, Compare>::enabled>		node_type;
+			typedef node_type*														node_ptr;
+			typedef typename Alloc::template rebind<node_type>::other				allocator_type;
+			typedef ft::tree_iterator<value_type, node_type>						iterator;
+			typedef ft::tree_iterator<const value_type, node_type>					const_iterator;
+			typedef std::ptrdiff_t													difference_type;
+			typedef size_t															size_type;
+
+		private:
+			typedef typename Alloc::template rebind<node_ptr>::other				ptr_allocator_type;
+
+			// Trabajo que build_parallel() le pasa a cada hilo: ordenar nodes[lo, hi) o enlazarlo como
+			// subárbol, usando a su vez threads hilos.
+
+			struct parallel_task
+			{
+				tree*		self;
+				node_ptr*	nodes;
+				node_ptr*	buf;
+				size_type	lo;
+				size_type	hi;
+				size_type	threads;
+				node_ptr	parent;
+				node_ptr	result;
+			};
+
+			typedef ft::ebo_holder<allocator_type, 0>								alloc_holder;
+			typedef ft::ebo_holder<key_compare, 1>									cmp_holder;
+			typedef ft::ebo_holder<KeyOfValue, 2>									key_of_holder;
+			typedef ft::ebo_holder<Policy, 3>										policy_holder;
+			typedef ft::key_prefix<Key, Compare>									prefix_traits;
+
+			static const bool	prefix_cached = prefix_traits::enabled;
+
+			// La clave que se busca junto con su prefijo, calculado una sola vez por búsqueda.
+
+			struct key_probe
+			{
+				const key_type&		key;
+				unsigned long long	prefix;
+
+				explicit key_probe(const key_type& k) :
+					key(k),
+					prefix(prefix_cached ? prefix_traits::get(k) : 0)
+				{}
+
+				key_probe(const key_type& k, unsigned long long p) :
+					key(k),
+					prefix(p)
+				{}
+			};
+
+			node_ptr		_root;				// Nunca es NULL: con el árbol vacío es el nodo final
+			size_type		_size;
+			node_ptr		_block;				// Bloque de nodos reservado de una vez por assign_sorted() (o NULL)
+			size_type		_block_len;
+# ifdef FT_TREE_STATS
+			mutable tree_stats	_stats;			// mutable porque las búsquedas const también cuentan
+# endif
+
+		public:
+
+		/////////////////////////     Constructors      /////////////////////////////////
+
+			// No reservan nada: el nodo vacío que hace de end() se construye dentro del propio objeto (ver
+			// _new_endnode()), así que un contenedor vacío no cuesta ninguna reserva y end() es el mismo
+			// desde el principio.
+
+			explicit tree(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+				alloc_holder(alloc),
+				cmp_holder(comp),
+				key_of_holder(KeyOfValue()),
+				policy_holder(Policy()),
+				_root(NULL),
+				_size(0),
+				_block(NULL),
+				_block_len(0)
+			{
+				this->_root = this->_new_endnode();
+			}
+
+			tree(const tree& src) :
+				inline_nodes<node_type, N>(),
+				alloc_holder(src._alloc()),
+				cmp_holder(src._key_cmp()),
+				key_of_holder(KeyOfValue()),
+				policy_holder(Policy()),
+				_root(NULL),
+				_size(0),
+				_block(NULL),
+				_block_len(0)
+			{
+				this->_root = this->_new_endnode();
+				*this = src;
+			}
+
+
+		///////////////////////////     Destructor      /////////////////////////////////
+
+			~tree(void)
+			{
+				this->clear();
+				this->_alloc().destroy(this->_root);			// Solo queda el nodo final, que no se reservó
+			}
+
+
+		///////////////////////////     Operator=      /////////////////////////////////
+
+			// Copia el árbol nodo a nodo conservando su forma, en lugar de insertar los elementos uno a uno.
+			// Como los elementos vienen ordenados, insertarlos uno a uno los iría colgando siempre a la
+			// derecha del anterior y el árbol copiado acabaría siendo una lista.
+
+			tree& operator= (const tree& rhs)
+			{
+				if (this != &rhs)
+				{
+					this->clear();
+					this->_key_cmp() = rhs._key_cmp();
+					if (rhs._size)
+					{
+						this->_root = this->_clone(rhs._root, NULL, rhs._end(), this->_end());
+						this->_size = rhs._size;
+					}
+				}
+				return (*this);
+			}
+
+
+		///////////////////////////     Iterators      /////////////////////////////////
+
+			iterator begin(void)
+			{
+				return (iterator(leftmost(this->_root)));
+			}
+
+			const_iterator begin(void) const
+			{
+				return (const_iterator(leftmost(this->_root)));
+			}
+
+			iterator end(void)
+			{
+				return (iterator(this->_end()));
+			}
+
+			const_iterator end(void) const
+			{
+				return (const_iterator(this->_end()));
+			}
+
+
+		///////////////////////////     Capacity      /////////////////////////////////
+
+			bool empty(void) const
+			{
+				return (this->_size == 0);
+			}
+
+			size_type size(void) const
+			{
+				return (this->_size);
+			}
+
+			size_type max_size(void) const
+			{
+				return (this->_alloc().max_size());
+			}
+
+
+		////////////////////////////     Modifiers      ///////////////////////////////
+
+			// Inserta val solo si no hay ya un elemento con la misma clave. Devuelve un iterador al elemento
+			// insertado (o al que ya existía) y si se ha hecho la inserción o no.
+			// Se baja una sola vez, con una comparación por nivel (ver _descend()), y al final se mira si el
+			// último nodo por el que se bajó a la derecha tiene la misma clave. Si no, el nuevo nodo se cuelga
+			// directamente del sitio al que se ha llegado, sin volver a bajar desde la raíz.
+
+			ft::pair<iterator, bool> insert_unique(const value_type& val)
+			{
+				const key_probe	k(this->_key_of()(val));
+				node_ptr		parent;
+				node_ptr		prev;
+				size_type		depth;
+				node_ptr*		link = this->_descend(k, parent, prev, depth);
+
+				if (prev && !this->_less(prev, k))			// prev <= k y no es menor: es igual, ya existe
+				{
+					this->_accessed(prev);
+					return (ft::pair<iterator, bool>(iterator(prev), false));
+				}
+
+				node_ptr		newnode = this->_new_node(val);			// Se crea el nuevo nodo con el valor a insertar
+				this->_link_at(newnode, link, parent, depth);			// Y se engancha donde ha terminado la bajada
+				this->_accessed(newnode);
+				return (ft::pair<iterator, bool>(iterator(newnode), true));
+			}
+
+			// Inserta val aunque ya haya elementos con la misma clave. _add_node() baja por la derecha cuando
+			// las claves son iguales, así que el nuevo elemento queda detrás de los que ya había.
+
+			iterator insert_equal(const value_type& val)
+			{
+				node_ptr	newnode = this->_new_node(val);
+
+				this->_add_node(newnode);
+				this->_accessed(newnode);
+				return (iterator(newnode));
+			}
+
+			void erase(iterator position)
+			{
+				this->_del_node(position.base());
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				while (first != last)
+					this->erase(first++);
+			}
+
+			size_type erase_unique(const key_type& k)
+			{
+				node_ptr	node = this->_find(k);
+
+				if (node == NULL)
+					return (0);
+				this->_del_node(node);
+				return (1);									// Devuelve el número de elementos eliminados
+			}
+
+			size_type erase_equal(const key_type& k)
+			{
+				iterator	first(this->_lower_bound(k));
+				iterator	last(this->_upper_bound(k));
+				size_type	n = 0;
+
+				while (first != last)
+				{
+					this->erase(first++);
+					++n;
+				}
+				return (n);
+			}
+
+			void swap(tree& x)
+			{
+				if (N > 0)										// Los nodos de dentro de cada objeto no se pueden cambiar de dueño
+				{
+					tree	tmp(*this);
+
+					*this = x;
+					x = tmp;
+					return ;
+				}
+
+				node_ptr		my_root = this->_size ? this->_root : NULL;	// Los nodos finales se quedan
+				node_ptr		my_last = this->_end()->parent;				// cada uno en su objeto
+				node_ptr		x_root = x._size ? x._root : NULL;
+				node_ptr		x_last = x._end()->parent;
+				key_compare		tmp_cmp = this->_key_cmp();
+				allocator_type	tmp_alloc = this->_alloc();
+				size_type		tmp_size = this->_size;
+				node_ptr		tmp_block = this->_block;
+				size_type		tmp_block_len = this->_block_len;
+
+				this->_adopt_nodes(x_root, x_last);
+				x._adopt_nodes(my_root, my_last);
+				this->_key_cmp() = x._key_cmp();
+				x._key_cmp() = tmp_cmp;
+				this->_alloc() = x._alloc();
+				x._alloc() = tmp_alloc;
+				this->_size = x._size;
+				x._size = tmp_size;
+				this->_block = x._block;
+				x._block = tmp_block;
+				this->_block_len = x._block_len;
+				x._block_len = tmp_block_len;
+# ifdef FT_TREE_STATS
+				tree_stats		tmp_stats = this->_stats;
+				this->_stats = x._stats;
+				x._stats = tmp_stats;
+# endif
+			}
+
+			void clear(void)
+			{
+				node_ptr endnode = this->_end();
+				if (endnode != this->_root)						// Si el árbol ya está vacío solo queda el nodo final y no hay nada que borrar
+				{
+					endnode->parent->right = NULL;				// Se desengancha el nodo final para no liberarlo junto con el resto
+					this->_recursive_clear(this->_root);
+					endnode->parent = NULL;						// Su antiguo padre ya no existe, así que vuelve a ser la raíz sin padre
+					this->_root = endnode;
+					this->_size = 0;
+				}
+				if (this->_block)								// Los nodos del bloque ya están destruidos. Falta liberar el bloque entero
+				{
+					this->_alloc().deallocate(this->_block, this->_block_len);
+					this->_block = NULL;
+					this->_block_len = 0;
+				}
+			}
+
+			// Reemplaza el contenido del árbol por los n elementos a los que apunta first, que ya deben estar
+			// ordenados según key_comp() (y sin claves repetidas si el contenedor no las admite). Como no hay
+			// que buscar la posición de cada elemento, se reservan todos los nodos de una vez en un único
+			// bloque y se enlazan directamente formando un árbol equilibrado, así que cuesta O(n) en lugar
+			// de O(n log n) y hace una sola reserva de memoria.
+
+			template <class InputIterator>
+			void assign_sorted(InputIterator first, size_type n)
+			{
+				this->clear();
+				if (n == 0)
+					return ;
+				this->_block = this->_alloc().allocate(n);
+				this->_block_len = n;
+				for (size_type i = 0; i < n; i++, ++first)
+					this->_construct(this->_block + i, *first);
+				this->_link_block(n);
+			}
+
+			// Mueve todos los elementos a un único bloque de nodos nuevo, en orden, y los enlaza como un árbol
+			// equilibrado, igual que assign_sorted(). Después de muchas inserciones y borrados los nodos acaban
+			// repartidos por toda la memoria, y recorrer el árbol o bajar por él cuesta un fallo de caché por
+			// nodo. Con los nodos seguidos y en orden, recorrerlo es leer el bloque de principio a fin, y los
+			// últimos niveles de cada búsqueda caen cerca unos de otros.
+			// Cada elemento se copia una sola vez, del nodo antiguo al nuevo, y luego se liberan los antiguos
+			// (y el bloque anterior, si lo había, con los huecos de los elementos borrados desde entonces). Los
+			// iteradores dejan de ser válidos, menos end(), porque el nodo final no se mueve. Mientras dura se
+			// necesita memoria para los nodos antiguos y para el bloque nuevo a la vez.
+
+			void compact(void)
+			{
+				size_type	n = this->_size;
+
+				if (n == 0)
+				{
+					this->clear();								// Solo libera el bloque anterior, si lo había
+					return ;
+				}
+
+				node_ptr	block = this->_alloc().allocate(n);
+				node_ptr	curr = this->_root;
+				size_type	i = 0;
+
+				// Recorre el árbol en orden deshaciéndolo a la vez, para no tener que pasar otra vez por todos
+				// los nodos antiguos (repartidos por la memoria) para liberarlos: mientras el nodo actual tenga
+				// hijo izquierdo se rota a la derecha (el hijo sube a su sitio), y cuando no lo tiene ya es el
+				// menor que queda, así que se copia, se libera y se sigue por su derecha. No hacen falta los
+				// punteros al padre. El último es el nodo final, que se queda.
+				while (curr->right || curr->left)
+				{
+					if (curr->left)
+					{
+						node_ptr	left = curr->left;
+
+						curr->left = left->right;
+						left->right = curr;
+						curr = left;
+					}
+					else
+					{
+						node_ptr	next = curr->right;
+
+						this->_construct(block + i++, curr->data);
+						this->_free_node(curr);
+						curr = next;
+					}
+				}
+				if (this->_block)
+					this->_alloc().deallocate(this->_block, this->_block_len);
+				curr->parent = NULL;
+				this->_root = curr;
+				this->_size = 0;
+				this->_block = block;
+				this->_block_len = n;
+				this->_link_block(n);
+			}
+
+			// Reemplaza el contenido del árbol por los elementos de [first, last), que no tienen por qué estar
+			// ordenados, repartiendo el trabajo entre threads hilos. Los iteradores se recorren dos veces (una
+			// para contar y otra para copiar), así que no pueden ser de entrada.
+			// Igual que assign_sorted(), construye todos los nodos en un único bloque. Después ordena por clave
+			// un array de punteros a esos nodos con un merge sort en paralelo: cada hilo ordena un trozo y los
+			// trozos se van mezclando de dos en dos. El merge sort es estable, así que si unique es true se
+			// queda con el primero de cada grupo de claves repetidas (lo mismo que harían inserts sucesivos)
+			// y destruye los demás (su sitio en el bloque no se libera hasta clear()). Por último enlaza el
+			// árbol equilibrado: los primeros niveles los crea el hilo que llama y cada subárbol que cuelga
+			// de ellos lo enlaza un hilo distinto.
+			// Las comparaciones que se hacen aquí no se cuentan en stats(), porque varios hilos a la vez no
+			// pueden sumar en los mismos contadores.
+
+			template <class ForwardIterator>
+			void build_parallel(ForwardIterator first, ForwardIterator last, size_type threads, bool unique)
+			{
+				size_type	n = 0;
+
+				this->clear();
+				for (ForwardIterator it = first; it != last; ++it)
+					++n;
+				if (n == 0)
+					return ;
+				if (threads == 0)
+					threads = 1;
+
+				ptr_allocator_type	ptr_alloc(this->_alloc());
+				node_ptr*			nodes = ptr_alloc.allocate(2 * n);		// Los punteros a ordenar y, detrás, el buffer para las mezclas
+
+				this->_block = this->_alloc().allocate(n);
+				this->_block_len = n;
+				for (size_type i = 0; i < n; i++, ++first)
+				{
+					this->_construct(this->_block + i, *first);
+					nodes[i] = this->_block + i;
+				}
+				this->_parallel_sort(nodes, nodes + n, 0, n, threads);
+
+				size_type	kept = n;
+				if (unique)
+				{
+					kept = 1;
+					for (size_type i = 1; i < n; i++)
+					{
+						if (this->_sort_less(nodes[kept - 1], nodes[i]))
+							nodes[kept++] = nodes[i];
+						else
+							this->_free_node(nodes[i]);					// Clave repetida: se queda el primero que llegó
+					}
+				}
+
+				node_ptr	endnode = this->_end();
+
+				this->_root = this->_parallel_link(nodes, 0, kept, NULL, threads);
+				nodes[kept - 1]->right = endnode;
+				endnode->parent = nodes[kept - 1];
+				this->_size = kept;
+				ptr_alloc.deallocate(nodes, 2 * n);
+				this->_built_balanced(n, kept);
+			}
+
+			// Operaciones de conjuntos con las claves (solo para árboles sin claves repetidas). Cuando hay una
+			// clave en los dos árboles se queda el elemento del primero, como haría insert().
+			// Las versiones in situ (merge_unique() y subtract()) recorren src en orden y buscan cada clave en
+			// este árbol desde donde quedó la anterior (ver _finger_lower_bound()), subiendo solo lo necesario
+			// en lugar de bajar cada vez desde la raíz, así que con un src pequeño y un árbol grande y
+			// equilibrado cuestan O(m log(n/m + 1)) en lugar de O(m log n). Las claves que caen en el mismo hueco
+			// que la anterior (entre los mismos dos elementos del árbol) no se buscan: basta una comparación con
+			// el elemento que cierra el hueco. merge_unique() junta las de cada hueco y las engancha allí como un
+			// subárbol equilibrado, para que un src que cae entero en un hueco no deje una rama de m nodos.
+			// Las assign_* reemplazan el contenido por el resultado, construido en un bloque ya equilibrado
+			// como en assign_sorted(). a y b no pueden ser este mismo árbol.
+
+			void merge_unique(const tree& src)
+			{
+				if (&src == this || src._size == 0)
+					return ;
+
+				ptr_allocator_type	ptr_alloc(this->_alloc());
+				node_ptr*			run = ptr_alloc.allocate(src._size);	// Los nodos nuevos del hueco actual
+				size_type			len = 0;
+				node_ptr			gap = NULL;							// El elemento que cierra ese hueco
+				node_ptr			endnode = this->_end();
+				node_ptr			finger = NULL;
+				const_iterator		src_end = src.end();
+
+				for (const_iterator it = src.begin(); it != src_end; ++it)
+				{
+					const key_probe	k(this->_key_of()(*it));
+					node_ptr		pos = gap;
+
+					if (len == 0 || (gap != endnode && !this->_less(k, gap)))
+						pos = this->_finger_lower_bound(finger, k, endnode);
+					if (pos != endnode && !this->_less(k, pos))
+						continue ;									// Ya está: se queda el que había
+					if (pos != gap && len)
+					{
+						this->_link_run(gap, run, len, endnode);
+						len = 0;
+					}
+					gap = pos;
+					run[len++] = this->_new_node(*it);
+				}
+				if (len)
+					this->_link_run(gap, run, len, endnode);
+				ptr_alloc.deallocate(run, src._size);
+			}
+
+			void subtract(const tree& src)
+			{
+				node_ptr	endnode = this->_end();
+				node_ptr	finger = NULL;
+				node_ptr	gap = NULL;								// El elemento que cierra el hueco de la última clave que no estaba
+				const_iterator	src_end = src.end();
+
+				if (&src == this)
+				{
+					this->clear();
+					return ;
+				}
+				for (const_iterator it = src.begin(); it != src_end && this->_size; ++it)
+				{
+					const key_probe	k(this->_key_of()(*it));
+
+					if (gap == endnode)
+						break ;										// Las que quedan son mayores que todas
+					if (gap && this->_less(k, gap))
+						continue ;									// Mismo hueco que la anterior: tampoco está
+
+					node_ptr		pos = this->_finger_lower_bound(finger, k, endnode);
+
+					gap = NULL;
+					if (pos == endnode || this->_less(k, pos))
+					{
+						gap = pos;
+						continue ;
+					}
+					finger = pos->left;								// La siguiente búsqueda sigue desde el anterior, que no se borra
+					if (finger)
+						finger = rightmost(finger);
+					else
+					{
+						finger = pos;
+						while (finger->parent && finger == finger->parent->left)
+							finger = finger->parent;
+						finger = finger->parent;					// NULL si pos era el menor: se empieza desde la raíz
+					}
+					this->_del_node(pos);
+				}
+			}
+
+			// Mezcla lineal de los dos árboles: O(n + m).
+
+			void assign_union(const tree& a, const tree& b)
+			{
+				ptr_allocator_type	ptr_alloc(this->_alloc());
+				size_type			cap = a._size + b._size;
+				node_ptr*			nodes = ptr_alloc.allocate(cap ? cap : 1);
+				size_type			n = 0;
+				const_iterator		i = a.begin();
+				const_iterator		j = b.begin();
+				const_iterator		a_end = a.end();
+				const_iterator		b_end = b.end();
+
+				while (i != a_end && j != b_end)
+				{
+					if (this->_less(j.base(), i.base()))
+						nodes[n++] = (j++).base();
+					else
+					{
+						if (!this->_less(i.base(), j.base()))
+							++j;									// Clave en los dos: se queda la de a
+						nodes[n++] = (i++).base();
+					}
+				}
+				for (; i != a_end; ++i)
+					nodes[n++] = i.base();
+				for (; j != b_end; ++j)
+					nodes[n++] = j.base();
+				this->_assign_nodes(nodes, n);
+				ptr_alloc.deallocate(nodes, cap ? cap : 1);
+			}
+
+			// Recorre el más pequeño de los dos y busca cada clave en el otro: O(m log(n/m + 1)).
+
+			void assign_intersection(const tree& a, const tree& b)
+			{
+				ptr_allocator_type	ptr_alloc(this->_alloc());
+				bool				a_small = (a._size <= b._size);
+				const tree&			small = (a_small ? a : b);
+				const tree&			large = (a_small ? b : a);
+				size_type			cap = small._size;
+				node_ptr*			nodes = ptr_alloc.allocate(cap ? cap : 1);
+				node_ptr			endnode = large._end();
+				node_ptr			finger = NULL;
+				size_type			n = 0;
+				const_iterator		small_end = small.end();
+
+				for (const_iterator it = small.begin(); it != small_end; ++it)
+				{
+					const key_probe	k(small._key_of()(*it), it.base()->key_prefix());
+					node_ptr		pos = large._finger_lower_bound(finger, k, endnode);
+
+					if (pos != endnode && !large._less(k, pos))
+						nodes[n++] = (a_small ? it.base() : pos);
+				}
+				this->_assign_nodes(nodes, n);
+				ptr_alloc.deallocate(nodes, cap ? cap : 1);
+			}
+
+			// Recorre a y busca cada clave en b: O(n log(m/n + 1)).
+
+			void assign_difference(const tree& a, const tree& b)
+			{
+				ptr_allocator_type	ptr_alloc(this->_alloc());
+				size_type			cap = a._size;
+				node_ptr*			nodes = ptr_alloc.allocate(cap ? cap : 1);
+				node_ptr			endnode = b._end();
+				node_ptr			finger = NULL;
+				size_type			n = 0;
+				const_iterator		a_end = a.end();
+
+				for (const_iterator it = a.begin(); it != a_end; ++it)
+				{
+					const key_probe	k(a._key_of()(*it), it.base()->key_prefix());
+					node_ptr		pos = b._finger_lower_bound(finger, k, endnode);
+
+					if (pos == endnode || b._less(k, pos))
+						nodes[n++] = it.base();
+				}
+				this->_assign_nodes(nodes, n);
+				ptr_alloc.deallocate(nodes, cap ? cap : 1);
+			}
+
+
+		////////////////////////////     Observers      ///////////////////////////////
+
+			key_compare key_comp(void) const
+			{
+				return (this->_key_cmp());
+			}
+
+			allocator_type get_allocator(void) const
+			{
+				return (this->_alloc());
+			}
+
+
+		////////////////////////////     Operations      ///////////////////////////////
+
+			// Busca en el árbol un elemento con la clave pasada como parámetro y devuelve un iterador al mismo
+			// si lo encuentra. Si no, devuelve un iterador a end().
+			// Primero crea un puntero a nodo que inicializa con la raíz del árbol.
+			// Luego inicia el bucle para recorrer los elementos y buscar si hay coincidencia. Primero se chequea
+			// que no se haya llegado al final (que exista el elemento actual), y luego que la clave del
+			// elemento actual sea diferente a la pasada. Para hacer esto último se usa _key_cmp() que es como
+			// llamar a less. Less es una "class object function", que son instancias de una clase con una
+			// función miembro operator(). Esta función miembro permite al objeto ser usado con la misma
+			// sintaxis que una llamada a función. En este caso retorna 1 si el primer parámetro es menor
+			// que el segundo.
+			// Para no comparar dos o tres veces en cada nivel (< y > para saber si es igual, y otra vez para
+			// saber hacia dónde bajar), en realidad se baja como en lower_bound(), con una sola comparación por
+			// nivel, y solo al final se comprueba si el nodo encontrado tiene la clave buscada. Por eso, si hay
+			// varios elementos con la misma clave, devuelve el primero en orden.
+			// Con las políticas de splay la versión no const puede subir a la raíz el elemento encontrado.
+
+			iterator find(const key_type& k)
+			{
+				node_ptr	ret = this->_find(k);
+
+				if (ret == NULL)
+					return (this->end());
+				this->_accessed(ret);
+				return (iterator(ret));
+			}
+
+			const_iterator find(const key_type& k) const
+			{
+				node_ptr	ret = this->_find(k);
+
+				return (ret ? const_iterator(ret) : this->end());
+			}
+
+			size_type count(const key_type& k) const
+			{
+				const_iterator	first(this->_lower_bound(k));
+				const_iterator	last(this->_upper_bound(k));
+				size_type		n = 0;
+
+				for (; first != last; ++first)
+					++n;
+				return (n);
+			}
+
+			// Baja por el árbol: cada vez que la clave del nodo actual no es menor que la buscada, ese nodo es
+			// candidato y se sigue por la izquierda buscando uno más pequeño que también cumpla. Si es menor
+			// se sigue por la derecha. El nodo final (el vacío que hace de end()) no tiene datos válidos, así
+			// que no se compara y se usa como resultado por defecto.
+
+			iterator lower_bound(const key_type& k)
+			{
+				return (iterator(this->_lower_bound(k)));
+			}
+
+			const_iterator lower_bound(const key_type& k) const
+			{
+				return (const_iterator(this->_lower_bound(k)));
+			}
+
+			iterator upper_bound(const key_type& k)
+			{
+				return (iterator(this->_upper_bound(k)));
+			}
+
+			const_iterator upper_bound(const key_type& k) const
+			{
+				return (const_iterator(this->_upper_bound(k)));
+			}
+
+			ft::pair<iterator, iterator> equal_range(const key_type& k)
+			{
+				return (ft::pair<iterator, iterator>(this->lower_bound(k), this->upper_bound(k)));
+			}
+
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+			{
+				return (ft::pair<const_iterator, const_iterator>(this->lower_bound(k), this->upper_bound(k)));
+			}
+
+			// Las mismas búsquedas empezando desde finger, un elemento cualquiera del árbol (o NULL para
+			// empezar desde la raíz), en lugar de desde la raíz. Se sube desde finger solo hasta el primer
+			// antecesor cuyo subárbol tiene que contener la respuesta, y desde ahí se baja, así que si la clave
+			// buscada está a d elementos de la de finger (por delante o por detrás) cuesta O(log d) niveles en
+			// lugar de la altura del árbol. Al terminar finger queda en el elemento encontrado, o en el último
+			// por el que se ha pasado si no hay ninguno, para la siguiente búsqueda (ver map::finger).
+
+			iterator finger_lower_bound(node_ptr& finger, const key_type& k)
+			{
+				node_ptr	ret = this->_finger_search(finger, key_probe(k));
+
+				return (ret ? iterator(ret) : this->end());
+			}
+
+			iterator finger_find(node_ptr& finger, const key_type& k)
+			{
+				const key_probe	probe(k);
+				node_ptr		ret = this->_finger_search(finger, probe);
+
+				if (ret == NULL || this->_less(probe, ret))
+					return (this->end());
+				return (iterator(ret));
+			}
+
+
+		/////////////////////////     Getter      ///////////////////////////
+
+			node_ptr root(void) const
+			{
+				return (this->_root);
+			}
+
+
+		/////////////////////////     Statistics      ///////////////////////////
+
+			// Devuelve una copia de los contadores con la altura actual calculada en ese momento, lo que
+			// cuesta O(n). Sin FT_TREE_STATS devuelve todo a cero.
+
+			tree_stats stats(void) const
+			{
+# ifdef FT_TREE_STATS
+				tree_stats	ret = this->_stats;
+
+				ret.height = this->_height();
+				return (ret);
+# else
+				return (tree_stats());
+# endif
+			}
+
+			// Pone a cero los contadores, menos la altura máxima, que pasa a ser la actual.
+
+			void reset_stats(void)
+			{
+# ifdef FT_TREE_STATS
+				this->_stats = tree_stats();
+				this->_stats.max_height = this->_height();
+# endif
+			}
+
+
+		////////////////////////     Private functions      ///////////////////////////
+
+		private:
+
+			allocator_type& _alloc(void)
+			{
+				return (static_cast<alloc_holder&>(*this).get());
+			}
+
+			const allocator_type& _alloc(void) const
+			{
+				return (static_cast<const alloc_holder&>(*this).get());
+			}
+
+			key_compare& _key_cmp(void)
+			{
+				return (static_cast<cmp_holder&>(*this).get());
+			}
+
+			const key_compare& _key_cmp(void) const
+			{
+				return (static_cast<const cmp_holder&>(*this).get());
+			}
+
+			const KeyOfValue& _key_of(void) const
+			{
+				return (static_cast<const key_of_holder&>(*this).get());
+			}
+
+			Policy& _policy(void)
+			{
+				return (static_cast<policy_holder&>(*this).get());
+			}
+
+			const key_type& _key(node_ptr node) const
+			{
+				return (this->_key_of()(node->data));
+			}
+
+			bool _less(const key_type& a, const key_type& b) const
+			{
+# ifdef FT_TREE_STATS
+				++this->_stats.comparisons;
+# endif
+				return (this->_key_cmp()(a, b));
+			}
+
+			// Las mismas comparaciones entre la clave buscada y la de un nodo, o entre las de dos nodos,
+			// mirando antes los prefijos si los hay. Las que se resuelven con el prefijo no llegan al
+			// comparador y no cuentan en stats().
+
+			bool _less(const key_probe& a, node_ptr b) const
+			{
+				if (prefix_cached && a.prefix != b->key_prefix())
+					return (a.prefix < b->key_prefix());
+				return (this->_less(a.key, this->_key(b)));
+			}
+
+			bool _less(node_ptr a, const key_probe& b) const
+			{
+				if (prefix_cached && a->key_prefix() != b.prefix)
+					return (a->key_prefix() < b.prefix);
+				return (this->_less(this->_key(a), b.key));
+			}
+
+			bool _less(node_ptr a, node_ptr b) const
+			{
+				if (prefix_cached && a->key_prefix() != b->key_prefix())
+					return (a->key_prefix() < b->key_prefix());
+				return (this->_less(this->_key(a), this->_key(b)));
+			}
+
+			// Como _less(a, b) pero sin contar nada, para el ordenado de build_parallel(), que se hace desde
+			// varios hilos a la vez.
+
+			bool _sort_less(node_ptr a, node_ptr b) const
+			{
+				if (prefix_cached && a->key_prefix() != b->key_prefix())
+					return (a->key_prefix() < b->key_prefix());
+				return (this->_key_cmp()(this->_key(a), this->_key(b)));
+			}
+
+			void _lookup_done(size_type nodes) const
+			{
+# ifdef FT_TREE_STATS
+				this->_stats.record_lookup(nodes);
+# else
+				static_cast<void>(nodes);
+# endif
+			}
+
+			// Altura del árbol sin contar el nodo final. Lo recorre entero subiendo por los punteros al padre
+			// en lugar de con recursión, porque el caso que interesa medir es justo el del árbol degenerado
+			// en una lista, que con recursión desbordaría la pila.
+
+			size_type _height(void) const
+			{
+				node_ptr	endnode = this->_end();
+				node_ptr	curr = this->_root;
+				node_ptr	prev = NULL;
+				size_type	depth = 1;
+				size_type	height = 0;
+
+				while (curr)
+				{
+					node_ptr	next;
+
+					if (prev == curr->parent)					// Se acaba de bajar a curr
+					{
+						if (curr != endnode && depth > height)
+							height = depth;
+						next = (curr->left ? curr->left : (curr->right ? curr->right : curr->parent));
+					}
+					else if (prev == curr->left && curr->right)	// Se vuelve de la izquierda y queda la derecha
+						next = curr->right;
+					else										// Ya se han visto los dos hijos
+						next = curr->parent;
+					if (next == curr->parent)
+						--depth;
+					else
+						++depth;
+					prev = curr;
+					curr = next;
+				}
+				return (height);
+			}
+
+			// Se acaba de buscar o insertar node (un elemento, nunca el nodo final): se sube a la raíz si la
+			// política lo pide. Con plain_tree_policy el compilador no deja nada.
+
+			void _accessed(node_ptr node)
+			{
+				if (this->_policy().splay_now())
+					this->_splay(node);
+			}
+
+			// Sube x hasta la raíz de dos niveles en dos: si x y su padre son hijos del mismo lado se rota
+			// primero el padre y luego x (zig-zig), y si no se rota x dos veces (zig-zag). Así además de subir x
+			// se acortan a la mitad más o menos los caminos que pasaban por él, que es lo que hace que el
+			// coste amortizado sea O(log n). Las rotaciones no cambian el orden, y el nodo final nunca es
+			// antecesor de x (es una hoja), así que sigue siendo el de más a la derecha y una hoja.
+
+			void _splay(node_ptr x)
+			{
+				while (x->parent)
+				{
+					node_ptr	p = x->parent;
+					node_ptr	g = p->parent;
+
+					if (g == NULL)
+						this->_rotate(x);
+					else if ((x == p->left) == (p == g->left))
+					{
+						this->_rotate(p);
+						this->_rotate(x);
+					}
+					else
+					{
+						this->_rotate(x);
+						this->_rotate(x);
+					}
+				}
+			}
+
+			// Pone x en el lugar de su padre, y el padre pasa a ser su hijo (del lado contrario al que estaba x).
+
+			void _rotate(node_ptr x)
+			{
+				node_ptr	p = x->parent;
+				node_ptr	g = p->parent;
+
+				if (x == p->left)
+				{
+					p->left = x->right;
+					if (x->right)
+						x->right->parent = p;
+					x->right = p;
+				}
+				else
+				{
+					p->right = x->left;
+					if (x->left)
+						x->left->parent = p;
+					x->left = p;
+				}
+				p->parent = x;
+				x->parent = g;
+				if (g == NULL)
+					this->_root = x;
+				else if (g->left == p)
+					g->left = x;
+				else
+					g->right = x;
+# ifdef FT_TREE_STATS
+				++this->_stats.rotations;
+# endif
+			}
+
+			// El nodo final es siempre el de más a la derecha, y vive dentro del objeto.
+
+			node_ptr _end(void) const
+			{
+				return (this->_inline_endnode());
+			}
+
+			// Construye el nodo final en su sitio dentro del objeto (mientras no haya elementos es también la
+			// raíz) y lo devuelve. Solo lo llaman los constructores.
+
+			node_ptr _new_endnode(void)
+			{
+				node_ptr	endnode = this->_inline_endnode();
+
+				::new (static_cast<void*>(endnode)) node_type();
+				return (endnode);
+			}
+
+			// Cuelga del nodo final de este objeto los nodos de root, cuyo mayor elemento es last (root NULL si
+			// no hay ninguno). Lo usa swap(), que intercambia los nodos pero no los nodos finales.
+
+			void _adopt_nodes(node_ptr root, node_ptr last)
+			{
+				node_ptr	endnode = this->_end();
+
+				if (root == NULL)
+				{
+					this->_root = endnode;
+					endnode->parent = NULL;
+					return ;
+				}
+				this->_root = root;
+				last->right = endnode;
+				endnode->parent = last;
+			}
+
+			// Mientras queden huecos libres dentro del objeto el nodo va ahí, y si no se reserva.
+
+			node_ptr _new_node(const value_type& val)
+			{
+# ifdef FT_TREE_STATS
+				++this->_stats.node_allocs;
+# endif
+				node_ptr	newnode = this->_inline_take();
+				if (newnode == NULL)
+					newnode = this->_alloc().allocate(1);				// Se reserva sitio para crear un nuevo nodo
+				this->_construct(newnode, val);						// Se crea el nuevo nodo con el valor pasado
+				return (newnode);
+			}
+
+			// Construye un nodo con val en p y le pone el prefijo de su clave (si se usa; si no, no hace nada).
+			// El nodo se construye directamente en p: construct() del allocator solo sabe copiar un nodo ya
+			// hecho, así que cada valor se copiaría dos veces (al nodo temporal y de ahí a p).
+
+			void _construct(node_ptr p, const value_type& val)
+			{
+				::new (static_cast<void*>(p)) node_type(val);
+				p->set_key_prefix(prefix_traits::get(this->_key(p)));
+			}
+
+			// Los nodos que forman parte del bloque de assign_sorted() no se pueden liberar uno a uno, así que solo
+			// se destruyen. El bloque entero se libera en clear() (o en el destructor, que llama a clear()). Los que
+			// están dentro del objeto tampoco: solo se marca su hueco como libre.
+
+			void _free_node(node_ptr node)
+			{
+# ifdef FT_TREE_STATS
+				++this->_stats.node_frees;
+# endif
+				this->_alloc().destroy(node);
+				if (this->_inline_contains(node))
+					this->_inline_give_back(node);
+				else if (node < this->_block || node >= this->_block + this->_block_len)
+					this->_alloc().deallocate(node, 1);
+			}
+
+			// Devuelve el nodo con clave k, o NULL si no está. Baja como _lower_bound(), pero sin buscar antes el
+			// nodo final bajando por la derecha desde la raíz: mientras no se haya bajado nunca a la izquierda se
+			// está en el camino de la derecha, y ahí el nodo sin hijo derecho es el nodo final. Una vez que se
+			// baja a la izquierda ya no se puede llegar a él. Con splay_tree_policy ese camino cambia con cada
+			// búsqueda, así que recorrerlo entero cada vez costaría un fallo de caché por nivel.
+
+			node_ptr _find(const key_type& key) const
+			{
+				const key_probe	k(key);
+				node_ptr		curr = this->_root;
+				node_ptr		ret = NULL;
+				size_type		nodes = 0;
+
+				while (curr && (ret || curr->right))
+				{
+					++nodes;
+					if (!this->_less(curr, k))		// La clave del nodo es >= que la buscada: puede ser esta, o una más a la izquierda
+					{
+						ret = curr;
+						curr = curr->left;
+					}
+					else
+						curr = curr->right;
+				}
+				this->_lookup_done(nodes);
+				if (ret && this->_less(k, ret))		// El menor >= k es mayor que k: k no está
+					return (NULL);
+				return (ret);
+			}
+
+			node_ptr _lower_bound(const key_type& key) const
+			{
+				const key_probe	k(key);
+				node_ptr		endnode = this->_end();
+				node_ptr		curr = this->_root;
+				node_ptr		ret = endnode;
+				size_type		nodes = 0;
+
+				while (curr && curr != endnode)
+				{
+					++nodes;
+					if (!this->_less(curr, k))		// La clave del nodo es >= que la buscada: es candidato y se busca otro más a la izquierda
+					{
+						ret = curr;
+						curr = curr->left;
+					}
+					else
+						curr = curr->right;
+				}
+				this->_lookup_done(nodes);
+				return (ret);
+			}
+
+			node_ptr _upper_bound(const key_type& key) const
+			{
+				const key_probe	k(key);
+				node_ptr		endnode = this->_end();
+				node_ptr		curr = this->_root;
+				node_ptr		ret = endnode;
+				size_type		nodes = 0;
+
+				while (curr && curr != endnode)
+				{
+					++nodes;
+					if (this->_less(k, curr))		// La clave del nodo es > que la buscada: es candidato y se busca otro más a la izquierda
+					{
+						ret = curr;
+						curr = curr->left;
+					}
+					else
+						curr = curr->right;
+				}
+				this->_lookup_done(nodes);
+				return (ret);
+			}
+
+			// Copia recursivamente el subárbol src. Cuando llega al nodo final de src no crea uno nuevo sino
+			// que engancha en su lugar el nodo final propio (endnode), que ya existe.
+
+			node_ptr _clone(node_ptr src, node_ptr parent, node_ptr src_end, node_ptr endnode)
+			{
+				if (src == NULL)
+					return (NULL);
+
+				node_ptr	curr = (src == src_end ? endnode : this->_new_node(src->data));
+
+				curr->parent = parent;
+				curr->height = src->height;
+				curr->left = this->_clone(src->left, curr, src_end, endnode);
+				curr->right = this->_clone(src->right, curr, src_end, endnode);
+				return (curr);
+			}
+
+			// Enlaza los nodos del bloque en [lo, hi) como un subárbol equilibrado: el del medio es la raíz, y
+			// las dos mitades se enlazan igual a su izquierda y a su derecha. Devuelve la raíz del subárbol.
+
+			node_ptr _build_sorted(size_type lo, size_type hi, node_ptr parent)
+			{
+				if (lo == hi)
+					return (NULL);
+
+				size_type	mid = lo + (hi - lo) / 2;
+				node_ptr	curr = this->_block + mid;
+
+				curr->parent = parent;
+				curr->left = this->_build_sorted(lo, mid, curr);
+				curr->right = this->_build_sorted(mid + 1, hi, curr);
+				return (curr);
+			}
+
+			// Enlaza como árbol equilibrado los n nodos del bloque recién construidos (ya ordenados) y cuelga el
+			// nodo final del último.
+
+			void _link_block(size_type n)
+			{
+				node_ptr	endnode = this->_end();
+				node_ptr	last = this->_block + n - 1;		// El mayor de todos, que es el que tiene que apuntar al nodo final
+
+				this->_root = this->_build_sorted(0, n, NULL);
+				last->right = endnode;
+				endnode->parent = last;
+				this->_size = n;
+				this->_built_balanced(n, n);
+			}
+
+			// Reemplaza el contenido por copias de los elementos de los n nodos (de otros árboles) a los que
+			// apunta src, que ya están ordenados.
+
+			void _assign_nodes(node_ptr* src, size_type n)
+			{
+				this->clear();
+				if (n == 0)
+					return ;
+				this->_block = this->_alloc().allocate(n);
+				this->_block_len = n;
+				for (size_type i = 0; i < n; i++)
+					this->_construct(this->_block + i, src[i]->data);
+				this->_link_block(n);
+			}
+
+			// Para stats(): se han creado allocated nodos de golpe y con kept de ellos se ha construido un árbol
+			// equilibrado.
+
+			void _built_balanced(size_type allocated, size_type kept)
+			{
+# ifdef FT_TREE_STATS
+				size_type	h = 0;
+				for (size_type len = kept; len; len /= 2)
+					++h;
+				this->_stats.node_allocs += allocated;
+				if (h > this->_stats.max_height)
+					this->_stats.max_height = h;
+# else
+				static_cast<void>(allocated);
+				static_cast<void>(kept);
+# endif
+			}
+
+			// lower_bound(k) empezando desde finger en lugar de desde la raíz, para buscar claves en orden
+			// creciente. finger tiene que ser NULL (se empieza desde la raíz) o un nodo con clave <= k, y endnode
+			// el nodo final, que se pasa para no tener que buscarlo en cada llamada.
+			// Se sube desde finger mientras el padre tenga clave <= k: el nodo donde se para es hijo izquierdo
+			// de un padre con clave > k (o la raíz), así que si hay algún elemento >= k por debajo del padre
+			// está en su subárbol, y si no es el propio padre. Desde ahí se baja como en _lower_bound().
+			// Al terminar finger queda en el elemento con clave k o en el mayor con clave < k que se ha visto
+			// al bajar, que sirve como punto de partida para la siguiente clave, que será mayor.
+
+			node_ptr _finger_lower_bound(node_ptr& finger, const key_probe& k, node_ptr endnode) const
+			{
+				node_ptr	curr = this->_root;
+				node_ptr	ret = endnode;
+				size_type	nodes = 0;
+
+				if (finger)
+				{
+					curr = finger;
+					while (curr->parent && !this->_less(k, curr->parent))
+					{
+						curr = curr->parent;
+						++nodes;
+					}
+					if (curr->parent)
+						ret = curr->parent;
+				}
+				while (curr && curr != endnode)
+				{
+					++nodes;
+					if (!this->_less(curr, k))
+					{
+						ret = curr;
+						curr = curr->left;
+					}
+					else
+					{
+						finger = curr;
+						curr = curr->right;
+					}
+				}
+				this->_lookup_done(nodes);
+				if (ret != endnode && !this->_less(k, ret))
+					finger = ret;
+				return (ret);
+			}
+
+			// El menor elemento con clave >= k, o NULL si no hay (el resultado es el nodo final), buscando desde
+			// finger (ver finger_lower_bound()). Si finger tiene clave mayor que k se sube mientras el padre
+			// tenga clave >= k: donde se para, el padre es menor que k y el nodo es su hijo derecho, así que su
+			// subárbol tiene todas las claves entre el padre y finger y la respuesta está ahí. Si es menor se
+			// sube mientras el padre tenga clave <= k, como en _finger_lower_bound(), y donde se para el padre
+			// es el candidato. Como en _find(), no hace falta buscar antes el nodo final: solo se puede llegar
+			// a él si se ha subido hasta la raíz y desde ahí no se ha bajado nunca a la izquierda.
+
+			node_ptr _finger_search(node_ptr& finger, const key_probe& k) const
+			{
+				node_ptr	curr = finger;
+				node_ptr	ret = NULL;
+				size_type	nodes = 0;
+
+				if (curr == NULL)
+					curr = this->_root;
+				else if (this->_less(k, curr))						// k va antes que finger
+				{
+					ret = curr;
+					while (curr->parent && !this->_less(curr->parent, k))
+					{
+						curr = curr->parent;
+						++nodes;
+					}
+				}
+				else if (!this->_less(curr, k))						// Es el mismo
+				{
+					this->_lookup_done(1);
+					return (curr);
+				}
+				else
+				{
+					while (curr->parent && !this->_less(k, curr->parent))
+					{
+						curr = curr->parent;
+						++nodes;
+					}
+					if (curr->parent)
+						ret = curr->parent;
+				}
+				while (curr && (ret || curr->right))
+				{
+					++nodes;
+					finger = curr;
+					if (!this->_less(curr, k))
+					{
+						ret = curr;
+						curr = curr->left;
+					}
+					else
+						curr = curr->right;
+				}
+				this->_lookup_done(nodes);
+				if (ret)
+					finger = ret;
+				return (ret);
+			}
+
+			// Engancha los n nodos de nodes (ordenados, y que van todos justo antes de pos) como un subárbol
+			// equilibrado en el hueco que hay antes de pos: como hijo izquierdo de pos si no tiene, o si no a la
+			// derecha de su predecesor, que no puede tener hijo derecho. Si pos es el nodo final, el subárbol
+			// ocupa su sitio y el nodo final pasa a colgar a la derecha del mayor, para que siga siendo una hoja.
+
+			void _link_run(node_ptr pos, node_ptr* nodes, size_type n, node_ptr endnode)
+			{
+				node_ptr	parent = pos;
+				node_ptr*	link = &pos->left;
+
+				if (pos == endnode)
+				{
+					parent = pos->parent;
+					link = (parent ? &parent->right : &this->_root);
+				}
+				else if (pos->left)
+				{
+					parent = rightmost(pos->left);
+					link = &parent->right;
+				}
+				*link = this->_parallel_link(nodes, 0, n, parent, 1);
+				if (pos == endnode)
+				{
+					nodes[n - 1]->right = endnode;
+					endnode->parent = nodes[n - 1];
+				}
+				this->_size += n;
+			}
+
+			// Merge sort estable de nodes[lo, hi) por clave, usando buf[lo, hi) para las mezclas. Con más de un
+			// hilo, la mitad izquierda la ordena un hilo nuevo con la mitad de los hilos mientras este ordena
+			// la derecha con el resto. Los trozos pequeños se ordenan por inserción.
+
+			void _parallel_sort(node_ptr* nodes, node_ptr* buf, size_type lo, size_type hi, size_type threads)
+			{
+				if (hi - lo <= 16)
+				{
+					for (size_type i = lo + 1; i < hi; i++)
+					{
+						node_ptr	tmp = nodes[i];
+						size_type	j = i;
+						for (; j > lo && this->_sort_less(tmp, nodes[j - 1]); j--)
+							nodes[j] = nodes[j - 1];
+						nodes[j] = tmp;
+					}
+					return ;
+				}
+
+				size_type		mid = lo + (hi - lo) / 2;
+				parallel_task	left = {this, nodes, buf, lo, mid, threads / 2, NULL, NULL};
+
+				this->_fork_join(&tree::_sort_task, left, threads, nodes, buf, mid, hi, NULL);
+
+				size_type	i = lo;
+				size_type	j = mid;
+				size_type	k = lo;
+				while (i < mid && j < hi)						// En caso de empate primero el de la izquierda, para que sea estable
+					buf[k++] = (this->_sort_less(nodes[j], nodes[i]) ? nodes[j++] : nodes[i++]);
+				while (i < mid)
+					buf[k++] = nodes[i++];
+				while (j < hi)
+					buf[k++] = nodes[j++];
+				for (k = lo; k < hi; k++)
+					nodes[k] = buf[k];
+			}
+
+			// Como _build_sorted() pero con los nodos que indica el array (ya ordenados), y enlazando la rama
+			// izquierda en otro hilo mientras haya hilos que repartir.
+
+			node_ptr _parallel_link(node_ptr* nodes, size_type lo, size_type hi, node_ptr parent, size_type threads)
+			{
+				if (lo == hi)
+					return (NULL);
+
+				size_type		mid = lo + (hi - lo) / 2;
+				node_ptr		curr = nodes[mid];
+				parallel_task	left = {this, nodes, NULL, lo, mid, threads / 2, curr, NULL};
+
+				curr->parent = parent;
+				curr->right = this->_fork_join(&tree::_link_task, left, threads, nodes, NULL, mid + 1, hi, curr);
+				curr->left = left.result;
+				return (curr);
+			}
+
+			// Si hay más de un hilo, lanza run(left) en un hilo nuevo y mientras tanto hace en este la parte
+			// derecha [lo, hi) con los hilos que quedan. Si no se puede crear el hilo (o no hay hilos que
+			// repartir) lo hace todo en este, una parte detrás de otra. Si no se pasa buf se está enlazando:
+			// devuelve la raíz del subárbol derecho, colgado de parent, y la del izquierdo queda en left.result.
+
+			node_ptr _fork_join(void* (*run)(void*), parallel_task& left, size_type threads, node_ptr* nodes,
+				node_ptr* buf, size_type lo, size_type hi, node_ptr parent)
+			{
+				pthread_t	th;
+				bool		spawned = (threads > 1 && pthread_create(&th, NULL, run, &left) == 0);
+				size_type	rest = (spawned ? threads - threads / 2 : 1);
+				node_ptr	ret = NULL;
+
+				if (!spawned)
+					run(&left);
+				if (buf)
+					this->_parallel_sort(nodes, buf, lo, hi, rest);
+				else
+					ret = this->_parallel_link(nodes, lo, hi, parent, rest);
+				if (spawned)
+					pthread_join(th, NULL);
+				return (ret);
+			}
+
+			static void* _sort_task(void* arg)
+			{
+				parallel_task*	t = static_cast<parallel_task*>(arg);
+
+				t->self->_parallel_sort(t->nodes, t->buf, t->lo, t->hi, t->threads);
+				return (NULL);
+			}
+
+			static void* _link_task(void* arg)
+			{
+				parallel_task*	t = static_cast<parallel_task*>(arg);
+
+				t->result = t->self->_parallel_link(t->nodes, t->lo, t->hi, t->parent, t->threads);
+				return (NULL);
+			}
+
+			// https://www.youtube.com/watch?v=gcULXE7ViZw&list=PL2_aWCzGMAwI3W_JlcBbtYTwiQSsOTa6P&index=36
+			// Va haciendo llamadas recursivas para borrar el árbol (o subárbol) a partir del nodo dado.
+			// Si como argumento se pasa la raíz se borrará el árbol entero.
+
+			void _recursive_clear(node_ptr curr)
+			{
+				if (curr == NULL)
+					return ;
+				this->_recursive_clear(curr->left);
+				this->_recursive_clear(curr->right);
+				this->_free_node(curr);
+			}
+
+			// Primero se comprobaría si el árbol está vació. En ese caso simplemente habría que
+			// asignar el nuevo nodo a la raíz. En caso contrario se crea un nuevo puntero
+			// apuntando a la raíz para usarlo como iterador e ir recorriendo el árbol hasta
+			// encontrar la posición en la que se debe insertar el nuevo nodo. En un árbol de
+			// tipo BST (binary search tree) cada nodo tiene solo dos posibles hijos. En los de
+			// la izquierda estarán los valores más pequeños que el de la reíz del nodo, y en la
+			// la derecha estarán los que sean más grandes. Si la clave es igual se baja por la
+			// derecha, así que los elementos con claves repetidas (multimap y multiset) quedan
+			// en el orden en que se insertaron. Que no se repitan en map y set lo comprueba antes
+			// insert_unique().
+			// Para encontrar la posición solo hay que ir preguntando si el valor (en este caso
+			// de la clave) es mayor o menor que el del nodo pasado como parámetro. Si es menor
+			// hay que mover el puntero hacia el nodo de la izquierda (de modo que la raíz de
+			// ese nodo que actua como iterador sea ahora el nodo que había a la izquierda). Y si
+			// es mayor, pues lo mismo pero hacia la derecha. Y así sucesivamente hasta que se
+			// Así hasta que llegues a un sitio vacío (el puntero-iterador apunte a NULL). Y ese
+			// será el lugar donde habrá que insertar el valor. Y habrá que sumar uno a _size.
+			// La bajada la hace _descend() y el enlace _link_at(), que insert_unique() también usa por separado.
+
+			void _add_node(node_ptr to_add)
+			{
+				node_ptr	parent;
+				node_ptr	prev;
+				size_type	depth;
+				node_ptr*	link = this->_descend(key_probe(this->_key(to_add), to_add->key_prefix()), parent, prev, depth);
+
+				this->_link_at(to_add, link, parent, depth);
+			}
+
+			// Baja desde la raíz hasta el sitio donde iría un nodo con clave k, con una sola comparación por
+			// nivel: si k es menor que la clave del nodo actual se baja por la izquierda y si no por la derecha
+			// (también si es igual). Devuelve la dirección del enlace donde habría que colgarlo: un hijo vacío,
+			// o el enlace al nodo final si k no es menor que ninguna clave. En parent deja el nodo del que sale
+			// ese enlace (NULL si es la raíz), en depth la profundidad a la que quedaría el nuevo nodo, y en
+			// prev el último nodo por el que se ha bajado a la derecha, que es el mayor con clave <= k (NULL si
+			// no hay ninguno). Así, si ya hay un elemento con clave k, es prev.
+
+			node_ptr* _descend(const key_probe& k, node_ptr& parent, node_ptr& prev, size_type& depth)
+			{
+				node_ptr	endnode = this->_end();
+				node_ptr*	curr = &this->_root;					// Dirección del enlace por el que se va bajando
+
+				parent = NULL;
+				prev = NULL;
+				depth = 1;
+				while (*curr && *curr != endnode)
+				{
+					parent = *curr;
+					if (this->_less(k, parent))
+						curr = &parent->left;
+					else
+					{
+						prev = parent;
+						curr = &parent->right;
+					}
+					++depth;
+				}
+				this->_lookup_done(depth - 1);
+				return (curr);
+			}
+
+			// Engancha to_add en link, el enlace al que ha llegado _descend(). Si es un hijo vacío basta con
+			// colgarlo de parent. Si es el enlace al nodo final, el nuevo nodo ocupa su sitio y el nodo final
+			// pasa a colgar a su derecha, para que siga siendo el último y una hoja.
+
+			void _link_at(node_ptr to_add, node_ptr* link, node_ptr parent, size_type depth)
+			{
+				++this->_size;										// Se aumenta el tamaño del árbol
+# ifdef FT_TREE_STATS
+				if (depth > this->_stats.max_height)
+					this->_stats.max_height = depth;
+# else
+				static_cast<void>(depth);
+# endif
+				if (*link == NULL)									// Entra cuando llega a un sitio donde insertar el nuevo elemento, y no es el último lugar del árbol
+				{
+					to_add->parent = parent;						// Se enlaza el nuevo nodo con el nodo padre que le corresponde
+					*link = to_add;
+				}
+				else
+				{													// Entra cuando hay que insertar al final del árbol, porque hay que actulizar tb el endnode (no como en el if)
+					node_ptr	endnode = *link;
+
+					*link = to_add;									// Cambia el nodo vacío anclado al árbol por el nodo que hay que insertar
+					to_add->parent = endnode->parent;				// Pone como padre el padre del último nodo (en la primera inserción es NULL)
+					endnode->parent = to_add;						// Pone como padre del ultimo nodo (que ahora es el nodo vacío) el nuevo nodo
+					to_add->right = endnode;						// Pone como hijo hacia la derecha al último nodo (que ahora es el nodo vacío)
+				}
+			}
+
+			// https://www.youtube.com/watch?v=gcULXE7ViZw&list=PL2_aWCzGMAwI3W_JlcBbtYTwiQSsOTa6P&index=36
+			// Si el nodo a borrar no tiene hijos o tiene solo 1 el proceso es fácil, porque solo hay
+			// que enlazar su hijo (que puede tener a su vez los hijos que sea) con su padre. Si tiene
+			// 2 hijos la cosa es más complicada y es cuando entraría en el else. En el árbol de ejemplo
+			// de abajo, si queremos borrar el 5 (que tiene 2 hijos) hay que sustituirlo por el 6 (para
+			// que se mantengan las propiedades de un árbol binario de búsqueda de a la izquierda más
+			// pequeño y a la derecha más grande) que es el más a la izquierda de la rama derecha del
+			// nodo a borrar.
+			//
+			//						10
+			//				  5           12
+			//			  2   	  4
+			//				   7     9
+			//				 6
+
+			void _del_node(node_ptr to_del)
+			{
+				if (!to_del->left)											// Si el nodo a borrar no tiene hijo a la izquierda...
+				{
+					if (!to_del->parent)									// Si no tiene padre (es la raíz)...
+						this->_root = to_del->right;						// ...se sustituye el nodo a borrar por su hijo derecho como raíz del árbol
+					else if (to_del == to_del->parent->left)				// Si el nodo a borrar tiene padre y está a la izquierda de su padre...
+						to_del->parent->left = to_del->right;				// ...se sustituye el nodo a borrar por el de la derecha (que puede estar poblado o no)
+					else													// Si el nodo a borrar tiene padre y está a la derecha de su padre...
+						to_del->parent->right = to_del->right;				// ...se sustituye el nodo a borrar por el de la derecha (que puede estar poblado o no)
+					if (to_del->right)										// Si el nodo de la derecha del nodo a borrar existe...
+						to_del->right->parent = to_del->parent;				// ...se enlaza al padre del nodo a borrar, para que no se quede descolgado tras su eliminación
+				}
+				else if (!to_del->right)									// El mismo proceso que arriba pero si el nodo a borrar no tiene hijo a la derecha
+				{															// Cuando el nodo a borrar no tiene hijos o tiene sólo a un lado, es muy fácil
+					if (!to_del->parent)									// El problema es cuando tiene dos hijos
+						this->_root = to_del->left;
+					else if (to_del == to_del->parent->left)
+						to_del->parent->left = to_del->left;
+					else
+						to_del->parent->right = to_del->left;
+					to_del->left->parent = to_del->parent;
+				}
+				else														// Si entra aquí es porque el nodo a borrar tiene hijos tanto a derecha como a izquierda
+				{
+					node_ptr	successor = leftmost(to_del->right);		// El nodo que debe ocupar la posición del nodo borrado es el más a la izquierda de la rama derecha de este
+					if (successor == this->_end())			// Pero si es el nodo final (el nodo a borrar es el mayor) no puede subir, porque no guarda ningún dato...
+					{														// ...y tiene que seguir siendo una hoja. Así que se sube la rama izquierda y el nodo final...
+						node_ptr	last = rightmost(to_del->left);			// ...se engancha a la derecha del mayor de esa rama, que pasa a ser el último elemento
+						if (!to_del->parent)
+							this->_root = to_del->left;
+						else if (to_del == to_del->parent->left)
+							to_del->parent->left = to_del->left;
+						else
+							to_del->parent->right = to_del->left;
+						to_del->left->parent = to_del->parent;
+						last->right = successor;
+						successor->parent = last;
+						--this->_size;
+						this->_free_node(to_del);
+						return ;
+					}
+					if (!(to_del == successor->parent))						// Si el sucesor NO es hijo directo del nodo a borrar entra en el if
+					{
+						if (successor == successor->parent->left)			// Si el sucesor está situado a la izquierda de su propio padre ...
+							successor->parent->left = successor->right;		// ...el nodo a la derecha del padre del sucesor pasaría a estar directamente a la derecha del sucesor
+						else												// CREO QUE AQUÍ NO ENTRARÍA NUNCA porque para no entrar en el if anterior el sucesor tendria que estar a la
+							successor->parent->right = successor->right;	// dcha de su propio padre y eso solo puede ser si es hijo directo (y no entraría al if anterior del anterior)
+						if (successor->right != NULL)						// Si el sucesor tiene hijo a la derecha (a la izq no podría porque entonces sería ese el sucesor)...
+							successor->right->parent = successor->parent;	// este hijo pasa a ser ahora hijo del que era el abuelo.
+						successor->right = to_del->right;					// Y como el sucesor va a ocupar el sitio del nodo a borrar, se apunta el dcho del sucesor al dcho de este
+						successor->right->parent = successor;				// Y se actuliza tb el padre del nodo a la dcha del nodo a borrar por el del sucesor, que ahora va a ser su padre
+					}
+					if (!to_del->parent)									// Si el nodo a borrar no tiene padre (es la raíz)...
+						this->_root = successor;							// ..se sustituye la raíz por el sucesor
+					else if (to_del == to_del->parent->left)				// Si el nodo a borrar está a la izquierda de su padre...
+						to_del->parent->left = successor;					// ...se actualiza ese enlace para que ahora el padre, por su izquierda, tenga al sucesor
+					else													// Si no entró en el if anterior es porque el nodo a borrar está a la derecha de su padre y entonces...
+						to_del->parent->right = successor;					// ...hay que actualizar el enclace para que ahora el padre, por su derecha, tenga al sucesor
+					successor->parent = to_del->parent;						// Se actualiza el enlace para que ahora el padre del sucesor sea el padre que tenía el nodo a borrar
+					successor->left = to_del->left;							// Se actualiza el enlace para que ahora el nodo a la izquierda del sucesor sea el que tenía el nodo a borrar
+					successor->left->parent = successor;					// Y se actualiza tb este otro enlace
+				}
+				--this->_size;
+				this->_free_node(to_del);									// Se elimina finalmente el nodo a borrar
+			}
+
+	};
+}
+
+#endif
@@ -2,39 +2,45 @@
 #define TREE_ITERATOR_HPP
 
 #include "../common/iterator_traits.hpp"
+#include "key_prefix.hpp"
 
 // https://www.youtube.com/playlist?list=PL2_aWCzGMAwI3W_JlcBbtYTwiQSsOTa6P
 
 namespace ft
 {
-	template <typename T>
-	struct node
+	// Los punteros van delante y el dato al final: así, si el dato es pequeño (por ejemplo la clave int de
+	// un set), ocupa el hueco que queda detrás de height en lugar de añadir relleno antes de los punteros.
+	// Si Prefixed es true, node_prefix (la base) guarda además los primeros bytes de la clave (ver
+	// key_prefix.hpp). Si no, está vacía y el nodo no cambia.
+
+	template <typename T, bool Prefixed = false>
+	struct node : public ft::node_prefix<Prefixed>
 	{
-		T			data;
 		node*		parent;
 		node*		left;
 		node*		right;
 		int			height;
+		T			data;
 
 		node(const T& src = T()) :
-			data(src),
 			parent(NULL),
 			left(NULL),
 			right(NULL),
-			height(1)
+			height(1),
+			data(src)
 		{};
 	};
 
-	template <typename T>
-	node<T>* rightmost(node<T>* node)
+	template <typename T, bool P>
+	node<T, P>* rightmost(node<T, P>* node)
 	{
 		while (node->right != NULL)
 			node = node->right;
 		return (node);
 	}
 
-	template <typename T>
-	node<T>* leftmost(node<T>* node)
+	template <typename T, bool P>
+	node<T, P>* leftmost(node<T, P>* node)
 	{
 		while (node->left != NULL)
 			node = node->left;
@@ -70,6 +76,13 @@ namespace ft
 				*this = src;
 			}
 
+			// Permite construir un const_iterator a partir de un iterator
+
+			template <class U>
+			tree_iterator(const tree_iterator<U, node_type> &src) :
+				_node(src.base())
+			{}
+
 
 		///////////////////////////     Destructor     ////////////////////////////////
 
@@ -162,15 +175,13 @@ namespace ft
 			template <class U>
 			bool operator== (const tree_iterator<U, node_type> &rhs) const
 			{
-				return (this->_node == rhs._node);
-				//return (this->_node == rhs.base());
+				return (this->_node == rhs.base());
 			}
 
 			template <class U>
 			bool operator!= (const tree_iterator<U, node_type> &rhs) const
 			{
-				return (this->_node != rhs._node);
-				//return (this->_node != rhs.base());
+				return (this->_node != rhs.base());
 			}
 	};
 }
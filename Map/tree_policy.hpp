@@ -0,0 +1,54 @@
+#ifndef TREE_POLICY_HPP
+# define TREE_POLICY_HPP
+
+// Políticas de forma del árbol: el último parámetro de tree y de map, que dice qué hace el árbol con su
+// forma cuando se accede a un elemento. Después de cada find() (no const) e insert() el árbol llama a
+// splay_now() del objeto Policy que guarda, y si devuelve true sube el nodo encontrado o insertado hasta
+// la raíz con rotaciones de splay (https://www.cs.cmu.edu/~sleator/papers/self-adjusting.pdf). Las claves
+// que se buscan mucho acaban cerca de la raíz y cuestan menos niveles.
+//  - plain_tree_policy (por defecto): nunca. El árbol solo cambia al insertar y borrar, como siempre.
+//  - splay_tree_policy: siempre, que es el árbol splay de verdad. Pero cada rotación cambia el puntero
+//    al padre de un subárbol que no está en el camino de la búsqueda, y eso es un fallo de caché, así que
+//    en la práctica cuesta más de lo que ahorra incluso con accesos muy desiguales (ver el benchmark
+//    splay de ft_bench.cpp).
+//  - sampled_splay_tree_policy: una de cada 32 veces (splay aleatorio, Albers y Karpinski, "Randomized
+//    splay trees: theoretical and experimental results"; aquí con un contador en lugar de al azar). Las
+//    claves muy buscadas suben igual, porque alguna de sus búsquedas cae en la que toca, pero solo se
+//    paga una reorganización de cada 32.
+// Como find() puede cambiar el árbol, con las dos últimas dos hilos no pueden buscar a la vez en el
+// mismo mapa sin protegerlo (find() const no reorganiza nada y sí puede).
+
+namespace ft
+{
+	struct plain_tree_policy
+	{
+		bool splay_now(void)
+		{
+			return (false);
+		}
+	};
+
+	struct splay_tree_policy
+	{
+		bool splay_now(void)
+		{
+			return (true);
+		}
+	};
+
+	struct sampled_splay_tree_policy
+	{
+		unsigned int	accesses;
+
+		sampled_splay_tree_policy(void) :
+			accesses(0)
+		{}
+
+		bool splay_now(void)
+		{
+			return ((++this->accesses & 31) == 0);
+		}
+	};
+}
+
+#endif
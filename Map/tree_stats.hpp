@@ -0,0 +1,75 @@
+#ifndef TREE_STATS_HPP
+# define TREE_STATS_HPP
+
+# include <cstddef>
+# include <ostream>
+
+// Contadores internos del árbol de map, multimap, set y multiset, para poder ver qué forma tiene el árbol
+// y cuánto cuesta cada operación sin tener que imprimirlo entero con print_tree().
+// Solo se llevan si se compila con -DFT_TREE_STATS (con el Makefile: make bench STATS=1). Si no, los
+// contenedores no guardan ningún contador, no se cuenta nada y stats() devuelve todo a cero, así que no
+// cuesta nada tenerlo en el código. La macro tiene que estar definida (o no) igual en todos los ficheros
+// que usen los contenedores.
+
+namespace ft
+{
+	struct tree_stats
+	{
+		static const size_t	buckets = 64;				// El último cuenta las búsquedas que visitan buckets - 1 nodos o más
+
+		size_t	comparisons;							// Llamadas al comparador
+		size_t	lookups;								// Búsquedas (find, lower_bound, upper_bound, insert, erase por clave...)
+		size_t	visited;								// Nodos visitados en total por esas búsquedas
+		size_t	max_visited;							// Nodos visitados por la búsqueda más larga
+		size_t	histogram[buckets];						// histogram[i]: búsquedas que han visitado i nodos
+		size_t	height;									// Altura actual (se calcula al llamar a stats(), recorriendo el árbol)
+		size_t	max_height;								// Mayor altura que ha llegado a tener
+		size_t	rotations;								// Rotaciones hechas al reorganizar el árbol (splay_tree_policy)
+		size_t	node_allocs;							// Nodos creados (los de assign_sorted() cuentan uno a uno)
+		size_t	node_frees;								// Nodos destruidos
+
+		tree_stats(void) :
+			comparisons(0),
+			lookups(0),
+			visited(0),
+			max_visited(0),
+			height(0),
+			max_height(0),
+			rotations(0),
+			node_allocs(0),
+			node_frees(0)
+		{
+			for (size_t i = 0; i < buckets; i++)
+				this->histogram[i] = 0;
+		}
+
+		void record_lookup(size_t nodes)
+		{
+			++this->lookups;
+			this->visited += nodes;
+			if (nodes > this->max_visited)
+				this->max_visited = nodes;
+			++this->histogram[nodes < buckets ? nodes : buckets - 1];
+		}
+	};
+
+	// Imprime los contadores y las filas no vacías del histograma.
+
+	inline std::ostream& operator<< (std::ostream& o, const tree_stats& s)
+	{
+		o << "comparisons: " << s.comparisons << ", lookups: " << s.lookups;
+		if (s.lookups)
+			o << " (" << static_cast<double>(s.visited) / s.lookups << " nodes/lookup, max " << s.max_visited << ")";
+		o << std::endl << "height: " << s.height << " (max " << s.max_height << "), rotations: " << s.rotations
+			<< ", nodes allocated: " << s.node_allocs << ", freed: " << s.node_frees << std::endl;
+		for (size_t i = 0; i < tree_stats::buckets; i++)
+		{
+			if (s.histogram[i] == 0)
+				continue ;
+			o << "  " << (i == tree_stats::buckets - 1 ? ">=" : "  ") << i << " nodes: " << s.histogram[i] << std::endl;
+		}
+		return (o);
+	}
+}
+
+#endif
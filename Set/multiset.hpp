@@ -0,0 +1,289 @@
+#ifndef MULTISET_HPP
+# define MULTISET_HPP
+
+# include <memory>
+# include "../common/reverse_iterator.hpp"
+# include "../common/enable_if.hpp"
+# include "../common/is_integral.hpp"
+# include "../common/lexicographical_compare.hpp"
+# include "../common/equal.hpp"
+# include "../Map/pair.hpp"
+# include "../Map/tree.hpp"
+
+// https://www.cplusplus.com/reference/set/multiset/
+// Igual que set (ver set.hpp) pero admite elementos repetidos. Los elementos iguales quedan seguidos y en
+// el orden en que se insertaron, porque el árbol los inserta siempre detrás de los que ya había.
+
+namespace ft
+{
+	template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key> >
+	class multiset
+	{
+		public:
+			typedef Key															key_type;
+			typedef Key															value_type;
+			typedef Compare														key_compare;
+			typedef Compare														value_compare;
+			typedef Alloc														allocator_type;
+			typedef typename allocator_type::reference							reference;
+			typedef typename allocator_type::const_reference					const_reference;
+			typedef typename allocator_type::pointer							pointer;
+			typedef typename allocator_type::const_pointer						const_pointer;
+
+		private:
+			typedef ft::tree<key_type, value_type, ft::identity<value_type>, key_compare, allocator_type>	tree_type;
+
+		public:
+			typedef typename tree_type::node_type								node_type;
+			typedef typename tree_type::const_iterator							iterator;
+			typedef typename tree_type::const_iterator							const_iterator;
+			typedef ft::reverse_iterator<iterator>								reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
+			typedef std::ptrdiff_t												difference_type;
+			typedef size_t														size_type;
+
+		private:
+			tree_type	_tree;
+
+		public:
+
+		/////////////////////////     Constructors      /////////////////////////////////
+
+			explicit multiset(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+				_tree(comp, alloc)
+			{}
+
+			template <class InputIterator>
+			multiset(typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type first, InputIterator last,
+				const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+				_tree(comp, alloc)
+			{
+				this->insert(first, last);
+			}
+
+			multiset(const multiset& src) :
+				_tree(src._tree)
+			{}
+
+
+		///////////////////////////     Destructor      /////////////////////////////////
+
+			~multiset(void)
+			{}
+
+
+		///////////////////////////     Operator=      /////////////////////////////////
+
+			multiset& operator= (const multiset& rhs)
+			{
+				if (this != &rhs)
+					this->_tree = rhs._tree;
+				return (*this);
+			}
+
+
+		///////////////////////////     Iterators      /////////////////////////////////
+
+			iterator begin(void) const
+			{
+				return (this->_tree.begin());
+			}
+
+			iterator end(void) const
+			{
+				return (this->_tree.end());
+			}
+
+			reverse_iterator rbegin(void) const
+			{
+				return (reverse_iterator(this->end()));
+			}
+
+			reverse_iterator rend(void) const
+			{
+				return (reverse_iterator(this->begin()));
+			}
+
+
+		///////////////////////////     Capacity      /////////////////////////////////
+
+			bool empty(void) const
+			{
+				return (this->_tree.empty());
+			}
+
+			size_type size(void) const
+			{
+				return (this->_tree.size());
+			}
+
+			size_type max_size(void) const
+			{
+				return (this->_tree.max_size());
+			}
+
+
+		////////////////////////////     Modifiers      ///////////////////////////////
+
+			// Siempre se inserta, así que solo devuelve el iterador al nuevo elemento.
+
+			iterator insert(const value_type& val)
+			{
+				return (this->_tree.insert_equal(val));
+			}
+
+			iterator insert(iterator position, const value_type& val)
+			{
+				static_cast<void>(position);
+				return (this->insert(val));
+			}
+
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				while (first != last)
+					this->insert(*first++);
+			}
+
+			void erase(iterator position)
+			{
+				this->_tree.erase(position.base());
+			}
+
+			// Borra todos los elementos iguales a val y devuelve cuántos eran.
+
+			size_type erase(const value_type& val)
+			{
+				return (this->_tree.erase_equal(val));
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				while (first != last)
+					this->erase(first++);
+			}
+
+			void swap(multiset& x)
+			{
+				this->_tree.swap(x._tree);
+			}
+
+			void clear(void)
+			{
+				this->_tree.clear();
+			}
+
+
+		////////////////////////////     Observers      ///////////////////////////////
+
+			key_compare key_comp(void) const
+			{
+				return (this->_tree.key_comp());
+			}
+
+			value_compare value_comp(void) const
+			{
+				return (this->_tree.key_comp());
+			}
+
+
+		////////////////////////////     Operations      ///////////////////////////////
+
+			iterator find(const value_type& val) const
+			{
+				return (this->_tree.find(val));
+			}
+
+			size_type count(const value_type& val) const
+			{
+				return (this->_tree.count(val));
+			}
+
+			iterator lower_bound(const value_type& val) const
+			{
+				return (this->_tree.lower_bound(val));
+			}
+
+			iterator upper_bound(const value_type& val) const
+			{
+				return (this->_tree.upper_bound(val));
+			}
+
+			ft::pair<iterator, iterator> equal_range(const value_type& val) const
+			{
+				return (this->_tree.equal_range(val));
+			}
+
+
+		////////////////////////////     Allocator      ///////////////////////////////
+
+			allocator_type get_allocator(void) const
+			{
+				return (allocator_type(this->_tree.get_allocator()));
+			}
+
+
+		/////////////////////////     Statistics      ///////////////////////////
+
+			// Ver set::stats().
+
+			ft::tree_stats stats(void) const
+			{
+				return (this->_tree.stats());
+			}
+
+			void reset_stats(void)
+			{
+				this->_tree.reset_stats();
+			}
+	};
+
+
+	////////////////////////////     Non member overloads      ///////////////////////////////
+
+	template <class Key, class Compare, class Alloc>
+	bool operator== (const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool operator!= (const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool operator< (const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool operator<= (const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool operator> (const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool operator>= (const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	void swap(multiset<Key, Compare, Alloc>& x, multiset<Key, Compare, Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef REALLOC_ALLOCATOR_HPP
+# define REALLOC_ALLOCATOR_HPP
+
+# include <cstdlib>
+# include <cstddef>
+# include <new>
+# include <limits>
+
+// Allocator que reserva con malloc() y además puede cambiar de tamaño un bloque con realloc(). Si detrás
+// del bloque hay espacio libre realloc() lo amplía sin moverlo, y con bloques grandes (los que malloc saca
+// directamente del sistema con mmap, a partir de 128 KiB por defecto) glibc usa mremap(), que mueve las
+// páginas cambiando la tabla de páginas en lugar de copiar los bytes. Así un vector enorme crece sin
+// copiar nada.
+// allocator_reallocate<Alloc> dice si un allocator sabe hacerlo: vector lo consulta al crecer, y si value
+// es true (y los elementos se pueden mover por bytes, ver common/is_trivially_relocatable.hpp) llama a
+// allocator_reallocate<Alloc>::reallocate() en lugar de reservar otro bloque y copiar. Se puede
+// especializar para otros allocators que tengan algo equivalente.
+
+namespace ft
+{
+	template <class T>
+	class realloc_allocator
+	{
+		public:
+			typedef T			value_type;
+			typedef T*			pointer;
+			typedef const T*	const_pointer;
+			typedef T&			reference;
+			typedef const T&	const_reference;
+			typedef size_t		size_type;
+			typedef ptrdiff_t	difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef realloc_allocator<U>	other;
+			};
+
+			realloc_allocator(void)
+			{}
+
+			template <class U>
+			realloc_allocator(const realloc_allocator<U>&)
+			{}
+
+			pointer allocate(size_type n, const void* = 0)
+			{
+				void*	p = std::malloc(n * sizeof(T));
+
+				if (p == NULL && n != 0)
+					throw std::bad_alloc();
+				return (static_cast<pointer>(p));
+			}
+
+			void deallocate(pointer p, size_type)
+			{
+				std::free(p);
+			}
+
+			// Devuelve el bloque de p con sitio para n elementos y los primeros bytes intactos, que puede
+			// estar en otra dirección. Si falla, p sigue siendo válido.
+
+			pointer reallocate(pointer p, size_type, size_type n)
+			{
+				void*	ret = std::realloc(static_cast<void*>(p), n * sizeof(T));
+
+				if (ret == NULL && n != 0)
+					throw std::bad_alloc();
+				return (static_cast<pointer>(ret));
+			}
+
+			void construct(pointer p, const T& val)
+			{
+				new (p) T(val);
+			}
+
+			void destroy(pointer p)
+			{
+				p->~T();
+			}
+
+			size_type max_size(void) const
+			{
+				return (std::numeric_limits<size_type>::max() / sizeof(T));
+			}
+
+			bool operator== (const realloc_allocator&) const
+			{
+				return (true);
+			}
+
+			bool operator!= (const realloc_allocator&) const
+			{
+				return (false);
+			}
+	};
+
+	template <class Alloc>
+	struct allocator_reallocate
+	{
+		static const bool	value = false;
+
+		static typename Alloc::pointer reallocate(Alloc&, typename Alloc::pointer p, size_t, size_t)
+		{
+			return (p);
+		}
+	};
+
+	template <class T>
+	struct allocator_reallocate<ft::realloc_allocator<T> >
+	{
+		static const bool	value = true;
+
+		static T* reallocate(ft::realloc_allocator<T>& alloc, T* p, size_t old_n, size_t n)
+		{
+			return (alloc.reallocate(p, old_n, n));
+		}
+	};
+}
+
+#endif
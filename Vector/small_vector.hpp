@@ -0,0 +1,59 @@
+#ifndef SMALL_VECTOR_HPP
+# define SMALL_VECTOR_HPP
+
+# include "vector.hpp"
+
+// small_vector<T, N> es un vector con sitio para N elementos dentro del propio objeto: mientras no pasa de N
+// no reserva memoria, y si pasa se muda a un bloque del allocator y sigue como cualquier vector. Va bien para
+// los vectores que casi siempre son cortos (los argumentos de una llamada, los hijos de un nodo, una pila
+// que rara vez pasa de unos pocos elementos), que con un vector normal costarían una reserva y una
+// liberación cada uno. A cambio el objeto ocupa N elementos más, y swap() copia los elementos que estén
+// dentro de alguno de los dos (el bloque del otro, si lo tiene, cambia de dueño sin copiarse).
+// Es el mismo ft::vector (con el parámetro N, ver vector.hpp), así que tiene sus mismas funciones, se
+// compara con los mismos operadores y se puede usar de contenedor de ft::stack:
+//     ft::stack<int, ft::small_vector<int, 16> >	s;
+// Esta clase solo existe porque C++98 no tiene alias de plantillas: repite los constructores y nada más.
+
+namespace ft
+{
+	template <class T, size_t N, class Alloc = std::allocator<T>, class Growth = ft::double_growth_policy>
+	class small_vector : public ft::vector<T, Alloc, Growth, N>
+	{
+		public:
+			typedef ft::vector<T, Alloc, Growth, N>			vector_type;
+			typedef typename vector_type::value_type		value_type;
+			typedef typename vector_type::allocator_type	allocator_type;
+			typedef typename vector_type::size_type			size_type;
+
+		/////////////////////////     Constructors      /////////////////////////////////
+
+			explicit small_vector(const allocator_type& alloc = allocator_type())	:
+				vector_type(alloc)
+			{}
+
+			explicit small_vector(size_type n, const value_type& val = value_type(),
+				const allocator_type& alloc = allocator_type())	:
+				vector_type(n, val, alloc)
+			{}
+
+			template <class InputIterator>
+			small_vector(typename ft::enable_if< !ft::is_integral< InputIterator >::value, InputIterator >::type first,
+				InputIterator last, const allocator_type& alloc = allocator_type())	:
+				vector_type(first, last, alloc)
+			{}
+
+			small_vector(const small_vector& x)	:
+				vector_type(x)
+			{}
+
+		/////////////////////     Operator= overload      /////////////////////////
+
+			small_vector& operator= (const small_vector& x)
+			{
+				vector_type::operator=(x);
+				return (*this);
+			}
+	};
+}
+
+#endif
@@ -3,17 +3,86 @@
 
 # include <memory>
 # include <stdexcept>
+# include <cstring>
 # include "vector_iterator.hpp"
+# include "vector_growth.hpp"
+# include "realloc_allocator.hpp"
 # include "../common/reverse_iterator.hpp"
 # include "../common/lexicographical_compare.hpp"
 # include "../common/equal.hpp"
 # include "../common/enable_if.hpp"
 # include "../common/is_integral.hpp"
+# include "../common/is_trivially_copyable.hpp"
+# include "../common/is_trivially_relocatable.hpp"
 
 namespace ft
 {
-	template <class T, class Alloc = std::allocator<T> >
-	class vector
+	// Sitio para N elementos sin construir dentro del propio vector, para que los vectores cortos no tengan
+	// que reservar memoria (ver el parámetro N de vector y small_vector.hpp). Es lo mismo que inline_nodes
+	// en tree.hpp, pero con los elementos seguidos, como en el bloque del allocator.
+
+	template <class T, size_t N>
+	class inline_elements
+	{
+		private:
+			union
+			{
+				char		bytes[sizeof(T) * N];
+				long double	align_ld;							// Solo para que el array quede alineado como cualquier tipo
+				long long	align_ll;
+				void*		align_p;
+			}			_storage;
+
+		protected:
+			inline_elements(void)
+			{}
+
+			// Copiar un vector no copia sus elementos de esta forma: los construye el vector uno a uno
+
+			inline_elements(const inline_elements&)
+			{}
+
+			T* _inline_buffer(void)
+			{
+				return (reinterpret_cast<T*>(this->_storage.bytes));
+			}
+
+			bool _inline_contains(const T* p) const
+			{
+				return (p == reinterpret_cast<const T*>(this->_storage.bytes));
+			}
+	};
+
+	// Sin elementos dentro (el caso normal): no ocupa nada, porque vector hereda de ella
+
+	template <class T>
+	class inline_elements<T, 0>
+	{
+		protected:
+			T* _inline_buffer(void)
+			{
+				return (NULL);
+			}
+
+			bool _inline_contains(const T*) const
+			{
+				return (false);
+			}
+	};
+
+	// Growth es la política de crecimiento (ver vector_growth.hpp), que decide cuánto se amplía la capacidad
+	// cuando no cabe un elemento más. Por defecto se duplica, como en std::vector.
+	// N es el número de elementos que caben dentro del propio vector sin reservar memoria (0 por defecto):
+	// un vector nuevo empieza con capacidad N y sus elementos en el objeto, y solo cuando pasa de N se
+	// mudan a un bloque del allocator (y solo vuelven si caben al reducir la capacidad, con shrink_to_fit()
+	// o con shrinking_growth_policy). A cambio el objeto ocupa N elementos más, y swap()
+	// no puede intercambiar solo los punteros si alguno de los dos los tiene dentro: entonces copia los de
+	// dentro (los dos, en O(n + m), si los dos los tienen dentro; si no, el bloque del otro cambia de dueño)
+	// e invalida los iteradores. Normalmente se usa a través de small_vector<T, N>.
+
+	template <class T, class Alloc = std::allocator<T>, class Growth = ft::double_growth_policy, size_t N = 0>
+	class vector :
+		private ft::inline_elements<T, N>
 	{
 		public:
 			typedef T											value_type;
@@ -40,10 +109,11 @@ namespace ft
 		/////////////////////////     Constructors      /////////////////////////////////
 
 			explicit vector(const allocator_type& alloc = allocator_type())	:
+				inline_elements<T, N>(),
 				_size(0),
-				_capacity(0),
+				_capacity(N),
 				_alloc(alloc),
-				_array(NULL)
+				_array(this->_inline_buffer())
 			{}
 
 			// En este constructor se le pasa obligatoriamente un primer parámetro que será un número para saber cuantos
@@ -59,12 +129,17 @@ namespace ft
 
 			explicit vector(size_type n, const value_type& val = value_type(),
 				const allocator_type& alloc = allocator_type())	:
+				inline_elements<T, N>(),
 				_size(n),
-				_capacity(n),
+				_capacity(N),
 				_alloc(alloc),
-				_array(NULL)
+				_array(this->_inline_buffer())
 			{
-				this->_array = this->_alloc.allocate(this->_capacity);
+				if (n > this->_capacity)						// Si caben dentro (o n = 0) no se reserva nada
+				{
+					this->_array = this->_alloc.allocate(n);
+					this->_capacity = n;
+				}
 				for (size_t i = 0; i < this->_size; i++)
 					this->_alloc.construct(this->_array + i, val);
 			}
@@ -80,50 +155,72 @@ namespace ft
 			template <class InputIterator>
 			vector(typename ft::enable_if< !ft::is_integral< InputIterator >::value, InputIterator >::type first,
 				InputIterator last, const allocator_type& alloc = allocator_type())	:
+				inline_elements<T, N>(),
 				_size(0),
-				_capacity(0),
+				_capacity(N),
 				_alloc(alloc),
-				_array(NULL)
+				_array(this->_inline_buffer())
 			{
-				for (; first != last; first++)
-				this->push_back(*first);
+				this->range_init(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
 			}
 
+			// Como el de std, reserva solo los elementos que hay, no la capacidad de x.
+
 			vector(const vector& x)	:
-				_size(0),
-				_capacity(0),
-				_array(NULL)
+				inline_elements<T, N>(),
+				_size(x._size),
+				_capacity(N),
+				_alloc(x._alloc),
+				_array(this->_inline_buffer())
 			{
-				*this = x;
+				if (this->_size > this->_capacity)
+				{
+					this->_array = this->_alloc.allocate(this->_size);
+					this->_capacity = this->_size;
+				}
+				this->construct_copy(this->_array, x._array, this->_size);
 			}
 
 		/////////////////////////////     Destructor      /////////////////////////////
 
 			~vector()
 			{
-				if (this->_capacity != 0)
-				{
-					for (size_t i = 0; i < this->_size; i++)
-						this->_alloc.destroy(this->_array + i);
-					this->_alloc.deallocate(this->_array, this->_capacity);
-				}
+				this->destroy_range(this->_array, this->_size);
+				this->release_array();
 			}
 
 		/////////////////////     Operator= overload      /////////////////////////
 
+			// Si los elementos de x caben en la capacidad que ya hay, se reutiliza: se asigna sobre los que ya
+			// existen y solo se construyen o destruyen los que faltan o sobran, sin liberar ni reservar nada
+			// (un vector que se reasigna una y otra vez en un bucle solo reserva la primera vez). Si no caben,
+			// se reserva justo x.size(), como std::vector, no la capacidad de x.
+
 			vector& operator= (const vector& x)
 			{
-				if (this != &x)
+				if (this == &x)
+					return (*this);
+				if (x._size > this->_capacity)
 				{
-					this->~vector();
-					this->_size = x._size;
-					this->_capacity = x._capacity;
-					this->_alloc = x._alloc;
-					if (this->_capacity != 0)
-						this->_array = this->_alloc.allocate(this->_capacity);
-					for (size_t i = 0; i < this->_size; i++)
-						this->_alloc.construct(this->_array + i, x._array[i]);
+					pointer	new_alloc = this->_alloc.allocate(x._size);
+
+					this->construct_copy(new_alloc, x._array, x._size);
+					this->destroy_range(this->_array, this->_size);
+					this->release_array();
+					this->_array = new_alloc;
+					this->_capacity = x._size;
 				}
+				else if (x._size <= this->_size)
+				{
+					this->assign_copy(this->_array, x._array, x._size);
+					this->destroy_range(this->_array + x._size, this->_size - x._size);
+				}
+				else
+				{
+					this->assign_copy(this->_array, x._array, this->_size);
+					this->construct_copy(this->_array + this->_size, x._array + this->_size, x._size - this->_size);
+				}
+				this->_size = x._size;
 				return (*this);
 			}
 
@@ -184,17 +281,61 @@ namespace ft
 				return (this->_alloc.max_size());
 			}
 
+			// Los elementos nuevos se construyen todos seguidos en la memoria reservada, sin comprobar la
+			// capacidad en cada uno; si no caben se reserva una sola vez según la política Growth, así que
+			// ir ampliando un vector con resize() no reserva cada vez. Al reducir se destruyen los que
+			// sobran y se mantiene la capacidad (salvo con shrinking_growth_policy, ver vector_growth.hpp).
+
 			void resize(size_type n, value_type val = value_type())
 			{
 				if (n > this->_size)
 				{
-					redimension(n);
-					for (size_t i = this->_size; i < n; i++)
-						push_back(val);
+					if (n > this->_capacity)
+						this->redimension(this->next_capacity(n));
+					this->construct_fill(this->_array + this->_size, n - this->_size, val);
+					this->_size = n;
+				}
+				else
+				{
+					this->destroy_range(this->_array + n, this->_size - n);
+					this->_size = n;
+					this->shrink_if_needed();
 				}
-				else if (n < this->_size)
-					for (size_t i = this->_size - n; i > 0; i--)
-						pop_back();
+			}
+
+			// Como resize(), pero los elementos nuevos se construyen sin valor (como T x;, no T x = T();):
+			// con int, char, structs de números... la memoria se queda como estaba, sin escribir ceros que
+			// se van a sobrescribir enseguida, por ejemplo con los bytes de un read(). Con otros tipos es
+			// igual que resize(). Leer uno de esos elementos antes de escribirlo da un valor cualquiera.
+
+			void resize_default_init(size_type n)
+			{
+				if (n > this->_size)
+				{
+					if (n > this->_capacity)
+						this->redimension(this->next_capacity(n));
+					this->construct_default(this->_array + this->_size, n - this->_size);
+					this->_size = n;
+				}
+				else
+				{
+					this->destroy_range(this->_array + n, this->_size - n);
+					this->_size = n;
+					this->shrink_if_needed();
+				}
+			}
+
+			// Añade n elementos al final construidos sin valor, igual que resize_default_init(size() + n), y
+			// devuelve un puntero al primero para escribir en ellos directamente:
+			//     ssize_t r = read(fd, buf.append_default_init(4096), 4096);
+			//     buf.resize(buf.size() - 4096 + (r > 0 ? r : 0));
+
+			pointer append_default_init(size_type n)
+			{
+				size_type	old_size = this->_size;
+
+				this->resize_default_init(this->_size + n);
+				return (this->_array + old_size);
 			}
 
 			size_type capacity() const
@@ -217,6 +358,17 @@ namespace ft
 				}
 			}
 
+			// Deja la capacidad justo en size() (o en N, con los elementos otra vez dentro del objeto, si caben
+			// ahí), pasando los elementos a un bloque nuevo del tamaño justo, o con realloc() si el allocator
+			// sabe (ver realloc_allocator.hpp). Con el vector vacío libera el bloque. Invalida los iteradores
+			// si cambia la capacidad.
+
+			void shrink_to_fit(void)
+			{
+				if (this->_size < this->_capacity)
+					this->shrink_to(this->_size);
+			}
+
 		//////////////////////     Element access      ///////////////////////////
 
 			// Hace lo mismo que at() pero no chequea si n está fuera de rango
@@ -279,32 +431,19 @@ namespace ft
 
 			// En este caso se reemplaza con los valores en el rango pasado por los iteradores first y last
 			// Se usa otra vez enable_if y is_integral para que no haya dudas con la sobrecarga de la funcion assign()
+			// Igual que el constructor y el insert() de rangos, según el tipo de iterador (ver range_init())
 
 			template <class InputIterator>
 			void assign(typename ft::enable_if<!is_integral<InputIterator>::value,
 				InputIterator>::type first, InputIterator last)
 			{
-				size_t	i = last - first;
-				this->clear();
-
-				if (this->_capacity < i)
-					this->reserve(i);
-				while (first != last)
-				{
-					this->push_back(*first);
-					first++;
-				}
+				this->range_assign(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
 			}
 
 			void push_back(const value_type& val)
 			{
-				if (!this->_capacity)
-				{
-					this->_array = this->_alloc.allocate(1);
-					this->_capacity++;
-				}
-				else if (this->_size == this->_capacity)
-					redimension(this->_capacity * 2);
+				if (this->_size == this->_capacity)
+					this->redimension(this->next_capacity(this->_size + 1));
 				this->_alloc.construct(this->_array + this->_size, val);
 				this->_size++;
 			}
@@ -315,6 +454,7 @@ namespace ft
 				{
 					this->_alloc.destroy(this->_array + (this->_size - 1));
 					this->_size --;
+					this->shrink_if_needed();
 				}
 			}
 
@@ -322,79 +462,126 @@ namespace ft
 			{
 				if (this->_capacity == this->max_size())
 					return (NULL);
-				if (this->_capacity == 0)
+
+				// Si los elementos se pueden mover por bytes, se abre el hueco con un memmove y se construye
+				// el nuevo en él. Si val es uno de los elementos del vector hay que copiarlo antes, porque
+				// al abrir el hueco cambia de sitio (o deja de existir si hay que reservar más memoria).
+
+				if (ft::is_trivially_relocatable<T>::value)
 				{
-					this->push_back(val);
-					return (position);
+					size_type	pos = position - this->begin();
+
+					if (&val >= this->_array && &val < this->_array + this->_size)
+					{
+						value_type	copy(val);
+						return (this->insert(position, copy));
+					}
+					this->open_gap(pos, 1);
+					this->_alloc.construct(this->_array + pos, val);
+					return (this->begin() + pos);
 				}
 
-				// En este caso en el que capacity es igual a size hay que redimensionar, lo que crea un nuevo vector
-				// y hace que el iterador position ya no valga. Por eso, antes de redimensionar hay que calcular y
-				// guardar cuantas posiciones estaba desplazado position desde la posición inicial para luego poder
-				// replicar el desplazamiento en el nuevo vector.
+				// Si no cabe, se reserva otro bloque y se construyen en él, cada uno en su sitio definitivo, los
+				// elementos de delante, el nuevo y los de detrás. val sigue siendo válido aunque fuera uno de
+				// los elementos, porque el bloque antiguo no se libera hasta el final.
+
+				size_type	pos = position - this->begin();
 
-				if (this->_capacity == this->_size)
+				if (this->_size == this->_capacity)
 				{
-					std::ptrdiff_t pos = position - this->begin();
-					this->redimension(2 * this->_capacity);
-					position = this->begin() + pos;
+					size_type	n = this->next_capacity(this->_size + 1);
+					pointer		new_alloc = this->_alloc.allocate(n);
+
+					this->_alloc.construct(new_alloc + pos, val);
+					this->relocate_range(new_alloc, this->_array, pos);
+					this->relocate_range(new_alloc + pos + 1, this->_array + pos, this->_size - pos);
+					this->release_array();
+					this->_array = new_alloc;
+					this->_capacity = n;
+					this->_size++;
+					return (this->begin() + pos);
 				}
 
-				// Crea un nuevo vector temporal en el que se copia lo que hay desde position hasta el final. Luego
-				// se borran los elementos hasta position y se añade el nuevo elemento. Y finalmente se copian de
-				// vuelta los valores que se habían salvado en el vector temporal.
+				// Si cabe, se construye una copia del último elemento detrás de él y los demás, hasta pos, se
+				// desplazan una posición asignando cada uno sobre el siguiente, sin ningún vector temporal. Se
+				// copia val antes de empezar por si es uno de los que se desplazan.
 
-				vector tmp(position, this->end());
-				for (size_t i = 0; i < tmp.size(); i++)
-					this->pop_back();
-				this->push_back(val);
-				for (iterator it = tmp.begin(); it != tmp.end(); it++)
-					this->push_back(*it);
+				if (pos == this->_size)
+					this->_alloc.construct(this->_array + pos, val);
+				else
+				{
+					value_type	copy(val);
 
-				return (position);
+					this->_alloc.construct(this->_array + this->_size, this->_array[this->_size - 1]);
+					for (size_type i = this->_size - 1; i > pos; i--)
+						this->_array[i] = this->_array[i - 1];
+					this->_array[pos] = copy;
+				}
+				this->_size++;
+				return (this->begin() + pos);
 			}
 
-			// Si el número de elemento a añadir supera la capacidad actual, hay que redimensionar,
-			// lo que crea un nuevo vector y hace que el iterador position ya no valga. Por eso,
-			// antes de redimensionar hay que calcular y guardar cuantas posiciones estaba desplazado
-			// position desde la posición inicial para luego poder replicar el desplazamiento en el
-			// nuevo vector.
+			// Inserta n copias de val en position, desplazando una sola vez los elementos que van detrás, y
+			// reservando una sola vez si no caben.
 
 			void insert(iterator position, size_type n, const value_type& val)
 			{
+				size_type	pos = position - this->begin();
+
+				if (n == 0)
+					return ;
+
+				// Si no caben, se construyen en el bloque nuevo las n copias y después se pasan a él los
+				// elementos de delante y los de detrás, ya en su sitio. Las copias van primero porque val
+				// podría ser uno de los elementos, que siguen en el bloque antiguo hasta que se libera.
+
 				if (this->_size + n > this->_capacity)
 				{
-					std::ptrdiff_t pos = position - this->begin();
+					size_type	new_capacity = this->next_capacity(this->_size + n);
+					pointer		new_alloc = this->_alloc.allocate(new_capacity);
+
+					this->construct_fill(new_alloc + pos, n, val);
+					this->relocate_range(new_alloc, this->_array, pos);
+					this->relocate_range(new_alloc + pos + n, this->_array + pos, this->_size - pos);
+					this->release_array();
+					this->_array = new_alloc;
+					this->_capacity = new_capacity;
+					this->_size += n;
+					return ;
+				}
 
-					// Luego se comprueba si capacity es igual que size, porque la redimensión se hace de
-					// forma diferente que si no. En este caso amplia el array al número de posiciones
-					// que corresponda al resultado mayor entre la capacidad o el tamaño actual más el
-					// número de elementos a insertar.
+				// Si caben, se copia val antes de mover nada, por si es uno de los elementos que se desplazan
 
-					if (this->_capacity == this->_size)
-					{
-						this->redimension(std::max(2 * this->_capacity, this->_size + n));
-						position = this->begin() + pos;
-					}
+				value_type	copy(val);
+				size_type	after = this->_size - pos;
 
-					// En otro caso, hay que chequear si el size más el número de elementos a añadir es
-					// menor o igual que la capacity + 3. En este caso se redimensiona a capacidad + 2.
-					// Si no, se redimensiona a size más el número de elementos.
+				if (ft::is_trivially_relocatable<T>::value)
+				{
+					this->open_gap(pos, n);
+					this->construct_fill(this->_array + pos, n, copy);
+					return ;
+				}
 
-					else
-					{
-						if (this->_size + n <= this->_capacity + 2)
-							this->redimension(this->_capacity + 2);
-						else
-							this->redimension(this->_size + n);
-					}
-					position = this->begin() + pos;
+				// Los elementos que acaban detrás del final actual se construyen ahí, y los demás se
+				// desplazan asignando (de atrás hacia delante para no pisar ninguno antes de copiarlo).
+				// El hueco se rellena asignando sobre los que había y construyendo donde no había nada.
+
+				if (after > n)
+				{
+					this->construct_copy(this->_array + this->_size, this->_array + this->_size - n, n);
+					for (size_type i = this->_size - 1; i >= pos + n; i--)
+						this->_array[i] = this->_array[i - n];
+					for (size_type i = pos; i < pos + n; i++)
+						this->_array[i] = copy;
 				}
-				for (size_type i = 0; i < n; i++)
+				else
 				{
-					this->insert(position, val);
-					position++;
+					this->construct_fill(this->_array + this->_size, n - after, copy);
+					this->construct_copy(this->_array + pos + n, this->_array + pos, after);
+					for (size_type i = pos; i < this->_size; i++)
+						this->_array[i] = copy;
 				}
+				this->_size += n;
 			}
 
 			// Se le pasan la posición donde se van a insertar y dos iteradores (que pueden ser
@@ -405,22 +592,8 @@ namespace ft
 			void insert(iterator position, typename enable_if<!is_integral<InputIterator>::value,
 				InputIterator>::type first, InputIterator last)
 			{
-				std::ptrdiff_t count = last - first;
-				std::ptrdiff_t pos = position - this->begin();
-
-				while (this->_capacity < this->_size + count)
-					this->reserve(this->_capacity == 0 ? 1 : this->_capacity * 2);
-				for (std::ptrdiff_t i = this->_size; i > pos; i--)
-					this->_alloc.construct(_array + i - 1 + count, this->_array[i - 1]);
-				std::ptrdiff_t	former_size = this->_size;
-				this->_size += count;
-				while (count--)
-				{
-					last--;
-					if (pos + count < former_size)
-						this->_alloc.destroy(this->_array + pos + count);
-					this->_alloc.construct(this->_array + pos + count, *last);
-				}
+				this->range_insert(position - this->begin(), first, last,
+					typename ft::iterator_traits<InputIterator>::iterator_category());
 			}
 
 			iterator erase(iterator position)
@@ -428,30 +601,72 @@ namespace ft
 				if (this->empty() == true || position > this->end())
 					return (NULL);
 
-				vector tmp(position + 1, this->end());
+				if (ft::is_trivially_relocatable<T>::value)
+				{
+					size_type	pos = position - this->begin();
+
+					this->_alloc.destroy(this->_array + pos);
+					this->close_gap(pos, 1);
+					this->shrink_if_needed();
+					return (this->begin() + pos);
+				}
+
+				// Los elementos de detrás se desplazan una posición hacia delante asignando cada uno sobre el
+				// anterior, y se destruye el último, que ha quedado repetido
+
+				size_type	pos = position - this->begin();
 
-				for (size_t i = 0; i <= tmp.size(); i++)
-					this->pop_back();
-				for (iterator it = tmp.begin(); it != tmp.end(); it++)
-					this->push_back(*it);
-				return position;
+				for (size_type i = pos + 1; i < this->_size; i++)
+					this->_array[i - 1] = this->_array[i];
+				this->_alloc.destroy(this->_array + this->_size - 1);
+				this->_size--;
+				this->shrink_if_needed();
+				return (this->begin() + pos);
 			}
 
 			iterator erase(iterator first, iterator last)
 			{
 				if (this->empty() == true || last > this->end() || first > this->end())
 					return (NULL);
-				iterator tmp = first;
-				while (tmp != last)
+
+				// Los elementos de detrás se desplazan de una vez las count posiciones (con memmove si se
+				// pueden mover por bytes, o asignando cada uno sobre el que está count posiciones antes) y se
+				// destruyen los count últimos, que han quedado repetidos.
+
+				size_type	pos = first - this->begin();
+				size_type	count = last - first;
+
+				if (ft::is_trivially_relocatable<T>::value)
 				{
-					erase(first);
-					tmp++;
+					this->destroy_range(this->_array + pos, count);
+					this->close_gap(pos, count);
+					this->shrink_if_needed();
+					return (this->begin() + pos);
 				}
-				return (first);
+				for (size_type i = pos + count; i < this->_size; i++)
+					this->_array[i - count] = this->_array[i];
+				this->destroy_range(this->_array + this->_size - count, count);
+				this->_size -= count;
+				this->shrink_if_needed();
+				return (this->begin() + pos);
 			}
 
 			void swap(vector& x)
 			{
+				if (N > 0 && (!this->on_heap() || !x.on_heap()))	// Los elementos de dentro de cada objeto no se pueden cambiar de dueño
+				{
+					if (this->on_heap())
+						return (x.swap_with_heap(*this));
+					if (x.on_heap())
+						return (this->swap_with_heap(x));
+
+					vector	tmp(*this);
+
+					*this = x;
+					x = tmp;
+					return ;
+				}
+
 				allocator_type tmp_alloc = x._alloc;
 				size_type tmp_size = x._size;
 				size_type tmp_capacity = x._capacity;
@@ -469,9 +684,9 @@ namespace ft
 
 			void clear()
 			{
-				for (size_t i = 0; i < this->_size; i++)
-					this->_alloc.destroy(this->_array + i);
+				this->destroy_range(this->_array, this->_size);
 				this->_size = 0;
+				this->shrink_if_needed();
 			}
 
 		/////////////////////////     Allocator      /////////////////////////////////
@@ -484,65 +699,431 @@ namespace ft
 
 		private:
 
+			// Rangos (constructor, assign() e insert()), según el tipo de iterador. Con los de tipo forward o
+			// mejores (los de map son bidireccionales, los de vector de acceso aleatorio) se puede recorrer el
+			// rango dos veces, así que primero se cuentan los elementos (con una resta si son de acceso
+			// aleatorio, ver ft::distance()), se reserva una sola vez lo justo y se construyen todos seguidos.
+			// Con los de tipo input (como los de un istream) solo se puede leer cada elemento una vez, así que
+			// se añaden uno a uno y el vector va creciendo por el camino.
+
+			template <class InputIterator>
+			void range_init(InputIterator first, InputIterator last, std::input_iterator_tag)
+			{
+				for (; first != last; ++first)
+					this->push_back(*first);
+			}
+
+			template <class ForwardIterator>
+			void range_init(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+			{
+				size_type	n = ft::distance(first, last);
+
+				if (n > this->_capacity)
+				{
+					this->_array = this->_alloc.allocate(n);
+					this->_capacity = n;
+				}
+				this->construct_range(this->_array, first, last);
+				this->_size = n;
+			}
+
+			template <class InputIterator>
+			void range_assign(InputIterator first, InputIterator last, std::input_iterator_tag)
+			{
+				this->clear();
+				for (; first != last; ++first)
+					this->push_back(*first);
+			}
+
+			// Si caben, se asigna sobre los elementos que ya hay y se construyen o destruyen solo los que
+			// sobran o faltan, sin reservar nada
+
+			template <class ForwardIterator>
+			void range_assign(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+			{
+				size_type	n = ft::distance(first, last);
+				size_type	i = 0;
+
+				if (n > this->_capacity)
+				{
+					pointer	new_alloc = this->_alloc.allocate(n);
+
+					this->construct_range(new_alloc, first, last);
+					this->destroy_range(this->_array, this->_size);
+					this->release_array();
+					this->_array = new_alloc;
+					this->_capacity = n;
+					this->_size = n;
+					return ;
+				}
+				for (; i < this->_size && first != last; ++i, ++first)
+					this->_array[i] = *first;
+				if (i < this->_size)
+					this->destroy_range(this->_array + i, this->_size - i);
+				else
+					this->construct_range(this->_array + i, first, last);
+				this->_size = n;
+			}
+
+			// Los elementos de un rango de tipo input se leen primero en un vector aparte, y después se
+			// insertan desde él como cualquier otro rango, para desplazar los de detrás una sola vez (al
+			// final no hay nada que desplazar y se añaden directamente).
+
+			template <class InputIterator>
+			void range_insert(size_type pos, InputIterator first, InputIterator last, std::input_iterator_tag)
+			{
+				vector	tmp;
+
+				if (pos == this->_size)
+				{
+					for (; first != last; ++first)
+						this->push_back(*first);
+					return ;
+				}
+				for (; first != last; ++first)
+					tmp.push_back(*first);
+				this->range_insert(pos, tmp.begin(), tmp.end(), std::forward_iterator_tag());
+			}
+
+			// Igual que el insert() de n copias de un valor, pero con los elementos del rango. Si el rango es
+			// del propio vector, abrir el hueco (o pasar los elementos a otro bloque y liberar este) cambiaría
+			// de sitio los elementos antes de copiarlos, así que primero se copian a un vector aparte.
+
+			template <class ForwardIterator>
+			void range_insert(size_type pos, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+			{
+				if (this->range_in_self(first, last))
+				{
+					vector	tmp(first, last);
+
+					return (this->range_insert(pos, tmp.begin(), tmp.end(), std::forward_iterator_tag()));
+				}
+
+				size_type	count = ft::distance(first, last);
+				size_type	after = this->_size - pos;
+
+				if (count == 0)
+					return ;
+				if (this->_size + count > this->_capacity)
+				{
+					size_type	new_capacity = this->next_capacity(this->_size + count);
+					pointer		new_alloc = this->_alloc.allocate(new_capacity);
+
+					this->construct_range(new_alloc + pos, first, last);
+					this->relocate_range(new_alloc, this->_array, pos);
+					this->relocate_range(new_alloc + pos + count, this->_array + pos, after);
+					this->release_array();
+					this->_array = new_alloc;
+					this->_capacity = new_capacity;
+					this->_size += count;
+					return ;
+				}
+				if (ft::is_trivially_relocatable<T>::value)
+				{
+					this->open_gap(pos, count);
+					this->construct_range(this->_array + pos, first, last);
+					return ;
+				}
+				if (after > count)
+				{
+					this->construct_copy(this->_array + this->_size, this->_array + this->_size - count, count);
+					for (size_type i = this->_size - 1; i >= pos + count; i--)
+						this->_array[i] = this->_array[i - count];
+					for (size_type i = pos; i < pos + count; ++i, ++first)
+						this->_array[i] = *first;
+				}
+				else
+				{
+					ForwardIterator	mid = first;
+
+					for (size_type i = 0; i < after; i++)
+						++mid;
+					this->construct_range(this->_array + this->_size, mid, last);
+					this->construct_copy(this->_array + pos + count, this->_array + pos, after);
+					for (size_type i = pos; i < this->_size; ++i, ++first)
+						this->_array[i] = *first;
+				}
+				this->_size += count;
+			}
+
+			// Si un rango es de elementos del propio vector. Solo puede serlo con sus propios iteradores o
+			// punteros; con cualquier otro tipo de iterador es que no.
+
+			template <class InputIterator>
+			bool range_in_self(InputIterator, InputIterator) const
+			{
+				return (false);
+			}
+
+			bool range_in_self(const_pointer first, const_pointer last) const
+			{
+				return (first != last && first >= this->_array && first < this->_array + this->_size);
+			}
+
+			bool range_in_self(pointer first, pointer last) const
+			{
+				return (this->range_in_self(const_pointer(first), const_pointer(last)));
+			}
+
+			bool range_in_self(const_iterator first, const_iterator last) const
+			{
+				return (first != last && this->range_in_self(&*first, &*first + 1));
+			}
+
+			bool range_in_self(iterator first, iterator last) const
+			{
+				return (this->range_in_self(const_iterator(first), const_iterator(last)));
+			}
+
+			template <class InputIterator>
+			void construct_range(pointer dest, InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first, ++dest)
+					this->_alloc.construct(dest, *first);
+			}
+
 			void redimension(size_type n)
 			{
-				pointer new_alloc = this->_alloc.allocate(n);
-				for (size_type i = 0; i < this->_size; i++)
+				// Si el allocator puede cambiar el tamaño del bloque (ver realloc_allocator.hpp) y los elementos
+				// se pueden mover por bytes, no hace falta reservar otro y copiar: el allocator lo amplía donde
+				// está si puede, y si no lo mueve él.
+
+				if (ft::allocator_reallocate<Alloc>::value && ft::is_trivially_relocatable<T>::value
+					&& this->on_heap())
 				{
-					this->_alloc.construct(new_alloc + i, this->_array[i]);
-					this->_alloc.destroy(this->_array + i);
+					this->_array = ft::allocator_reallocate<Alloc>::reallocate(this->_alloc, this->_array,
+						this->_capacity, n);
+					this->_capacity = n;
+					return ;
 				}
-				if (this->_capacity != 0)
-					this->_alloc.deallocate(this->_array, this->_capacity);
+
+				pointer new_alloc = this->_alloc.allocate(n);
+
+				this->relocate_range(new_alloc, this->_array, this->_size);
+				this->release_array();
 				this->_array = new_alloc;
 				this->_capacity = n;
 			}
+
+			// Si los elementos están en un bloque del allocator (y no en el propio objeto ni en ninguno)
+
+			bool on_heap(void) const
+			{
+				return (this->_capacity != 0 && !this->_inline_contains(this->_array));
+			}
+
+			void release_array(void)
+			{
+				if (this->on_heap())
+					this->_alloc.deallocate(this->_array, this->_capacity);
+			}
+
+			// Pasa los elementos a un bloque de n (que no es menor que size()), o a los N de dentro del objeto
+			// si caben. Con n = 0 y N = 0 solo libera el bloque.
+
+			void shrink_to(size_type n)
+			{
+				if (n > N)
+					return (this->redimension(n));
+				if (this->on_heap())
+				{
+					pointer	inline_array = this->_inline_buffer();
+
+					if (N > 0)										// Con N = 0 el vector está vacío y no hay nada que mover
+						this->relocate_range(inline_array, this->_array, this->_size);
+					this->release_array();
+					this->_array = inline_array;
+					this->_capacity = N;
+				}
+			}
+
+			// swap() de este vector, con los elementos dentro, y x, con un bloque: el bloque pasa a este y los
+			// elementos de este se mudan dentro de x, así que solo se copian los de dentro.
+
+			void swap_with_heap(vector& x)
+			{
+				allocator_type	tmp_alloc = x._alloc;
+				size_type		tmp_size = x._size;
+				size_type		tmp_capacity = x._capacity;
+				pointer			tmp_array = x._array;
+
+				x._array = x._inline_buffer();
+				x._capacity = N;
+				this->relocate_range(x._array, this->_array, this->_size);
+				x._size = this->_size;
+				x._alloc = this->_alloc;
+				this->_alloc = tmp_alloc;
+				this->_size = tmp_size;
+				this->_capacity = tmp_capacity;
+				this->_array = tmp_array;
+			}
+
+			// Después de quitar elementos, reduce la capacidad si lo pide la política Growth (ver
+			// growth_shrink en vector_growth.hpp). Con las políticas que no reducen no hace nada.
+
+			void shrink_if_needed(void)
+			{
+				if (ft::growth_shrink<Growth>::value)
+				{
+					size_type	n = ft::growth_shrink<Growth>::shrink_capacity(this->_capacity, this->_size, sizeof(T));
+
+					if (n < this->_capacity)
+						this->shrink_to(n);
+				}
+			}
+
+			// Capacidad que hay que reservar para que quepan needed elementos, según la política Growth
+
+			size_type next_capacity(size_type needed) const
+			{
+				return (Growth::next_capacity(this->_capacity, needed, sizeof(T)));
+			}
+
+			// Construye en dest (memoria sin construir que no se solapa con src) copias de los n elementos
+			// que empiezan en src. Si T se puede copiar byte a byte es un solo memcpy, que copia bloques
+			// enteros en lugar de un elemento cada vez.
+
+			void construct_copy(pointer dest, const_pointer src, size_type n)
+			{
+				if (ft::is_trivially_copyable<T>::value)
+				{
+					if (n != 0)
+						std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+				}
+				else
+					for (size_type i = 0; i < n; i++)
+						this->_alloc.construct(dest + i, src[i]);
+			}
+
+			// Asigna los n elementos de src sobre los n (ya construidos) de dest, con un memcpy si T se puede
+			// copiar byte a byte
+
+			void assign_copy(pointer dest, const_pointer src, size_type n)
+			{
+				if (ft::is_trivially_copyable<T>::value)
+				{
+					if (n != 0)
+						std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+				}
+				else
+					for (size_type i = 0; i < n; i++)
+						dest[i] = src[i];
+			}
+
+			void construct_fill(pointer dest, size_type n, const value_type& val)
+			{
+				for (size_type i = 0; i < n; i++)
+					this->_alloc.construct(dest + i, val);
+			}
+
+			void construct_default(pointer dest, size_type n)
+			{
+				if (!ft::is_trivially_default_constructible<T>::value)
+					this->construct_fill(dest, n, value_type());
+			}
+
+			// Pasa los n elementos de src a dest (memoria sin construir de otro bloque). Los tipos que se
+			// pueden mover por bytes se pasan con un memcpy y el original no se destruye; el resto se copia
+			// y después se destruye el original, elemento a elemento.
+
+			void relocate_range(pointer dest, pointer src, size_type n)
+			{
+				if (ft::is_trivially_relocatable<T>::value)
+				{
+					if (n != 0)
+						std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+				}
+				else
+				{
+					this->construct_copy(dest, src, n);
+					this->destroy_range(src, n);
+				}
+			}
+
+			void destroy_range(pointer first, size_type n)
+			{
+				if (!ft::is_trivially_destructible<T>::value)
+					for (size_type i = 0; i < n; i++)
+						this->_alloc.destroy(first + i);
+			}
+
+			// Solo para tipos que se pueden mover por bytes. open_gap() deja n posiciones sin construir a
+			// partir de pos, moviendo detrás los elementos que había desde ahí (y reservando antes si no
+			// caben), y close_gap() cierra las n posiciones desde pos, cuyos elementos ya se han destruido,
+			// moviendo hacia delante los que van detrás.
+
+			void open_gap(size_type pos, size_type n)
+			{
+				if (this->_size + n > this->_capacity)
+					this->redimension(this->next_capacity(this->_size + n));
+				if (this->_size > pos)
+					std::memmove(static_cast<void*>(this->_array + pos + n),
+						static_cast<const void*>(this->_array + pos), (this->_size - pos) * sizeof(T));
+				this->_size += n;
+			}
+
+			void close_gap(size_type pos, size_type n)
+			{
+				if (this->_size > pos + n)
+					std::memmove(static_cast<void*>(this->_array + pos),
+						static_cast<const void*>(this->_array + pos + n), (this->_size - pos - n) * sizeof(T));
+				this->_size -= n;
+			}
 	};
 
 
 	///////////////////////     Non-member function overloads      ////////////////////////
 
-	template <class T, class Alloc>
-	bool operator== (const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+	template <class T, class Alloc, class Growth, size_t N>
+	bool operator== (const vector<T,Alloc,Growth,N>& lhs, const vector<T,Alloc,Growth,N>& rhs)
 	{
 		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 	}
 
-	template <class T, class Alloc>
-	bool operator!= (const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+	template <class T, class Alloc, class Growth, size_t N>
+	bool operator!= (const vector<T,Alloc,Growth,N>& lhs, const vector<T,Alloc,Growth,N>& rhs)
 	{
 		return !(lhs == rhs);
 	}
 
-	template <class T, class Alloc>
-	bool operator< (const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+	template <class T, class Alloc, class Growth, size_t N>
+	bool operator< (const vector<T,Alloc,Growth,N>& lhs, const vector<T,Alloc,Growth,N>& rhs)
 	{
 		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 	}
 
-	template <class T, class Alloc>
-	bool operator<= (const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+	template <class T, class Alloc, class Growth, size_t N>
+	bool operator<= (const vector<T,Alloc,Growth,N>& lhs, const vector<T,Alloc,Growth,N>& rhs)
 	{
 		return !(rhs < lhs);
 	}
 
-	template <class T, class Alloc>
-	bool operator> (const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+	template <class T, class Alloc, class Growth, size_t N>
+	bool operator> (const vector<T,Alloc,Growth,N>& lhs, const vector<T,Alloc,Growth,N>& rhs)
 	{
 		return (rhs < lhs);
 	}
 
-	template <class T, class Alloc>
-	bool operator>= (const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs)
+	template <class T, class Alloc, class Growth, size_t N>
+	bool operator>= (const vector<T,Alloc,Growth,N>& lhs, const vector<T,Alloc,Growth,N>& rhs)
 	{
 		return !(lhs < rhs);
 	}
 
-	template <class T, class Alloc>
-	void swap (vector<T,Alloc>& x, vector<T,Alloc>& y)
+	template <class T, class Alloc, class Growth, size_t N>
+	void swap (vector<T,Alloc,Growth,N>& x, vector<T,Alloc,Growth,N>& y)
 	{
 		x.swap(y);
 	}
+
+	// Un vector solo guarda un puntero a sus elementos, que no cambian de sitio si se mueve el vector, así que
+	// un vector de vectores crece sin copiar los de dentro (con std::allocator, que no guarda nada).
+
+	template <class T, class Growth>
+	struct is_trivially_relocatable<ft::vector<T, std::allocator<T>, Growth, 0> >
+	{
+		static const bool value = true;
+	};
 }
 
 #endif
@@ -0,0 +1,124 @@
+#ifndef VECTOR_GROWTH_HPP
+# define VECTOR_GROWTH_HPP
+
+# include <cstddef>
+
+// Políticas de crecimiento: el último parámetro de vector, que decide cuánta capacidad reserva cuando un
+// push_back() o un insert() no caben. next_capacity() recibe la capacidad actual, los elementos que tienen
+// que caber como mínimo y el tamaño de cada uno, y devuelve la nueva capacidad (que nunca es menor que
+// needed).
+//  - double_growth_policy (por defecto): el doble, empezando por 1, igual que std::vector. Cada elemento
+//    se ha movido de media una vez al acabar, pero las primeras reservas son diminutas y muy seguidas.
+//  - half_growth_policy: la mitad más. Se desperdicia menos capacidad, a cambio de más reservas, y como
+//    1.5 es menor que la proporción áurea, la suma de los bloques que se han liberado llega a ser mayor que
+//    el siguiente, así que malloc puede reutilizar ese espacio para él.
+//  - page_growth_policy: el doble, pero redondeado hacia arriba para que el bloque ocupe páginas enteras
+//    de 4 KiB. Con bloques grandes malloc reserva páginas enteras de todas formas, y así el vector puede
+//    usarlas; además es lo que mejor le va a realloc() (ver realloc_allocator.hpp), que puede ampliar un
+//    bloque así sin copiarlo.
+//  - min_capacity_growth_policy<Min, Base>: como Base, pero la primera reserva es de Min elementos como
+//    mínimo, para no pasar por 1, 2, 4, 8... con vectores que casi siempre van a tener unos cuantos.
+//  - shrinking_growth_policy<Num, Den, Base>: crece como Base, pero además devuelve memoria. Con las demás
+//    la capacidad nunca baja sola (pop_back(), erase(), clear() y resize() a menos la mantienen, y solo
+//    shrink_to_fit() la reduce), así que un vector que llegó a tener muchos elementos se queda con todo
+//    ese bloque. Con esta, cuando después de quitar elementos quedan menos de Num / Den de la capacidad,
+//    el vector se pasa a un bloque con el doble de los que quedan. Num / Den tiene que ser menor que 1/2
+//    (por defecto 1/4): justo después de reducir, el vector está a la mitad, y hasta la siguiente
+//    reserva tiene que llenarse del todo o bajar otra vez de Num / Den, así que un vector que sube y
+//    baja alrededor de cualquiera de los dos límites no reserva en cada paso, y cada reserva se paga con
+//    tantas operaciones como elementos mueve. Nunca baja de la primera reserva de Base (la que haría con
+//    el vector vacío), ni libera el bloque al quedarse vacío: un vector que se vacía y se vuelve a llenar
+//    (una cola de trabajo, un buffer por petición) reservaría cada vez. Para liberarlo, shrink_to_fit().
+// growth_shrink<Growth> dice si una política reduce la capacidad: vector lo consulta después de quitar
+// elementos, y si value es true llama a growth_shrink<Growth>::shrink_capacity(), que devuelve la
+// capacidad nueva (o la actual si no hay que reducir). Se puede especializar para otras políticas.
+
+namespace ft
+{
+	struct double_growth_policy
+	{
+		static size_t next_capacity(size_t capacity, size_t needed, size_t)
+		{
+			return (needed > 2 * capacity ? needed : 2 * capacity);
+		}
+	};
+
+	struct half_growth_policy
+	{
+		static size_t next_capacity(size_t capacity, size_t needed, size_t)
+		{
+			size_t	grown = capacity + capacity / 2;
+
+			return (needed > grown ? needed : grown);
+		}
+	};
+
+	struct page_growth_policy
+	{
+		static const size_t	page_size = 4096;
+
+		static size_t next_capacity(size_t capacity, size_t needed, size_t elem_size)
+		{
+			size_t	n = ft::double_growth_policy::next_capacity(capacity, needed, elem_size);
+			size_t	bytes = (n * elem_size + page_size - 1) & ~(page_size - 1);
+
+			return (bytes / elem_size);
+		}
+	};
+
+	template <size_t Min, class Base = ft::double_growth_policy>
+	struct min_capacity_growth_policy
+	{
+		static size_t next_capacity(size_t capacity, size_t needed, size_t elem_size)
+		{
+			size_t	n = Base::next_capacity(capacity, needed, elem_size);
+
+			return (capacity == 0 && n < Min ? Min : n);
+		}
+	};
+
+	template <size_t Num = 1, size_t Den = 4, class Base = ft::double_growth_policy>
+	struct shrinking_growth_policy
+	{
+		typedef char	fraction_must_be_below_half[2 * Num < Den ? 1 : -1];
+
+		static size_t next_capacity(size_t capacity, size_t needed, size_t elem_size)
+		{
+			return (Base::next_capacity(capacity, needed, elem_size));
+		}
+
+		static size_t shrink_capacity(size_t capacity, size_t size, size_t elem_size)
+		{
+			size_t	min = Base::next_capacity(0, 1, elem_size);
+			size_t	n = 2 * size > min ? 2 * size : min;
+
+			if (size == 0 || size * Den >= capacity * Num || n >= capacity)
+				return (capacity);
+			return (n);
+		}
+	};
+
+	template <class Growth>
+	struct growth_shrink
+	{
+		static const bool	value = false;
+
+		static size_t shrink_capacity(size_t capacity, size_t, size_t)
+		{
+			return (capacity);
+		}
+	};
+
+	template <size_t Num, size_t Den, class Base>
+	struct growth_shrink<ft::shrinking_growth_policy<Num, Den, Base> >
+	{
+		static const bool	value = true;
+
+		static size_t shrink_capacity(size_t capacity, size_t size, size_t elem_size)
+		{
+			return (ft::shrinking_growth_policy<Num, Den, Base>::shrink_capacity(capacity, size, elem_size));
+		}
+	};
+}
+
+#endif
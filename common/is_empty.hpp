@@ -0,0 +1,52 @@
+#ifndef IS_EMPTY_HPP
+# define IS_EMPTY_HPP
+
+// is_class<T>::value es true si T es una clase (o un struct o una unión). Solo las clases tienen punteros a
+// miembro, así que la primera versión de test() solo se puede elegir si T es una clase; si no, se elige la
+// segunda, que devuelve un tipo de otro tamaño.
+// is_empty<T>::value es true si T es una clase sin ningún dato (como std::less o std::allocator). Se
+// comprueba heredando de T: si T está vacía, una clase que hereda de T y añade un int ocupa lo mismo que
+// un int solo.
+
+namespace ft
+{
+	template <class T>
+	struct is_class
+	{
+		private:
+			template <class C>
+			static char test(int C::*);
+
+			template <class C>
+			static long test(...);
+
+		public:
+			static const bool value = (sizeof(test<T>(0)) == sizeof(char));
+	};
+
+	template <class T, bool = ft::is_class<T>::value>
+	struct is_empty
+	{
+		static const bool value = false;
+	};
+
+	template <class T>
+	struct is_empty<T, true>
+	{
+		private:
+			struct with_base : T
+			{
+				int	x;
+			};
+
+			struct without_base
+			{
+				int	x;
+			};
+
+		public:
+			static const bool value = (sizeof(with_base) == sizeof(without_base));
+	};
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef IS_TRIVIALLY_COPYABLE_HPP
+# define IS_TRIVIALLY_COPYABLE_HPP
+
+# include "is_integral.hpp"
+
+// is_trivially_copyable<T>::value es true si copiar un T es lo mismo que copiar sus bytes: ni T ni ninguno
+// de sus miembros tiene constructor de copia, operator= o destructor propios (números, punteros, y structs
+// que solo contienen eso). Con esos tipos vector copia y mueve los elementos con memcpy y memmove en lugar
+// de construirlos uno a uno.
+// C++98 no tiene forma de saberlo, pero gcc y clang lo calculan con __is_trivially_copyable. Con otros
+// compiladores solo se da por bueno para los enteros y los punteros, que seguro que lo son.
+// is_trivially_destructible<T>::value es true si el destructor de T no hace nada, y entonces no hace falta
+// recorrer los elementos para destruirlos.
+// is_trivially_default_constructible<T>::value es true si construir un T sin valor (T x;) no hace nada y lo
+// deja con lo que hubiera en la memoria, como con un int. Con esos tipos vector::resize_default_init() no
+// escribe nada en los elementos nuevos.
+
+namespace ft
+{
+# if defined(__GNUC__) || defined(__clang__)
+
+	template <class T>
+	struct is_trivially_copyable
+	{
+		static const bool value = __is_trivially_copyable(T);
+	};
+
+	template <class T>
+	struct is_trivially_destructible
+	{
+#  if defined(__clang__)
+		static const bool value = __is_trivially_destructible(T);
+#  else
+		static const bool value = __has_trivial_destructor(T);
+#  endif
+	};
+
+	template <class T>
+	struct is_trivially_default_constructible
+	{
+		static const bool value = __is_trivially_constructible(T);
+	};
+
+# else
+
+	template <class T>
+	struct is_trivially_copyable
+	{
+		static const bool value = ft::is_integral<T>::value;
+	};
+
+	template <class T>
+	struct is_trivially_copyable<T*>
+	{
+		static const bool value = true;
+	};
+
+	template <class T>
+	struct is_trivially_destructible : ft::is_trivially_copyable<T>
+	{};
+
+	template <class T>
+	struct is_trivially_default_constructible : ft::is_trivially_copyable<T>
+	{};
+
+# endif
+}
+
+#endif
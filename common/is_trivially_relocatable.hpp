@@ -0,0 +1,34 @@
+#ifndef IS_TRIVIALLY_RELOCATABLE_HPP
+# define IS_TRIVIALLY_RELOCATABLE_HPP
+
+# include "is_trivially_copyable.hpp"
+
+// is_trivially_relocatable<T>::value es true si un T se puede cambiar de sitio copiando sus bytes y
+// olvidándose del original sin llamar a su destructor. Es lo que hace vector al crecer y al abrir o cerrar
+// un hueco con insert() y erase(): con estos tipos mueve los elementos con memcpy y memmove en lugar de
+// construir una copia de cada uno y destruir el original.
+// Todos los tipos que se pueden copiar byte a byte se pueden mover así, pero hay muchos más: cualquier clase
+// que solo guarda punteros a memoria suya fuera del objeto (un vector, un puntero con dueño, un handle a un
+// recurso), aunque tenga constructor de copia y destructor propios. Para esas el compilador no lo puede
+// saber y hay que decírselo especializando la plantilla:
+//
+//     namespace ft
+//     {
+//         template <>
+//         struct is_trivially_relocatable<my_handle> { static const bool value = true; };
+//     }
+//
+// No vale para las clases que guardan punteros a sí mismas o que se registran en otro sitio por su
+// dirección. Por ejemplo std::string de libstdc++ apunta a su propio buffer interno cuando la cadena es
+// corta, así que aquí no se marca.
+
+namespace ft
+{
+	template <class T>
+	struct is_trivially_relocatable
+	{
+		static const bool value = ft::is_trivially_copyable<T>::value;
+	};
+}
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef ITERATOR_TRAITS
 # define ITERATOR_TRAITS
 
+# include <cstddef>
+# include <iterator>
+
 namespace ft
 {
 	template<class Category, class T, class Distance = std::ptrdiff_t, class Pointer = T*, class Reference = T&>
@@ -42,6 +45,34 @@ namespace ft
 		typedef std::ptrdiff_t					difference_type;
 		typedef std::random_access_iterator_tag	iterator_category;
 	};
+
+	// Número de elementos entre first y last. Con iteradores de acceso aleatorio es una resta; con los
+	// demás hay que recorrer el rango (y con los de tipo input, como los de un istream, eso lo consume, así
+	// que no se pueden volver a leer).
+
+	template <class InputIterator>
+	typename ft::iterator_traits<InputIterator>::difference_type
+		distance_by_tag(InputIterator first, InputIterator last, std::input_iterator_tag)
+	{
+		typename ft::iterator_traits<InputIterator>::difference_type	n = 0;
+
+		for (; first != last; ++first)
+			n++;
+		return (n);
+	}
+
+	template <class RandomAccessIterator>
+	typename ft::iterator_traits<RandomAccessIterator>::difference_type
+		distance_by_tag(RandomAccessIterator first, RandomAccessIterator last, std::random_access_iterator_tag)
+	{
+		return (last - first);
+	}
+
+	template <class InputIterator>
+	typename ft::iterator_traits<InputIterator>::difference_type distance(InputIterator first, InputIterator last)
+	{
+		return (ft::distance_by_tag(first, last, typename ft::iterator_traits<InputIterator>::iterator_category()));
+	}
 }
 
 #endif
@@ -0,0 +1,2062 @@
+#include "Vector/vector.hpp"
+#include "Vector/small_vector.hpp"
+#include "Stack/stack.hpp"
+#include "Map/map.hpp"
+#include "Map/eytzinger_index.hpp"
+#include "Map/map_snapshot.hpp"
+#include "Map/map_parallel.hpp"
+#include "Map/map_algebra.hpp"
+#include "Map/radix_map.hpp"
+#include "Map/multimap.hpp"
+#include "Set/set.hpp"
+#include "Set/multiset.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+// Benchmarks de las optimizaciones que no existen en la stl, así que solo se compilan con ft (a diferencia
+// de main.cpp y ft_main.cpp, que se comparan contra std). Cada benchmark también comprueba que el
+// resultado coincide con el de la versión sin optimizar, y si no es así termina con error.
+// Uso: ./ft_containers_bench [nombre] [n]. Sin argumentos ejecuta todos con su tamaño por defecto.
+
+static double	now_ms(void)
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+	return (tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0);
+}
+
+static void	report(const char* what, double ms, size_t ops)
+{
+	std::cout << "  " << std::left << std::setw(48) << what << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << ms << " ms";
+	if (ops)
+		std::cout << std::setw(10) << std::setprecision(1) << (ms * 1000000.0 / ops) << " ns/op";
+	std::cout << std::endl;
+}
+
+static void	check(bool ok, const char* what)
+{
+	if (!ok)
+	{
+		std::cerr << "Error: " << what << std::endl;
+		exit(1);
+	}
+}
+
+
+// Allocator que cuenta los bytes que hay reservados en cada momento, para medir cuánta memoria usa de
+// verdad un contenedor (incluidos los nodos y su relleno), y cuántas veces se ha llamado a allocate().
+
+static size_t	g_live_bytes = 0;
+static size_t	g_alloc_calls = 0;
+
+template <class T>
+struct counting_allocator
+{
+	typedef T			value_type;
+	typedef T*			pointer;
+	typedef const T*	const_pointer;
+	typedef T&			reference;
+	typedef const T&	const_reference;
+	typedef size_t		size_type;
+	typedef ptrdiff_t	difference_type;
+
+	template <class U>
+	struct rebind
+	{
+		typedef counting_allocator<U>	other;
+	};
+
+	counting_allocator(void) {}
+	template <class U>
+	counting_allocator(const counting_allocator<U>&) {}
+
+	pointer allocate(size_type n, const void* = 0)
+	{
+		g_live_bytes += n * sizeof(T);
+		++g_alloc_calls;
+		return (static_cast<pointer>(::operator new(n * sizeof(T))));
+	}
+
+	void deallocate(pointer p, size_type n)
+	{
+		g_live_bytes -= n * sizeof(T);
+		::operator delete(p);
+	}
+
+	void construct(pointer p, const T& val)
+	{
+		new (p) T(val);
+	}
+
+	void destroy(pointer p)
+	{
+		p->~T();
+	}
+
+	size_type max_size(void) const
+	{
+		return (size_t(-1) / sizeof(T));
+	}
+
+	bool operator== (const counting_allocator&) const { return (true); }
+	bool operator!= (const counting_allocator&) const { return (false); }
+};
+
+
+/////////////////////////////     eytzinger_index      /////////////////////////////
+
+// Compara map::lower_bound() con el índice Eytzinger, una clave cada vez y de 8 en 8 (con AVX2 si se ha
+// compilado con soporte), sobre n claves aleatorias y un millón de búsquedas.
+
+static void	bench_eytzinger(size_t n)
+{
+	const size_t			queries = 1000000;
+	ft::map<int, int>		table;
+	ft::vector<int>			probe(queries);
+	ft::vector<size_t>		ranks(queries);
+	double					t;
+
+	while (table.size() < n)
+		table.insert(ft::make_pair(rand(), 0));
+	for (size_t i = 0; i < queries; i++)
+		probe[i] = rand();
+
+	t = now_ms();
+	ft::eytzinger_index<int>	index(table);
+	report("build from map", now_ms() - t, n);
+
+	long	sum_map = 0;
+	t = now_ms();
+	for (size_t i = 0; i < queries; i++)
+	{
+		ft::map<int, int>::iterator	it = table.lower_bound(probe[i]);
+		sum_map += (it == table.end() ? -1 : it->first);
+	}
+	report("map::lower_bound", now_ms() - t, queries);
+
+	long	sum_idx = 0;
+	t = now_ms();
+	for (size_t i = 0; i < queries; i++)
+	{
+		size_t	r = index.lower_bound(probe[i]);
+		sum_idx += (r == index.size() ? -1 : static_cast<long>(r));
+	}
+	report("eytzinger_index::lower_bound", now_ms() - t, queries);
+
+	t = now_ms();
+	index.lower_bound(&probe[0], &probe[0] + queries, &ranks[0]);
+	report("eytzinger_index::lower_bound (batch)", now_ms() - t, queries);
+
+	long	sum_rank = 0;
+	long	sum_batch = 0;
+	for (size_t i = 0; i < queries; i++)
+	{
+		size_t	r = index.lower_bound(probe[i]);
+		sum_rank += (r == index.size() ? -1 : index.key(r));
+		sum_batch += (ranks[i] == index.size() ? -1 : static_cast<long>(ranks[i]));
+	}
+	check(sum_rank == sum_map, "eytzinger_index::lower_bound differs from map::lower_bound");
+	check(sum_batch == sum_idx, "batch lower_bound differs from single lower_bound");
+}
+
+
+///////////////////////////////     map_snapshot      //////////////////////////////
+
+// Tiempo de arranque: reconstruir un mapa de n elementos leyendo un fichero de texto (un insert por
+// línea) frente a cargar el snapshot binario en un mapa, o abrir el snapshot y buscar directamente en él.
+
+static void	bench_snapshot(size_t n)
+{
+	const char*			text_path = "/tmp/ft_bench_map.txt";
+	const char*			bin_path = "/tmp/ft_bench_map.bin";
+	ft::map<int, int>	src;
+	double				t;
+
+	{
+		std::ofstream	out(text_path);								// En el orden de llegada, no ordenado
+		while (src.size() < n)
+		{
+			ft::pair<int, int>	p(rand(), rand());
+			if (src.insert(p).second)
+				out << p.first << ' ' << p.second << '\n';
+		}
+	}
+	t = now_ms();
+	ft::save_map(src, bin_path);
+	report("save_map", now_ms() - t, n);
+
+	{
+		t = now_ms();
+		std::ifstream		in(text_path);
+		ft::map<int, int>	m;
+		int					k, v;
+		while (in >> k >> v)
+			m.insert(ft::make_pair(k, v));
+		report("text parse + insert", now_ms() - t, n);
+		check(m == src, "text load differs");
+	}
+	{
+		t = now_ms();
+		ft::map<int, int>	m;
+		ft::load_map(m, bin_path);
+		report("load_map (mmap + assign_sorted)", now_ms() - t, n);
+		check(m == src, "load_map differs");
+	}
+	{
+		t = now_ms();
+		ft::map_snapshot<int, int>	snap(bin_path);
+		long						sum = 0;
+		report("map_snapshot open", now_ms() - t, 0);
+		t = now_ms();
+		for (ft::map<int, int>::iterator it = src.begin(); it != src.end(); ++it)
+			sum += snap.find(it->first)->second - it->second;
+		report("map_snapshot::find (every key)", now_ms() - t, n);
+		check(sum == 0 && snap.size() == src.size(), "map_snapshot differs");
+	}
+	remove(text_path);
+	remove(bin_path);
+}
+
+
+////////////////////////////////     set memory      ///////////////////////////////
+
+// Memoria por elemento de un set frente a emularlo con un map<Key, char>, y tiempo de inserción de
+// cada uno. Para claves std::string solo cuenta los nodos: las cadenas son cortas y caben en el propio
+// objeto string, así que no reservan nada más.
+
+template <class Container>
+static void	measure_memory(const char* what, Container& c, const ft::vector<typename Container::key_type>& keys)
+{
+	size_t	before = g_live_bytes;
+	double	t = now_ms();
+
+	for (size_t i = 0; i < keys.size(); i++)
+		c.insert(typename Container::value_type(keys[i]));
+	t = now_ms() - t;
+	std::cout << "  " << std::left << std::setw(48) << what << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << static_cast<double>(g_live_bytes - before) / c.size() << " B/elem"
+		<< std::setw(10) << (t * 1000000.0 / keys.size()) << " ns/op" << std::endl;
+}
+
+static void	bench_set_memory(size_t n)
+{
+	ft::vector<int>			ikeys;
+	ft::vector<std::string>	skeys;
+	char					buf[16];
+
+	for (size_t i = 0; i < n; i++)
+	{
+		ikeys.push_back(rand());
+		snprintf(buf, sizeof(buf), "k%08d", rand() % 100000000);
+		skeys.push_back(buf);
+	}
+	{
+		typedef ft::node<ft::pair<const int, char> >	node_t;
+		ft::map<int, char, std::less<int>, counting_allocator<node_t> >	m;
+		ft::set<int, std::less<int>, counting_allocator<int> >			s;
+		ft::multiset<int, std::less<int>, counting_allocator<int> >		ms;
+		for (size_t i = 0; i < n; i++)
+			m.insert(ft::make_pair(ikeys[i], char(0)));
+		std::cout << "  sizeof(node<pair<const int, char> >) = " << sizeof(node_t)
+			<< ", sizeof(node<int>) = " << sizeof(ft::node<int>) << std::endl;
+		std::cout << "  map<int, char>: " << std::fixed << std::setprecision(1)
+			<< static_cast<double>(g_live_bytes) / m.size() << " B/elem" << std::endl;
+		m.clear();
+		measure_memory("set<int>", s, ikeys);
+		measure_memory("multiset<int>", ms, ikeys);
+		check(s.size() <= ms.size() && ms.size() == n, "set sizes");
+	}
+	{
+		typedef ft::node<ft::pair<const std::string, char> >	node_t;
+		ft::map<std::string, char, std::less<std::string>, counting_allocator<node_t> >	m;
+		ft::set<std::string, std::less<std::string>, counting_allocator<std::string> >		s;
+		size_t	before = g_live_bytes;
+		for (size_t i = 0; i < n; i++)
+			m.insert(ft::make_pair(skeys[i], char(0)));
+		std::cout << "  sizeof(node<pair<const string, char> >) = " << sizeof(node_t)
+			<< ", sizeof(node<string>) = " << sizeof(ft::node<std::string>) << std::endl;
+		std::cout << "  map<string, char>: " << std::fixed << std::setprecision(1)
+			<< static_cast<double>(g_live_bytes - before) / m.size() << " B/elem" << std::endl;
+		m.clear();
+		measure_memory("set<string>", s, skeys);
+	}
+}
+
+
+////////////////////////////////     tree_stats      ///////////////////////////////
+
+// Forma del árbol con claves aleatorias frente a claves que llegan ya ordenadas (el caso degenerado, en
+// el que el árbol acaba siendo una lista). Los contadores solo salen si se ha compilado con
+// make bench STATS=1; comparando los tiempos de las dos compilaciones se ve lo que cuestan.
+
+static void	tree_stats_run(const char* what, const ft::vector<int>& keys)
+{
+	ft::map<int, int>	m;
+	long				sum = 0;
+	double				t;
+
+	std::cout << " " << what << std::endl;
+	t = now_ms();
+	for (size_t i = 0; i < keys.size(); i++)
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	report("insert", now_ms() - t, keys.size());
+	m.reset_stats();
+	t = now_ms();
+	for (size_t i = 0; i < keys.size(); i++)
+		sum += m.find(keys[i])->second;
+	report("find (every key)", now_ms() - t, keys.size());
+	check(sum == static_cast<long>(keys.size()) * (static_cast<long>(keys.size()) - 1) / 2, "find results");
+# ifdef FT_TREE_STATS
+	ft::tree_stats	s = m.stats();
+	std::cout << s;
+	check(s.lookups == keys.size() && s.node_allocs == 0 && s.height == s.max_height, "stats counters");
+# endif
+}
+
+static void	bench_tree_stats(size_t n)
+{
+	ft::vector<int>		keys;
+	ft::map<int, int>	seen;
+
+	while (keys.size() < n)
+	{
+		int	k = rand();
+		if (seen.insert(ft::make_pair(k, 0)).second)
+			keys.push_back(k);
+	}
+	tree_stats_run("random keys", keys);
+	keys.resize(n / 100);
+	for (size_t i = 0; i < keys.size(); i++)
+		keys[i] = static_cast<int>(i);
+	tree_stats_run("sorted keys (n / 100)", keys);
+# ifndef FT_TREE_STATS
+	std::cout << "  (compiled without FT_TREE_STATS: make bench STATS=1 to see the counters)" << std::endl;
+# endif
+}
+
+
+/////////////////////////////     build_parallel      /////////////////////////////
+
+// Carga de n pares sin ordenar (con alguna clave repetida) en un mapa: n inserts frente a
+// map::build_parallel() con 1 a 16 hilos. Con un solo núcleo no puede haber mejora al añadir hilos, solo
+// se ve lo que cuesta crearlos.
+
+static void	bench_build_parallel(size_t n)
+{
+	ft::vector<ft::pair<int, int> >	input;
+	ft::map<int, int>				ref;
+	double							t;
+
+	for (size_t i = 0; i < n; i++)
+		input.push_back(ft::make_pair(rand() % static_cast<int>(n * 4), static_cast<int>(i)));
+	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+		ref.insert(input[i]);
+	report("insert one by one", now_ms() - t, n);
+	for (size_t threads = 1; threads <= 16; threads *= 2)
+	{
+		ft::map<int, int>	m;
+		char				what[64];
+
+		snprintf(what, sizeof(what), "build_parallel (%lu threads)", static_cast<unsigned long>(threads));
+		t = now_ms();
+		m.build_parallel(input.begin(), input.end(), threads);
+		report(what, now_ms() - t, n);
+		check(m == ref, "build_parallel differs from insert");
+	}
+	{
+		ft::multimap<int, int>	mm;
+		mm.build_parallel(input.begin(), input.end(), 4);
+		check(mm.size() == n, "multimap::build_parallel size");
+		for (ft::multimap<int, int>::iterator it = mm.begin(), prev = it++; it != mm.end(); prev = it++)
+			check(prev->first < it->first || (prev->first == it->first && prev->second < it->second),
+				"multimap::build_parallel order");
+	}
+}
+
+
+////////////////////////////     parallel_reduce      /////////////////////////////
+
+// Suma de los valores de un mapa de n elementos recorriéndolo con iteradores frente a parallel_reduce()
+// con 1 a 16 hilos, y parallel_for_each() modificando todos los valores. El mapa se construye con
+// build_parallel() para no tardar minutos en llenarlo.
+
+struct sum_values
+{
+	long operator() (long acc, const ft::pair<const int, int>& v) const
+	{
+		return (acc + v.second);
+	}
+
+	long operator() (long a, long b) const
+	{
+		return (a + b);
+	}
+};
+
+struct double_value
+{
+	void operator() (ft::pair<const int, int>& v) const
+	{
+		v.second *= 2;
+	}
+};
+
+// Concatena las claves en orden, para comprobar que parallel_reduce() las junta en orden.
+
+struct keys_in_order
+{
+	ft::pair<int, int> operator() (ft::pair<int, int> acc, const ft::pair<const int, int>& v) const
+	{
+		return ((*this)(acc, ft::make_pair(v.first, v.first)));
+	}
+
+	ft::pair<int, int> operator() (ft::pair<int, int> a, ft::pair<int, int> b) const
+	{
+		if (a.first == -1)												// (-1, -1) es el neutro: el trozo vacío
+			return (b);
+		if (b.first == -1)
+			return (a);
+		return (ft::make_pair(a.second < b.first ? a.first : -2, b.second));	// -2 si algo llega desordenado
+	}
+};
+
+static void	bench_parallel_reduce(size_t n)
+{
+	ft::vector<ft::pair<int, int> >	input;
+	ft::map<int, int>				m;
+	long							expected = 0;
+	double							t;
+
+	for (size_t i = 0; i < n; i++)
+		input.push_back(ft::make_pair(rand(), rand() % 1000));
+	m.build_parallel(input.begin(), input.end(), 1);
+
+	t = now_ms();
+	for (ft::map<int, int>::iterator it = m.begin(); it != m.end(); ++it)
+		expected += it->second;
+	report("iterator loop", now_ms() - t, m.size());
+	for (size_t threads = 1; threads <= 16; threads *= 2)
+	{
+		char	what[64];
+
+		snprintf(what, sizeof(what), "parallel_reduce (%lu threads)", static_cast<unsigned long>(threads));
+		t = now_ms();
+		long	sum = ft::parallel_reduce(m, 0L, sum_values(), threads);
+		report(what, now_ms() - t, m.size());
+		check(sum == expected, "parallel_reduce sum");
+	}
+	t = now_ms();
+	ft::parallel_for_each(m, double_value(), 4);
+	report("parallel_for_each (4 threads)", now_ms() - t, m.size());
+	check(ft::parallel_reduce(m, 0L, sum_values(), 4) == 2 * expected, "parallel_for_each");
+
+	ft::pair<int, int>	range = ft::parallel_reduce(m, ft::make_pair(-1, -1), keys_in_order(), 8);
+	check(range.first == m.begin()->first && range.second == (--m.end())->first, "parallel_reduce order");
+}
+
+
+//////////////////////////////     map_algebra      ///////////////////////////////
+
+// Actualización incremental de un índice grande (n claves) con un delta pequeño (1000 claves nuevas):
+// insertar y luego borrar el delta clave a clave frente a map_union_inplace() y map_difference_inplace(),
+// 100 veces (cada ronda deja el mapa como estaba). Después, la intersección del delta con el índice, y la
+// unión de dos mapas de n elementos frente a insert(b.begin(), b.end()) sobre una copia. Al final, un
+// delta de 40000 claves seguidas que caen todas en el mismo hueco del índice.
+
+static void	bench_map_algebra(size_t n)
+{
+	const size_t		m = 1000;
+	const size_t		rounds = 100;
+	ft::map<int, int>	base;
+	ft::map<int, int>	delta;
+	ft::map<int, int>	other;
+	double				t;
+
+	while (base.size() < n)
+	{
+		int	k = rand();
+		if (k < (1 << 21) || k >= (1 << 22))					// Deja un hueco para el último delta
+			base.insert(ft::make_pair(k, 0));
+	}
+	while (delta.size() < m)
+	{
+		int	k = rand();
+		if (base.find(k) == base.end())
+			delta.insert(ft::make_pair(k, 1));
+	}
+	t = now_ms();
+	for (size_t r = 0; r < rounds; r++)
+	{
+		base.insert(delta.begin(), delta.end());
+		for (ft::map<int, int>::iterator it = delta.begin(); it != delta.end(); ++it)
+			base.erase(it->first);
+	}
+	report("insert + erase one by one", now_ms() - t, rounds * m * 2);
+	check(base.size() == n, "insert + erase");
+	t = now_ms();
+	for (size_t r = 0; r < rounds; r++)
+	{
+		ft::map_union_inplace(base, delta);
+		check(base.size() == n + m, "map_union_inplace");
+		ft::map_difference_inplace(base, delta);
+	}
+	report("map_union_inplace + map_difference_inplace", now_ms() - t, rounds * m * 2);
+	check(base.size() == n, "map_difference_inplace");
+
+	size_t	found = 0;
+	t = now_ms();
+	for (size_t r = 0; r < rounds; r++)
+		for (ft::map<int, int>::iterator it = delta.begin(); it != delta.end(); ++it)
+			found += (base.find(it->first) != base.end());
+	report("find each delta key", now_ms() - t, rounds * m);
+	t = now_ms();
+	for (size_t r = 0; r < rounds; r++)
+		found += ft::map_intersection(base, delta).size();
+	report("map_intersection", now_ms() - t, rounds * m);
+	check(found == 0, "map_intersection");
+
+	while (other.size() < n)
+		other.insert(ft::make_pair(rand(), 2));
+	{
+		t = now_ms();
+		ft::map<int, int>	u(base);
+		u.insert(other.begin(), other.end());
+		report("copy + insert(b.begin(), b.end())", now_ms() - t, 2 * n);
+		t = now_ms();
+		ft::map<int, int>	v = ft::map_union(base, other);
+		report("map_union", now_ms() - t, 2 * n);
+		check(u == v, "map_union");
+	}
+
+	ft::map<int, int>	gap;
+
+	for (int k = 0; gap.size() < 40 * m; k++)
+		gap.insert(ft::make_pair((1 << 21) + k, 3));
+	t = now_ms();
+	ft::map_union_inplace(base, gap);
+	report("map_union_inplace, 40000 keys in one gap", now_ms() - t, 40 * m);
+	check(base.size() == n + 40 * m, "map_union_inplace in one gap");
+	t = now_ms();
+	ft::map_difference_inplace(base, gap);
+	report("map_difference_inplace, 40000 keys", now_ms() - t, 40 * m);
+	check(base.size() == n, "map_difference_inplace in one gap");
+}
+
+
+////////////////////////////     comparisons      ///////////////////////////////
+
+// Llamadas al comparador por operación con claves std::string que comparten un prefijo largo (como URLs
+// de un mismo dominio), que es cuando cada comparación cuesta de verdad.
+
+static size_t	g_compares = 0;
+
+struct counting_less
+{
+	bool operator() (const std::string& a, const std::string& b) const
+	{
+		++g_compares;
+		return (a < b);
+	}
+};
+
+static void	bench_comparisons(size_t n)
+{
+	typedef ft::map<std::string, int, counting_less>	map_type;
+
+	ft::vector<std::string>	keys;
+	map_type				m;
+	char					buf[64];
+	size_t					found = 0;
+	double					t;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		snprintf(buf, sizeof(buf), "https://example.com/static/assets/%010d", rand());
+		keys.push_back(buf);
+	}
+	g_compares = 0;
+	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	report("insert", now_ms() - t, n);
+	std::cout << "    " << static_cast<double>(g_compares) / n << " comparisons/insert" << std::endl;
+
+	g_compares = 0;
+	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+		found += (m.find(keys[i]) != m.end());
+	report("find (hit)", now_ms() - t, n);
+	std::cout << "    " << static_cast<double>(g_compares) / n << " comparisons/find" << std::endl;
+
+	g_compares = 0;
+	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+	{
+		keys[i][keys[i].size() - 1] = 'x';								// Ya no está en el mapa
+		found += (m.find(keys[i]) != m.end());
+	}
+	report("find (miss)", now_ms() - t, n);
+	std::cout << "    " << static_cast<double>(g_compares) / n << " comparisons/find" << std::endl;
+	check(found == n, "find results");
+}
+
+
+////////////////////////////////     small_map      ////////////////////////////////
+
+// Muchos mapas pequeños: para k = 0 a 16 elementos, lo que ocupa cada mapa (el objeto más la memoria
+// reservada), cuántas reservas hace y cuánto cuesta crearlo, llenarlo y destruirlo, sin nodos dentro del
+// objeto (el map de siempre) y con 8 dentro.
+
+template <size_t N>
+static void	small_map_run(size_t k, size_t maps)
+{
+	typedef ft::node<ft::pair<const int, int> >										node_t;
+	typedef ft::map<int, int, std::less<int>, counting_allocator<node_t>, N>		map_type;
+
+	char	what[64];
+	size_t	calls = g_alloc_calls;
+	size_t	bytes = 0;
+	long	sum = 0;
+	double	t = now_ms();
+
+	for (size_t i = 0; i < maps; i++)
+	{
+		map_type	m;
+		for (size_t j = 0; j < k; j++)
+			m.insert(ft::make_pair(static_cast<int>((j * 7919 + i) % 64), static_cast<int>(j)));
+		if (i == 0)
+			bytes = g_live_bytes;
+		sum += m.size();
+	}
+	t = now_ms() - t;
+	check(sum > 0 || k == 0, "small_map sizes");
+	snprintf(what, sizeof(what), "N = %lu, %2lu entries", static_cast<unsigned long>(N), static_cast<unsigned long>(k));
+	std::cout << "  " << std::left << std::setw(28) << what << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(6) << sizeof(map_type) << " + " << std::setw(5) << bytes << " B/map"
+		<< std::setw(7) << static_cast<double>(g_alloc_calls - calls) / maps << " allocs/map"
+		<< std::setw(9) << (t * 1000000.0 / maps) << " ns/map" << std::endl;
+}
+
+static void	bench_small_map(size_t maps)
+{
+	const size_t	sizes[] = {0, 1, 2, 4, 8, 12, 16};
+
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		small_map_run<0>(sizes[i], maps);
+		small_map_run<8>(sizes[i], maps);
+	}
+}
+
+
+/////////////////////////////     key_prefix      /////////////////////////////
+
+// map<std::string, int> con std::less y con ft::prefix_less, que ordena igual pero guarda en los nodos
+// el prefijo de la clave (ver Map/key_prefix.hpp), con claves que se parecen a las de verdad:
+// identificadores (nombres de funciones y variables de un programa), rutas con el dominio delante y
+// URLs completas. Las URLs empiezan todas por "https://", así que sus 8 primeros bytes son siempre
+// iguales y el prefijo no sirve de nada: ahí solo se mide lo que cuesta tenerlo.
+
+static std::string	make_identifier(void)
+{
+	static const char*	parts[] = {"get", "set", "update", "parse", "read", "write", "init", "load", "user",
+		"name", "buffer", "index", "count", "node", "tree", "value", "config", "file", "socket", "event"};
+	std::string			ret = parts[rand() % 20];
+	int					n = 1 + rand() % 3;
+	char				num[16];
+
+	for (int i = 0; i < n; i++)
+	{
+		std::string	part = parts[rand() % 20];
+		part[0] = part[0] - 'a' + 'A';
+		ret += part;
+	}
+	snprintf(num, sizeof(num), "%d", rand() % 100);
+	return (ret + num);
+}
+
+static std::string	make_path(bool scheme)
+{
+	static const char*	hosts[] = {"example.com", "api.github.com", "en.wikipedia.org", "news.ycombinator.com",
+		"docs.python.org", "stackoverflow.com", "cdn.jsdelivr.net", "www.google.com", "mail.yahoo.com",
+		"maps.apple.com", "static.cloudflare.com", "s3.amazonaws.com", "www.reddit.com", "t.co", "bit.ly"};
+	char				buf[128];
+
+	snprintf(buf, sizeof(buf), "%s%s/%s/%d/%d", (scheme ? "https://" : ""), hosts[rand() % 15],
+		(rand() % 2 ? "static/assets" : "users"), rand() % 100000, rand());
+	return (buf);
+}
+
+template <class Map>
+static void	key_prefix_run(const char* what, const ft::vector<std::string>& keys, const ft::vector<std::string>& queries)
+{
+	char	label[64];
+	Map		m;
+	size_t	found = 0;
+	double	t = now_ms();
+
+	for (size_t i = 0; i < keys.size(); i++)
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	snprintf(label, sizeof(label), "%s: insert", what);
+	report(label, now_ms() - t, keys.size());
+	t = now_ms();
+	for (size_t i = 0; i < queries.size(); i++)
+		found += (m.find(queries[i]) != m.end());
+	snprintf(label, sizeof(label), "%s: find (half hits)", what);
+	report(label, now_ms() - t, queries.size());
+	check(found == queries.size() / 2, "key_prefix find results");
+}
+
+// Cada versión se mide en un proceso hijo, que empieza con el montón en el mismo estado. Si se midieran
+// una detrás de otra, la segunda reservaría sus nodos en los huecos que ha dejado la primera, repartidos
+// por toda la memoria, y saldría más lenta solo por eso.
+
+template <class Map>
+static void	key_prefix_fork(const char* what, const ft::vector<std::string>& keys, const ft::vector<std::string>& queries)
+{
+	pid_t	pid;
+	int		status;
+
+	std::cout.flush();
+	pid = fork();
+	check(pid >= 0, "fork");
+	if (pid == 0)
+	{
+		key_prefix_run<Map>(what, keys, queries);
+		exit(0);
+	}
+	check(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0, "key_prefix child");
+}
+
+static void	bench_key_prefix(size_t n)
+{
+	const char*	names[] = {"identifiers", "host/path", "https URLs"};
+
+	for (int kind = 0; kind < 3; kind++)
+	{
+		ft::vector<std::string>			keys;
+		ft::vector<std::string>			queries;
+		ft::map<std::string, int>		unique;
+
+		while (unique.size() < n)
+		{
+			std::string	k = (kind == 0 ? make_identifier() : make_path(kind == 2));
+			if (unique.insert(ft::make_pair(k, 0)).second)
+				keys.push_back(k);
+		}
+		for (size_t i = 0; i < n; i++)
+		{
+			if (i % 2 == 0)
+				queries.push_back(keys[rand() % n]);
+			else
+				queries.push_back(keys[rand() % n] + "#");					// No está en el mapa
+		}
+		std::cout << "  " << names[kind] << std::endl;
+		key_prefix_fork<ft::map<std::string, int> >("  std::less", keys, queries);
+		key_prefix_fork<ft::map<std::string, int, ft::prefix_less<std::string> > >("  prefix_less", keys, queries);
+	}
+}
+
+
+/////////////////////////////     map_footprint      /////////////////////////////
+
+// Lo que cuesta un mapa vacío: su tamaño y, para n mapas, las reservas y el tiempo de construirlos por
+// defecto, copiarlos y destruirlos sin llegar a insertar nada (por ejemplo un mapa por objeto que casi
+// nunca se usa), y de construir un mapa e insertar un solo elemento.
+
+static void	footprint_run(const char* what, size_t calls, double t, size_t n)
+{
+	std::cout << "  " << std::left << std::setw(28) << what << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(7) << static_cast<double>(g_alloc_calls - calls) / n << " allocs/map"
+		<< std::setw(9) << (t * 1000000.0 / n) << " ns/map" << std::endl;
+}
+
+static void	bench_map_footprint(size_t n)
+{
+	typedef ft::node<ft::pair<const int, int> >									node_t;
+	typedef ft::map<int, int, std::less<int>, counting_allocator<node_t> >		map_type;
+
+	std::cout << "  sizeof: map<int, int> " << sizeof(ft::map<int, int>)
+		<< ", multimap<int, int> " << sizeof(ft::multimap<int, int>)
+		<< ", set<int> " << sizeof(ft::set<int>)
+		<< ", map<string, string> " << sizeof(ft::map<std::string, std::string>) << std::endl;
+
+	size_t	calls = g_alloc_calls;
+	size_t	sum = 0;
+	double	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+	{
+		map_type	m;
+		sum += m.size();
+	}
+	footprint_run("default construct", calls, now_ms() - t, n);
+
+	map_type	empty;
+	calls = g_alloc_calls;
+	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+	{
+		map_type	m(empty);
+		sum += m.size();
+	}
+	footprint_run("copy empty", calls, now_ms() - t, n);
+
+	calls = g_alloc_calls;
+	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+	{
+		map_type	m;
+		m.insert(ft::make_pair(static_cast<int>(i), 1));
+		sum += m.size();
+	}
+	footprint_run("construct + 1 insert", calls, now_ms() - t, n);
+	check(sum == n, "map_footprint sizes");
+}
+
+
+/////////////////////////////     radix_map      /////////////////////////////
+
+// ft::map y ft::radix_map con claves uint64_t aleatorias para varios tamaños, y con los identificadores
+// de key_prefix. En map lo que cuesta buscar crece con log2(n), y en radix_map depende solo de cuántos
+// bytes de la clave hay que mirar para separarla de las demás, así que debería cambiar poco con n (lo
+// que sí crece con n son los fallos de caché, en los dos). Como en key_prefix, cada versión se mide en
+// un proceso hijo.
+
+template <class Map, class Key>
+static void	radix_run(const char* what, const ft::vector<Key>& keys, const ft::vector<Key>& queries)
+{
+	char	label[64];
+	Map		m;
+	size_t	found = 0;
+	size_t	bounds = 0;
+	double	t = now_ms();
+
+	for (size_t i = 0; i < keys.size(); i++)
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	snprintf(label, sizeof(label), "%s: insert", what);
+	report(label, now_ms() - t, keys.size());
+	t = now_ms();
+	for (size_t i = 0; i < queries.size(); i++)
+		found += (m.find(queries[i]) != m.end());
+	snprintf(label, sizeof(label), "%s: find (half hits)", what);
+	report(label, now_ms() - t, queries.size());
+	t = now_ms();
+	for (size_t i = 0; i < queries.size(); i++)
+		bounds += (m.lower_bound(queries[i]) != m.end());
+	snprintf(label, sizeof(label), "%s: lower_bound", what);
+	report(label, now_ms() - t, queries.size());
+	check(found == queries.size() / 2 && bounds >= found, "radix_map find results");
+
+	Map		copy(m);
+	size_t	same = 0;
+	typename Map::iterator	it = copy.begin();
+	for (typename Map::iterator last = copy.end(); it != last; ++it)
+		same += (copy.lower_bound(it->first) == it);
+	check(same == keys.size(), "radix_map order");
+}
+
+template <class Map, class Key>
+static void	radix_fork(const char* what, const ft::vector<Key>& keys, const ft::vector<Key>& queries)
+{
+	pid_t	pid;
+	int		status;
+
+	std::cout.flush();
+	pid = fork();
+	check(pid >= 0, "fork");
+	if (pid == 0)
+	{
+		radix_run<Map, Key>(what, keys, queries);
+		exit(0);
+	}
+	check(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0, "radix_map child");
+}
+
+static unsigned long long	rand64(void)
+{
+	return ((static_cast<unsigned long long>(rand()) << 42) ^ (static_cast<unsigned long long>(rand()) << 21) ^ rand());
+}
+
+static void	bench_radix_map(size_t n)
+{
+	typedef unsigned long long	u64;
+
+	for (size_t size = n / 100; size <= n; size *= 10)
+	{
+		ft::vector<u64>		keys;
+		ft::vector<u64>		queries;
+		ft::set<u64>		unique;
+
+		while (unique.size() < size)
+		{
+			u64	k = rand64() & ~1ULL;										// Las pares están, las impares no
+			if (unique.insert(k).second)
+				keys.push_back(k);
+		}
+		for (size_t i = 0; i < size; i++)
+			queries.push_back(keys[rand() % size] | (i % 2));
+		std::cout << "  uint64_t, n = " << size << std::endl;
+		radix_fork<ft::map<u64, int>, u64>("  map", keys, queries);
+		radix_fork<ft::radix_map<u64, int>, u64>("  radix_map", keys, queries);
+	}
+
+	ft::vector<std::string>		keys;
+	ft::vector<std::string>		queries;
+	ft::set<std::string>		unique;
+
+	while (unique.size() < n)
+	{
+		std::string	k = make_identifier();
+		if (unique.insert(k).second)
+			keys.push_back(k);
+	}
+	for (size_t i = 0; i < n; i++)
+		queries.push_back(i % 2 ? keys[rand() % n] + "#" : keys[rand() % n]);
+	std::cout << "  identifiers, n = " << n << std::endl;
+	radix_fork<ft::map<std::string, int>, std::string>("  map", keys, queries);
+	radix_fork<ft::radix_map<std::string, int>, std::string>("  radix_map", keys, queries);
+}
+
+
+/////////////////////////////     splay      /////////////////////////////
+
+// find() de un ft::map normal y con ft::splay_tree_policy y ft::sampled_splay_tree_policy (ver
+// Map/tree_policy.hpp) cuando las búsquedas siguen una distribución de Zipf: la clave de rango r se busca
+// con probabilidad proporcional a 1 / r^s. Con s = 0 todas se buscan igual, y cuanto mayor es s más se
+// concentran las búsquedas en las primeras. Los rangos se reparten al azar entre las claves, así que las
+// más buscadas no están juntas, y las claves se insertan en otro orden aleatorio distinto (si se
+// insertaran en el orden de los rangos, las más buscadas quedarían ya arriba en el mapa normal). Como en
+// key_prefix, cada versión se mide en un proceso hijo.
+
+template <class Map>
+static void	splay_run(const char* what, const ft::vector<int>& keys, const ft::vector<int>& queries)
+{
+	char		label[64];
+	Map			m;
+	long long	sum = 0;
+	double		t;
+
+	for (size_t i = 0; i < keys.size(); i++)
+		m.insert(ft::make_pair(keys[i], keys[i] / 2));
+	m.reset_stats();
+	t = now_ms();
+	for (size_t i = 0; i < queries.size(); i++)
+		sum += m.find(queries[i])->second;
+	snprintf(label, sizeof(label), "%s: find", what);
+	report(label, now_ms() - t, queries.size());
+
+	long long	expected = 0;
+	for (size_t i = 0; i < queries.size(); i++)
+		expected += queries[i] / 2;
+	check(sum == expected, "splay find results");
+# ifdef FT_TREE_STATS
+	ft::tree_stats	st = m.stats();
+	std::cout << "    " << std::setprecision(1) << static_cast<double>(st.visited) / st.lookups << " nodes/find, "
+		<< static_cast<double>(st.rotations) / queries.size() << " rotations/find" << std::endl;
+# endif
+}
+
+template <class Map>
+static void	splay_fork(const char* what, const ft::vector<int>& keys, const ft::vector<int>& queries)
+{
+	pid_t	pid;
+	int		status;
+
+	std::cout.flush();
+	pid = fork();
+	check(pid >= 0, "fork");
+	if (pid == 0)
+	{
+		splay_run<Map>(what, keys, queries);
+		exit(0);
+	}
+	check(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0, "splay child");
+}
+
+static double	rand_unit(void)
+{
+	return ((static_cast<double>(rand()) * RAND_MAX + rand()) / (static_cast<double>(RAND_MAX) * RAND_MAX + RAND_MAX + 1));
+}
+
+static void	bench_splay(size_t n)
+{
+	typedef std::allocator<ft::node<ft::pair<const int, int> > >					alloc_type;
+	typedef ft::map<int, int, std::less<int>, alloc_type, 0, ft::splay_tree_policy>	splay_map;
+	typedef ft::map<int, int, std::less<int>, alloc_type, 0, ft::sampled_splay_tree_policy>	sampled_map;
+	const double	exponents[] = {0.0, 0.99, 1.2, 1.5};
+	ft::vector<int>	keys;
+	ft::vector<int>	ranked;
+
+	for (size_t i = 0; i < n; i++)
+		keys.push_back(static_cast<int>(i) * 2);
+	for (int pass = 0; pass < 2; pass++)										// Un orden aleatorio para los rangos y otro para insertar
+	{
+		for (size_t i = n - 1; i > 0; i--)
+		{
+			size_t	j = rand() % (i + 1);
+			int		tmp = keys[i];
+			keys[i] = keys[j];
+			keys[j] = tmp;
+		}
+		if (pass == 0)
+			ranked = keys;
+	}
+	for (size_t e = 0; e < 4; e++)
+	{
+		ft::vector<double>	cdf;
+		ft::vector<int>		queries;
+		double				total = 0;
+
+		for (size_t r = 1; r <= n; r++)
+		{
+			total += 1.0 / pow(static_cast<double>(r), exponents[e]);
+			cdf.push_back(total);
+		}
+		for (size_t i = 0; i < 4 * n; i++)
+		{
+			double	u = rand_unit() * total;
+			size_t	lo = 0;
+			size_t	hi = n - 1;
+			while (lo < hi)														// El primer rango con cdf >= u
+			{
+				size_t	mid = lo + (hi - lo) / 2;
+				if (cdf[mid] < u)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			queries.push_back(ranked[lo]);
+		}
+		std::cout << "  s = " << std::fixed << std::setprecision(2) << exponents[e] << " (top 1% of keys get "
+			<< std::setprecision(0) << 100.0 * cdf[n / 100 ? n / 100 - 1 : 0] / total << "% of finds)" << std::endl;
+		splay_fork<ft::map<int, int> >("  map", keys, queries);
+		splay_fork<splay_map>("  splay_tree_policy", keys, queries);
+		splay_fork<sampled_map>("  sampled_splay_tree_policy", keys, queries);
+	}
+}
+
+
+/////////////////////////////     compact      /////////////////////////////
+
+// Un ft::map de n elementos después de n borrados e inserciones al azar (cada borrado deja un hueco que
+// reutiliza alguna inserción posterior, así que los nodos que van seguidos en el orden acaban en
+// cualquier parte de la memoria), antes y después de compact(). Se mide recorrerlo entero y buscar n
+// claves que están, y lo que tarda compact().
+
+static void	compact_measure(const char* what, ft::map<unsigned int, int>& m, const ft::vector<unsigned int>& live)
+{
+	char		label[64];
+	long long	sum = 0;
+	double		t = now_ms();
+
+	for (ft::map<unsigned int, int>::iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->second;
+	snprintf(label, sizeof(label), "%s: iterate", what);
+	report(label, now_ms() - t, m.size());
+
+	long long	found = 0;
+	t = now_ms();
+	for (size_t i = 0; i < live.size(); i++)
+		found += m.find(live[(i * 7919) % live.size()])->second;
+	snprintf(label, sizeof(label), "%s: find", what);
+	report(label, now_ms() - t, live.size());
+	check(sum == found, "compact results");
+}
+
+static void	bench_compact(size_t n)
+{
+	ft::map<unsigned int, int>	m;
+	ft::vector<unsigned int>	live;
+	unsigned int				next = 0;
+	double						t;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		unsigned int	k = (next++) * 2654435761u;							// Distintas y desordenadas
+		m.insert(ft::make_pair(k, 1));
+		live.push_back(k);
+	}
+	for (size_t i = 0; i < n; i++)
+	{
+		size_t			j = (static_cast<size_t>(rand()) * RAND_MAX + rand()) % n;
+		unsigned int	k = (next++) * 2654435761u;
+
+		m.erase(live[j]);
+		m.insert(ft::make_pair(k, 1));
+		live[j] = k;
+	}
+	compact_measure("churned", m, live);
+	t = now_ms();
+	m.compact();
+	report("compact()", now_ms() - t, n);
+	compact_measure("compacted", m, live);
+}
+
+
+/////////////////////////////     finger      /////////////////////////////
+
+// map::find() contra map::finger::find() buscando n claves de un mapa de n elementos (insertados en orden
+// aleatorio) en tres órdenes: todas en orden, casi en orden (cada una a entre 8 por detrás y 24 por
+// delante de la anterior) y al azar, donde el finger no tiene nada que aprovechar.
+
+static void	finger_nodes(const ft::tree_stats& st)
+{
+# ifdef FT_TREE_STATS
+	std::cout << "    " << std::setprecision(1) << static_cast<double>(st.visited) / st.lookups << " nodes/find, "
+		<< static_cast<double>(st.comparisons) / st.lookups << " comparisons/find" << std::endl;
+# else
+	static_cast<void>(st);
+# endif
+}
+
+static void	bench_finger(size_t n)
+{
+	typedef ft::map<int, int>	map_type;
+	const char*		names[] = {"sequential", "near-sequential", "random"};
+	map_type		m;
+	ft::vector<int>	keys;
+
+	for (size_t i = 0; i < n; i++)
+		keys.push_back(static_cast<int>(i) * 2);
+	for (size_t i = n - 1; i > 0; i--)
+	{
+		size_t	j = (static_cast<size_t>(rand()) * RAND_MAX + rand()) % (i + 1);
+		int		tmp = keys[i];
+		keys[i] = keys[j];
+		keys[j] = tmp;
+	}
+	for (size_t i = 0; i < n; i++)
+		m.insert(ft::make_pair(keys[i], keys[i] / 2));
+
+	for (int kind = 0; kind < 3; kind++)
+	{
+		ft::vector<int>	queries;
+		long			pos = 0;
+		char			label[64];
+
+		for (size_t i = 0; i < n; i++)
+		{
+			if (kind == 0)
+				pos = static_cast<long>(i);
+			else if (kind == 1)
+				pos += rand() % 33 - 8;
+			else
+				pos = (static_cast<long>(rand()) * RAND_MAX + rand()) % static_cast<long>(n);
+			if (pos < 0 || pos >= static_cast<long>(n))
+				pos = rand() % static_cast<long>(n);
+			queries.push_back(static_cast<int>(pos) * 2);
+		}
+
+		long long	sum = 0;
+		double		t;
+
+		m.reset_stats();
+		t = now_ms();
+		for (size_t i = 0; i < n; i++)
+			sum += m.find(queries[i])->second;
+		snprintf(label, sizeof(label), "%s: map::find", names[kind]);
+		report(label, now_ms() - t, n);
+		finger_nodes(m.stats());
+
+		map_type::finger	f(m);
+		long long			fsum = 0;
+		m.reset_stats();
+		t = now_ms();
+		for (size_t i = 0; i < n; i++)
+			fsum += f.find(queries[i])->second;
+		snprintf(label, sizeof(label), "%s: finger::find", names[kind]);
+		report(label, now_ms() - t, n);
+		finger_nodes(m.stats());
+		check(sum == fsum, "finger results");
+	}
+}
+
+
+/////////////////////////////     vector_copy      /////////////////////////////
+
+// Crecimiento y copias de ft::vector con tipos que se copian con memcpy (int y un struct de 16 bytes) y
+// con las mismas clases pero con un constructor de copia propio, que obliga a copiar elemento a
+// elemento y da lo que costaba antes para todos los tipos: push_back de n elementos (el bucle de
+// ft_main.cpp), constructor de copia, operator= e insert() de un rango al principio.
+
+template <class T, bool Trivial>
+struct bench_item
+{
+	T	v;
+
+	bench_item(long x = 0) :
+		v(x)
+	{}
+};
+
+template <class T>
+struct bench_item<T, false>
+{
+	T	v;
+
+	bench_item(long x = 0) :
+		v(x)
+	{}
+
+	bench_item(const bench_item& src) :
+		v(src.v)
+	{}
+
+	bench_item& operator= (const bench_item& rhs)
+	{
+		this->v = rhs.v;
+		return (*this);
+	}
+};
+
+struct bench_quad
+{
+	int	a;
+	int	b;
+	int	c;
+	int	d;
+
+	bench_quad(long x = 0) :
+		a(x), b(x + 1), c(x + 2), d(x + 3)
+	{}
+
+	bench_quad& operator+= (long x)
+	{
+		this->a += x;
+		return (*this);
+	}
+
+	operator long() const
+	{
+		return (this->a + this->d);
+	}
+};
+
+template <class T>
+static long	vector_copy_key(size_t i, size_t n)
+{
+	return (static_cast<long>(i * 2654435761u % n));
+}
+
+template <class T>
+static void	vector_copy_run(const char* what, size_t n)
+{
+	char			label[64];
+	double			t = now_ms();
+	ft::vector<T>	v;
+
+	for (size_t i = 0; i < n; i++)
+		v.push_back(T(vector_copy_key<T>(i, n)));
+	snprintf(label, sizeof(label), "%s: push_back", what);
+	report(label, now_ms() - t, n);
+
+	t = now_ms();
+	{
+		ft::vector<T>	copy(v);
+		check(static_cast<long>(copy[n / 2].v) == static_cast<long>(v[n / 2].v), "vector copy constructor");
+	}
+	snprintf(label, sizeof(label), "%s: copy constructor", what);
+	report(label, now_ms() - t, n);
+
+	ft::vector<T>	dst;
+	t = now_ms();
+	for (int i = 0; i < 4; i++)
+	{
+		dst = v;
+		check(static_cast<long>(dst[n - 1 - i].v) == static_cast<long>(v[n - 1 - i].v), "vector operator=");
+	}
+	snprintf(label, sizeof(label), "%s: operator= (x4)", what);
+	report(label, now_ms() - t, 4 * n);
+
+	ft::vector<T>	head(v.begin(), v.begin() + n / 10);
+	t = now_ms();
+	v.insert(v.begin(), head.begin(), head.end());
+	snprintf(label, sizeof(label), "%s: insert %lu at begin()", what, static_cast<unsigned long>(n / 10));
+	report(label, now_ms() - t, n + n / 10);
+	check(v.size() == n + n / 10, "vector insert size");
+	for (size_t i = 0; i < v.size(); i++)
+		check(static_cast<long>(v[i].v) == static_cast<long>(T(vector_copy_key<T>(i < n / 10 ? i : i - n / 10, n)).v),
+			"vector insert");
+}
+
+// Cada variante en un proceso nuevo, para que todas empiecen con la misma memoria sin tocar (si no, las
+// que van después aprovechan páginas que malloc ya tiene de las anteriores).
+
+template <class T>
+static void	vector_copy_fork(const char* what, size_t n)
+{
+	pid_t	pid;
+	int		status;
+
+	std::cout.flush();
+	pid = fork();
+	check(pid >= 0, "fork");
+	if (pid == 0)
+	{
+		vector_copy_run<T>(what, n);
+		exit(0);
+	}
+	check(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0, "vector_copy child");
+}
+
+static void	bench_vector_copy(size_t n)
+{
+	vector_copy_fork<bench_item<int, true> >("int", n);
+	vector_copy_fork<bench_item<int, false> >("int, own copy", n);
+	vector_copy_fork<bench_item<bench_quad, true> >("16 B struct", n);
+	vector_copy_fork<bench_item<bench_quad, false> >("16 B struct, own copy", n);
+}
+
+/////////////////////////////     vector_relocate      /////////////////////////////
+
+// Una clase con un buffer propio en el heap (como un handle o una cadena) que se puede mover por bytes, con
+// y sin ft::is_trivially_relocatable: al crecer con push_back, y con inserts y erases en posiciones al
+// azar de un vector de n / 10 elementos. Sin la marca cada elemento que se mueve es una copia (con su
+// reserva de memoria) y una destrucción. Al final, lo mismo con un vector de vectores, que lo tiene
+// marcado siempre, contra uno de los mismos handles sin marcar.
+
+template <bool Relocatable>
+struct bench_handle
+{
+	int*	buf;
+
+	explicit bench_handle(int x = 0) :
+		buf(new int[8])
+	{
+		this->buf[0] = x;
+	}
+
+	bench_handle(const bench_handle& src) :
+		buf(new int[8])
+	{
+		this->buf[0] = src.buf[0];
+	}
+
+	~bench_handle(void)
+	{
+		delete[] this->buf;
+	}
+
+	bench_handle& operator= (const bench_handle& rhs)
+	{
+		this->buf[0] = rhs.buf[0];
+		return (*this);
+	}
+
+	int get(void) const
+	{
+		return (this->buf[0]);
+	}
+};
+
+namespace ft
+{
+	template <>
+	struct is_trivially_relocatable<bench_handle<true> >
+	{
+		static const bool value = true;
+	};
+}
+
+template <class T>
+static T	bench_make(int x)
+{
+	return (T(x));
+}
+
+template <>
+ft::vector<int>	bench_make<ft::vector<int> >(int x)
+{
+	return (ft::vector<int>(8, x));
+}
+
+static int	bench_get(const ft::vector<int>& v)
+{
+	return (v[0]);
+}
+
+template <class T>
+static int	bench_get(const T& v)
+{
+	return (v.get());
+}
+
+template <class T>
+static void	vector_relocate_run(const char* what, size_t n, size_t ops)
+{
+	char			label[64];
+	long			sum = 0;
+	ft::vector<T>	v;
+	double			t = now_ms();
+
+	for (size_t i = 0; i < n; i++)
+		v.push_back(bench_make<T>(static_cast<int>(i)));
+	snprintf(label, sizeof(label), "%s: push_back", what);
+	report(label, now_ms() - t, n);
+
+	ft::vector<T>	w(v.begin(), v.begin() + n / 10);
+	srand(7);
+	t = now_ms();
+	for (size_t i = 0; i < ops; i++)
+	{
+		w.insert(w.begin() + rand() % (w.size() + 1), bench_make<T>(static_cast<int>(i)));
+		w.erase(w.begin() + rand() % w.size());
+	}
+	snprintf(label, sizeof(label), "%s: insert + erase at random", what);
+	report(label, now_ms() - t, ops);
+
+	for (size_t i = 0; i < w.size(); i++)
+		sum += bench_get(w[i]) * static_cast<long>(i % 7 + 1);
+	check(w.size() == n / 10, "vector_relocate size");
+	std::cout << "    checksum " << sum << std::endl;
+}
+
+template <class T>
+static void	vector_relocate_fork(const char* what, size_t n, size_t ops)
+{
+	pid_t	pid;
+	int		status;
+
+	std::cout.flush();
+	pid = fork();
+	check(pid >= 0, "fork");
+	if (pid == 0)
+	{
+		vector_relocate_run<T>(what, n, ops);
+		exit(0);
+	}
+	check(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0, "vector_relocate child");
+}
+
+static void	bench_vector_relocate(size_t n)
+{
+	vector_relocate_fork<bench_handle<true> >("relocatable handle", n, 200);
+	vector_relocate_fork<bench_handle<false> >("handle", n, 200);
+	vector_relocate_fork<ft::vector<int> >("vector<int>", n, 200);
+}
+
+/////////////////////////////     vector_growth      /////////////////////////////
+
+// push_back de n enteros con cada política de crecimiento (Vector/vector_growth.hpp), contando las reservas,
+// y con realloc_allocator, que amplía el bloque con realloc() (mremap() cuando es grande) en lugar de
+// reservar otro y copiar. Después, un millón de vectores cortos de 6 elementos, que es donde se nota
+// empezar con una capacidad mínima.
+
+template <class Vector>
+static void	vector_growth_run(const char* what, size_t n, size_t len)
+{
+	char	label[80];
+	size_t	calls = g_alloc_calls;
+	long	sum = 0;
+	double	t = now_ms();
+
+	if (len == 0)
+	{
+		Vector	v;
+		for (size_t i = 0; i < n; i++)
+			v.push_back(static_cast<int>(i));
+		sum = v[n / 3] + v[n - 1];
+		t = now_ms() - t;
+		check(sum == static_cast<long>(n / 3 + n - 1), "vector_growth values");
+		snprintf(label, sizeof(label), "%s: push_back, capacity %lu", what, static_cast<unsigned long>(v.capacity()));
+	}
+	else
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			Vector	v;
+			for (size_t j = 0; j < len; j++)
+				v.push_back(static_cast<int>(i + j));
+			sum += v[len - 1];
+		}
+		t = now_ms() - t;
+		check(sum > 0, "vector_growth values");
+		snprintf(label, sizeof(label), "%s: %lu x %lu elements", what, static_cast<unsigned long>(n),
+			static_cast<unsigned long>(len));
+	}
+	report(label, t, n * (len ? len : 1));
+	if (g_alloc_calls != calls)
+		std::cout << "    " << g_alloc_calls - calls << " allocations" << std::endl;
+}
+
+template <class Vector>
+static void	vector_growth_fork(const char* what, size_t n, size_t len)
+{
+	pid_t	pid;
+	int		status;
+
+	std::cout.flush();
+	pid = fork();
+	check(pid >= 0, "fork");
+	if (pid == 0)
+	{
+		vector_growth_run<Vector>(what, n, len);
+		exit(0);
+	}
+	check(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0, "vector_growth child");
+}
+
+static void	bench_vector_growth(size_t n)
+{
+	typedef counting_allocator<int>		alloc_type;
+	typedef ft::realloc_allocator<int>	realloc_type;
+
+	vector_growth_fork<ft::vector<int, alloc_type> >("2x", n, 0);
+	vector_growth_fork<ft::vector<int, alloc_type, ft::half_growth_policy> >("1.5x", n, 0);
+	vector_growth_fork<ft::vector<int, alloc_type, ft::page_growth_policy> >("page", n, 0);
+	vector_growth_fork<ft::vector<int, realloc_type> >("2x, realloc", n, 0);
+	vector_growth_fork<ft::vector<int, realloc_type, ft::half_growth_policy> >("1.5x, realloc", n, 0);
+	vector_growth_fork<ft::vector<int, realloc_type, ft::page_growth_policy> >("page, realloc", n, 0);
+	vector_growth_fork<ft::vector<int, alloc_type> >("2x", 1000000, 6);
+	vector_growth_fork<ft::vector<int, alloc_type, ft::min_capacity_growth_policy<8> > >("min 8", 1000000, 6);
+}
+
+/////////////////////////////     vector_insert_erase      /////////////////////////////
+
+// insert() y erase() de un elemento en posiciones al azar de un vector de n elementos: enteros (que se
+// desplazan con memmove), cadenas de 24 caracteres (que no caben dentro del objeto y se desplazan
+// asignando una sobre otra) y handles que no se pueden mover por bytes. Antes cada llamada copiaba todo
+// lo que iba detrás en un vector temporal.
+
+static int	bench_get(int x)
+{
+	return (x);
+}
+
+static int	bench_get(const std::string& s)
+{
+	return (s[0] + 256 * s[23]);
+}
+
+template <class T>
+static void	vector_insert_erase_run(const char* what, const ft::vector<T>& src, size_t ops)
+{
+	char			label[64];
+	ft::vector<T>	v(src);
+	double			t;
+
+	srand(11);
+	t = now_ms();
+	for (size_t i = 0; i < ops; i++)
+	{
+		v.insert(v.begin() + rand() % (v.size() + 1), src[i % src.size()]);
+		v.erase(v.begin() + rand() % v.size());
+	}
+	snprintf(label, sizeof(label), "%s: insert + erase", what);
+	report(label, now_ms() - t, ops);
+
+	ft::vector<T>	ref(src);
+	srand(11);
+	for (size_t i = 0; i < ops; i++)
+	{
+		size_t	pos = rand() % (ref.size() + 1);
+		ref.push_back(src[i % src.size()]);
+		for (size_t j = ref.size() - 1; j > pos; j--)
+			std::swap(ref[j], ref[j - 1]);
+		pos = rand() % ref.size();
+		for (size_t j = pos; j + 1 < ref.size(); j++)
+			std::swap(ref[j], ref[j + 1]);
+		ref.pop_back();
+	}
+	check(v.size() == ref.size(), "vector_insert_erase size");
+	for (size_t i = 0; i < v.size(); i++)
+		check(bench_get(v[i]) == bench_get(ref[i]), "vector_insert_erase values");
+}
+
+static void	bench_vector_insert_erase(size_t n)
+{
+	const size_t				ops = 1000;
+	ft::vector<int>				ints;
+	ft::vector<std::string>		strings;
+	ft::vector<bench_handle<false> >	handles;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		ints.push_back(static_cast<int>(i));
+		strings.push_back(std::string(24, static_cast<char>('a' + i % 26)));
+		strings.back()[23] = static_cast<char>('a' + i / 26 % 26);
+		handles.push_back(bench_handle<false>(static_cast<int>(i)));
+	}
+	vector_insert_erase_run("int", ints, ops);
+	vector_insert_erase_run("std::string", strings, ops);
+	vector_insert_erase_run("handle", handles, ops);
+}
+
+/////////////////////////////     vector_range_ops      /////////////////////////////
+
+// erase(first, last) e insert(position, k, val) de k elementos en mitad de un vector de n, con enteros y
+// con cadenas de 24 caracteres. Antes el erase borraba un elemento cada vez y el insert insertaba uno
+// cada vez, así que costaban O(k * n); ahora desplazan los de detrás una sola vez.
+
+template <class T>
+static void	vector_range_run(const char* what, const ft::vector<T>& src, size_t k, size_t reps)
+{
+	char			label[64];
+	ft::vector<T>	v(src);
+	double			t_erase = 0;
+	double			t_insert = 0;
+	double			t;
+
+	for (size_t r = 0; r < reps; r++)
+	{
+		size_t	pos = (v.size() - k) / 2 + r;
+
+		t = now_ms();
+		v.erase(v.begin() + pos, v.begin() + pos + k);
+		t_erase += now_ms() - t;
+		t = now_ms();
+		v.insert(v.begin() + pos, k, src[r]);
+		t_insert += now_ms() - t;
+		check(v.size() == src.size() && bench_get(v[pos]) == bench_get(src[r])
+			&& bench_get(v[pos + k]) == bench_get(src[pos + k]), "vector_range_ops values");
+	}
+	snprintf(label, sizeof(label), "%s: erase %lu", what, static_cast<unsigned long>(k));
+	report(label, t_erase, reps);
+	snprintf(label, sizeof(label), "%s: insert %lu copies", what, static_cast<unsigned long>(k));
+	report(label, t_insert, reps);
+}
+
+static void	bench_vector_range_ops(size_t n)
+{
+	ft::vector<int>			ints;
+	ft::vector<std::string>	strings;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		ints.push_back(static_cast<int>(i));
+		strings.push_back(std::string(24, static_cast<char>('a' + i % 26)));
+		strings.back()[23] = static_cast<char>('a' + i / 26 % 26);
+	}
+	vector_range_run("int", ints, 1000, 5);
+	vector_range_run("std::string", strings, 1000, 5);
+}
+
+/////////////////////////////     vector_from_range      /////////////////////////////
+
+// Construir un vector de n elementos a partir de un rango: de otro vector (acceso aleatorio), de un map
+// (bidireccional, con las claves desordenadas, que el árbol no se equilibra) y de un istream (input), contra lo que hacía antes el constructor, un push_back() por
+// elemento. Con el map se cuenta antes (dos recorridos) para reservar una sola vez, tanto con pares de
+// enteros como con cadenas. También assign() de un map
+// sobre un vector que ya tiene capacidad, que antes no compilaba con iteradores bidireccionales.
+
+template <class Vector, class Iterator>
+static void	from_range_run(const char* what, Iterator first, Iterator last, size_t n)
+{
+	char	label[64];
+	size_t	calls = g_alloc_calls;
+	double	t = now_ms();
+	Vector	pushed;
+
+	for (Iterator it = first; it != last; ++it)
+		pushed.push_back(*it);
+	snprintf(label, sizeof(label), "%s: push_back loop", what);
+	report(label, now_ms() - t, n);
+	std::cout << "    " << g_alloc_calls - calls << " allocations" << std::endl;
+
+	calls = g_alloc_calls;
+	t = now_ms();
+	Vector	built(first, last);
+	snprintf(label, sizeof(label), "%s: range constructor", what);
+	report(label, now_ms() - t, n);
+	std::cout << "    " << g_alloc_calls - calls << " allocations" << std::endl;
+	check(built.size() == n && built == pushed, "vector_from_range values");
+}
+
+static void	bench_vector_from_range(size_t n)
+{
+	typedef ft::pair<int, int>									pair_type;
+	typedef ft::vector<int, counting_allocator<int> >				int_vector;
+	typedef ft::vector<pair_type, counting_allocator<pair_type> >	pair_vector;
+
+	ft::vector<int>		src;
+	ft::map<int, int>	m;
+	std::string			text;
+	char				num[16];
+
+	for (size_t i = 0; i < n; i++)
+	{
+		src.push_back(static_cast<int>(i * 7));
+		m.insert(ft::make_pair(static_cast<int>(i * 2654435761u), static_cast<int>(i)));
+		snprintf(num, sizeof(num), "%d ", static_cast<int>(i));
+		text += num;
+	}
+	from_range_run<int_vector>("vector (random access)", src.begin(), src.end(), n);
+	from_range_run<pair_vector>("map (bidirectional)", m.begin(), m.end(), n);
+	{
+		typedef ft::pair<int, std::string>								spair_type;
+		typedef ft::vector<spair_type, counting_allocator<spair_type> >	spair_vector;
+
+		ft::map<int, std::string>	sm;
+		for (size_t i = 0; i < n / 4; i++)
+			sm.insert(ft::make_pair(static_cast<int>(i * 2654435761u), std::string(24, static_cast<char>('a' + i % 26))));
+		from_range_run<spair_vector>("map<int, string>", sm.begin(), sm.end(), n / 4);
+	}
+	{
+		std::istringstream	in1(text);
+		size_t				calls = g_alloc_calls;
+		double				t = now_ms();
+		int_vector			v((std::istream_iterator<int>(in1)), std::istream_iterator<int>());
+
+		report("istream (input): range constructor", now_ms() - t, n);
+		std::cout << "    " << g_alloc_calls - calls << " allocations" << std::endl;
+		check(v.size() == n && v[n - 1] == static_cast<int>(n - 1), "vector_from_range istream");
+	}
+
+	pair_vector	dst(m.begin(), m.end());
+	size_t		calls = g_alloc_calls;
+	double		t = now_ms();
+
+	for (int i = 0; i < 10; i++)
+		dst.assign(m.begin(), m.end());
+	report("map (bidirectional): assign x10", now_ms() - t, 10 * n);
+	std::cout << "    " << g_alloc_calls - calls << " allocations" << std::endl;
+	check(dst.size() == n && dst.front().first == m.begin()->first && dst.back().second == m.rbegin()->second, "vector_from_range assign");
+}
+
+/////////////////////////////     vector_assign      /////////////////////////////
+
+// Un vector de trabajo al que se le asigna en un bucle uno de 64 vectores de entre 0 y 256 elementos
+// escogido al azar (como el buffer que se reutiliza en cada petición), con enteros y con cadenas.
+// operator= reutiliza la capacidad que ya tiene en lugar de liberarla y reservar otra cada vez.
+
+template <class T>
+static void	vector_assign_run(const char* what, size_t n)
+{
+	typedef ft::vector<T, counting_allocator<T> >	vector_type;
+
+	char						label[64];
+	ft::vector<vector_type>		sources(64);
+	vector_type					scratch;
+	size_t						calls;
+	long						sum = 0;
+	double						t;
+
+	srand(5);
+	for (size_t i = 0; i < sources.size(); i++)
+		for (size_t j = rand() % 257; j > 0; j--)
+			sources[i].push_back(bench_make<T>(rand() % 1000));
+	calls = g_alloc_calls;
+	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+	{
+		const vector_type&	src = sources[rand() % sources.size()];
+
+		scratch = src;
+		sum += scratch.size();
+		if (!scratch.empty())
+			check(bench_get(scratch.back()) == bench_get(src.back()), "vector_assign values");
+	}
+	snprintf(label, sizeof(label), "%s: operator=", what);
+	report(label, now_ms() - t, n);
+	std::cout << "    " << g_alloc_calls - calls << " allocations, " << sum / n << " elements/assignment" << std::endl;
+}
+
+template <>
+std::string	bench_make<std::string>(int x)
+{
+	char	buf[32];
+
+	snprintf(buf, sizeof(buf), "value number %08d", x);
+	return (std::string(buf));
+}
+
+static void	bench_vector_assign(size_t n)
+{
+	vector_assign_run<int>("int", n);
+	vector_assign_run<std::string>("std::string", n);
+}
+
+/////////////////////////////     vector_resize      /////////////////////////////
+
+// resize() de un vector de enteros a n elementos, vacío y con la capacidad ya reservada (antes era un
+// push_back() por elemento, y además resize() reservaba otro bloque aunque cupieran), y leer
+// n bytes de /dev/zero en bloques de 64 KiB a un vector<char>: ampliándolo con resize(), que primero
+// escribe ceros en cada bloque, y con append_default_init(), que lo deja sin tocar para el read().
+
+static void	vector_read_run(const char* what, size_t n, bool default_init)
+{
+	const size_t		chunk = 65536;
+	ft::vector<char>	buf;
+	int					fd = open("/dev/zero", O_RDONLY);
+	double				t;
+
+	check(fd >= 0, "open /dev/zero");
+	t = now_ms();
+	while (buf.size() < n)
+	{
+		size_t	old_size = buf.size();
+		char*	dst;
+		ssize_t	r;
+
+		if (default_init)
+			dst = buf.append_default_init(chunk);
+		else
+		{
+			buf.resize(old_size + chunk);
+			dst = &buf[old_size];
+		}
+		r = read(fd, dst, chunk);
+		check(r == static_cast<ssize_t>(chunk), "read /dev/zero");
+	}
+	report(what, now_ms() - t, n / chunk);
+	close(fd);
+	check(buf[n / 2] == 0, "vector_resize read");
+}
+
+static void	bench_vector_resize(size_t n)
+{
+	{
+		ft::vector<int>	v;
+		double			t = now_ms();
+
+		v.resize(n, 7);
+		report("resize(n, 7) from empty", now_ms() - t, n);
+		check(v.size() == n && v[n - 1] == 7, "vector_resize values");
+		t = now_ms();
+		for (int i = 0; i < 5; i++)
+		{
+			v.resize(0);
+			v.resize(n, i);
+		}
+		report("resize(0) + resize(n, i) x5", now_ms() - t, 5 * n);
+		check(v.size() == n && v[n - 1] == 4, "vector_resize values");
+	}
+	{
+		ft::vector<int>	v;
+		double			t = now_ms();
+
+		for (size_t i = 0; i < n; i++)
+			v.push_back(7);
+		report("push_back(7) x n", now_ms() - t, n);
+	}
+	vector_read_run("read(): resize + read", 4 * n, false);
+	vector_read_run("read(): append_default_init + read", 4 * n, true);
+}
+
+/////////////////////////////     small_vector      /////////////////////////////
+
+// n vectores cortos, de 0 a max_len enteros al azar, que se crean, se llenan con push_back(), se recorren y
+// se destruyen (como los temporales de una función que se llama muchas veces), con ft::vector y con
+// small_vector de 8 elementos dentro. Con max_len = 8 todos caben dentro y small_vector no reserva nada;
+// con max_len = 16 la mitad se sale y reserva una vez (ft::vector reserva de 1 a 5 veces cada uno).
+// Después lo mismo con una pila de profundidad corta sobre cada uno.
+
+template <class Vector>
+static void	short_vector_run(const char* what, size_t n, size_t max_len)
+{
+	char	label[64];
+	size_t	calls = g_alloc_calls;
+	long	sum = 0;
+	double	t;
+
+	srand(11);
+	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+	{
+		Vector	v;
+		size_t	len = rand() % (max_len + 1);
+
+		for (size_t j = 0; j < len; j++)
+			v.push_back(static_cast<int>(i + j));
+		for (typename Vector::const_iterator it = v.begin(); it != v.end(); ++it)
+			sum += *it;
+	}
+	snprintf(label, sizeof(label), "%s, 0-%lu elements", what, static_cast<unsigned long>(max_len));
+	report(label, now_ms() - t, n);
+	std::cout << "    " << g_alloc_calls - calls << " allocations, sum " << sum << std::endl;
+}
+
+template <class Container>
+static void	short_stack_run(const char* what, size_t n)
+{
+	char	label[64];
+	size_t	calls = g_alloc_calls;
+	long	sum = 0;
+	double	t;
+
+	srand(11);
+	t = now_ms();
+	for (size_t i = 0; i < n; i++)
+	{
+		ft::stack<int, Container>	s;
+
+		for (size_t j = rand() % 7; j > 0; j--)
+			s.push(static_cast<int>(j));
+		for (; !s.empty(); s.pop())
+			sum += s.top();
+	}
+	snprintf(label, sizeof(label), "%s: stack, 0-6 elements", what);
+	report(label, now_ms() - t, n);
+	std::cout << "    " << g_alloc_calls - calls << " allocations, sum " << sum << std::endl;
+}
+
+static void	bench_small_vector(size_t n)
+{
+	typedef ft::vector<int, counting_allocator<int> >			vector_type;
+	typedef ft::small_vector<int, 8, counting_allocator<int> >	small_type;
+
+	std::cout << "  sizeof: ft::vector<int> " << sizeof(vector_type) << ", small_vector<int, 8> "
+		<< sizeof(small_type) << std::endl;
+	short_vector_run<vector_type>("ft::vector", n, 8);
+	short_vector_run<small_type>("small_vector<8>", n, 8);
+	short_vector_run<vector_type>("ft::vector", n, 16);
+	short_vector_run<small_type>("small_vector<8>", n, 16);
+	short_stack_run<vector_type>("ft::vector", n);
+	short_stack_run<small_type>("small_vector<8>", n);
+}
+
+/////////////////////////////     vector_shrink      /////////////////////////////
+
+// Un vector de trabajo que en un pico llega a n enteros, se vacía con pop_back() hasta n / 1000 y sigue
+// trabajando con ese tamaño (n push_back() y pop_back() alternados): cuánta memoria se queda ocupada
+// después del pico con la política por defecto, llamando a shrink_to_fit() al acabar el pico y con
+// shrinking_growth_policy. Y para ver que la histéresis no deja que reserve en cada paso, el mismo vector
+// subiendo y bajando un elemento justo en el límite donde se reduce (un cuarto de la capacidad), y como
+// una cola de trabajo que se llena con 64 elementos y se vacía con clear() una y otra vez.
+
+template <class Growth>
+static void	vector_spike_run(const char* what, size_t n, bool shrink_to_fit)
+{
+	ft::vector<int, counting_allocator<int>, Growth>	v;
+	char												label[64];
+	size_t												calls;
+	size_t												peak;
+	double												t;
+
+	for (size_t i = 0; i < n; i++)
+		v.push_back(static_cast<int>(i));
+	peak = g_live_bytes;
+	calls = g_alloc_calls;
+	t = now_ms();
+	while (v.size() > n / 1000)
+		v.pop_back();
+	if (shrink_to_fit)
+		v.shrink_to_fit();
+	for (size_t i = 0; i < n; i++)
+	{
+		v.push_back(static_cast<int>(i));
+		v.pop_back();
+	}
+	snprintf(label, sizeof(label), "%s: drain + steady", what);
+	report(label, now_ms() - t, 2 * n);
+	std::cout << "    peak " << peak / 1024 << " KiB, after " << g_live_bytes / 1024 << " KiB ("
+		<< v.size() << " elements, capacity " << v.capacity() << "), " << g_alloc_calls - calls
+		<< " allocations" << std::endl;
+	check(v.size() == n / 1000 && v.back() == static_cast<int>(n / 1000 - 1), "vector_shrink values");
+}
+
+static void	bench_vector_shrink(size_t n)
+{
+	typedef ft::shrinking_growth_policy<>	shrink_policy;
+
+	vector_spike_run<ft::double_growth_policy>("default policy", n, false);
+	vector_spike_run<ft::double_growth_policy>("default + shrink_to_fit()", n, true);
+	vector_spike_run<shrink_policy>("shrinking_growth_policy<1, 4>", n, false);
+
+	ft::vector<int, counting_allocator<int>, shrink_policy>	v(1024, 1);
+	size_t													calls = g_alloc_calls;
+	double													t = now_ms();
+
+	v.resize(256);
+	for (size_t i = 0; i < n; i++)
+	{
+		v.pop_back();
+		v.push_back(2);
+		v.push_back(3);
+		v.pop_back();
+	}
+	report("shrinking_growth_policy: +-1 at the 1/4 boundary", now_ms() - t, 4 * n);
+	std::cout << "    " << g_alloc_calls - calls << " allocations, capacity " << v.capacity() << std::endl;
+	check(v.size() == 256 && v.back() == 2, "vector_shrink boundary");
+
+	calls = g_alloc_calls;
+	t = now_ms();
+	for (size_t i = 0; i < n / 64; i++)
+	{
+		v.clear();
+		for (int j = 0; j < 64; j++)
+			v.push_back(j);
+	}
+	report("shrinking_growth_policy: fill 64 + clear()", now_ms() - t, n / 64 * 65);
+	std::cout << "    " << g_alloc_calls - calls << " allocations, capacity " << v.capacity() << std::endl;
+	check(v.size() == 64 && v.back() == 63, "vector_shrink clear");
+}
+
+/////////////////////////////////     Main      //////////////////////////////////
+
+struct bench_entry
+{
+	const char*	name;
+	void		(*run)(size_t);
+	size_t		default_n;
+};
+
+static const bench_entry	g_benches[] =
+{
+	{"eytzinger", bench_eytzinger, 10000000},
+	{"snapshot", bench_snapshot, 2000000},
+	{"set_memory", bench_set_memory, 1000000},
+	{"tree_stats", bench_tree_stats, 1000000},
+	{"build_parallel", bench_build_parallel, 2000000},
+	{"parallel_reduce", bench_parallel_reduce, 10000000},
+	{"map_algebra", bench_map_algebra, 1000000},
+	{"comparisons", bench_comparisons, 1000000},
+	{"small_map", bench_small_map, 1000000},
+	{"key_prefix", bench_key_prefix, 1000000},
+	{"map_footprint", bench_map_footprint, 10000000},
+	{"radix_map", bench_radix_map, 1000000},
+	{"splay", bench_splay, 1000000},
+	{"compact", bench_compact, 5000000},
+	{"finger", bench_finger, 1000000},
+	{"vector_copy", bench_vector_copy, 5000000},
+	{"vector_relocate", bench_vector_relocate, 1000000},
+	{"vector_growth", bench_vector_growth, 20000000},
+	{"vector_insert_erase", bench_vector_insert_erase, 100000},
+	{"vector_range_ops", bench_vector_range_ops, 100000},
+	{"vector_from_range", bench_vector_from_range, 1000000},
+	{"vector_assign", bench_vector_assign, 1000000},
+	{"vector_resize", bench_vector_resize, 50000000},
+	{"small_vector", bench_small_vector, 5000000},
+	{"vector_shrink", bench_vector_shrink, 50000000},
+};
+
+int main(int argc, char** argv)
+{
+	const size_t	count = sizeof(g_benches) / sizeof(g_benches[0]);
+	bool			found = false;
+
+	srand(42);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (argc > 1 && strcmp(argv[1], g_benches[i].name) != 0)
+			continue ;
+		size_t	n = (argc > 2 ? strtoul(argv[2], NULL, 10) : g_benches[i].default_n);
+		std::cout << g_benches[i].name << " (n = " << n << ")" << std::endl;
+		g_benches[i].run(n);
+		found = true;
+	}
+	if (!found)
+	{
+		std::cerr << "Usage: ./ft_containers_bench [name] [n]" << std::endl << "Benchmarks:";
+		for (size_t i = 0; i < count; i++)
+			std::cerr << " " << g_benches[i].name;
+		std::cerr << std::endl;
+		return (1);
+	}
+	return (0);
+}
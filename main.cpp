@@ -1,13 +1,30 @@
+// Las pruebas llevan siempre los contadores de map::stats() (ver Map/tree_stats.hpp), para poder
+// comprobarlos. Tiene que estar antes de incluir los contenedores.
+
+#define FT_TREE_STATS
+
 #include "Vector/vector.hpp"
 #include "Stack/stack.hpp"
 #include "Map/map.hpp"
+#include "Map/multimap.hpp"
+#include "Set/set.hpp"
+#include "Set/multiset.hpp"
 
 #include <vector>
 #include <stack>
 #include <map>
+#include <set>
 #include <iostream>
 #include <list>
 #include <queue>
+#include <string>
+#include <cstdlib>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
 
 #ifndef NS
 # define NS ft
@@ -16,6 +33,633 @@
 #define STR(X) #X
 #define ASSTR(X) STR(X)
 
+// Lo que solo existe en ft (radix_map, small_vector, compact(), finger...) se prueba igual que lo demás:
+// con NS=std se usa en su lugar lo equivalente de la stl, y las dos salidas tienen que coincidir.
+// IS_FT es 1 si NS es ft. FT_ONLY(X) es X con ft y true con std, para lo que solo se puede comprobar
+// en ft (por ejemplo, que los elementos están dentro del objeto): con std siempre imprime 1.
+
+#define CAT(A, B) A ## B
+#define XCAT(A, B) CAT(A, B)
+#define IS_FT_ft 1
+#define IS_FT XCAT(IS_FT_, NS)
+
+#if IS_FT
+# include "Map/radix_map.hpp"
+# include "Map/map_algebra.hpp"
+# include "Vector/small_vector.hpp"
+# include "Map/eytzinger_index.hpp"
+# include "Map/map_snapshot.hpp"
+# include "Map/map_parallel.hpp"
+# define RADIX_MAP(K, T)	ft::radix_map<K, T>
+# define SMALL_VECTOR(T, N)	ft::small_vector<T, N>
+# define SHRINKING_VECTOR(T, Base)	ft::vector<T, std::allocator<T>, ft::shrinking_growth_policy<1, 4, Base> >
+# define PREFIX_LESS(K)		ft::prefix_less<K>
+# define GROWTH_VECTOR(T, Growth)	ft::vector<T, std::allocator<T>, Growth>
+# define REALLOC_VECTOR(T)	ft::vector<T, ft::realloc_allocator<T>, ft::page_growth_policy>
+# define POLICY_MAP(K, T, Policy)	ft::map<K, T, std::less<K>, std::allocator<ft::node<ft::pair<const K, T> > >, 0, Policy>
+# define INLINE_MAP(K, T, N)	ft::map<K, T, std::less<K>, std::allocator<ft::node<ft::pair<const K, T> > >, N>
+# define FT_ONLY(X)			(X)
+#else
+# define RADIX_MAP(K, T)	std::map<K, T>
+# define SMALL_VECTOR(T, N)	std::vector<T>
+# define SHRINKING_VECTOR(T, Base)	std::vector<T>
+# define PREFIX_LESS(K)		std::less<K>
+# define GROWTH_VECTOR(T, Growth)	std::vector<T>
+# define REALLOC_VECTOR(T)	std::vector<T>
+# define POLICY_MAP(K, T, Policy)	std::map<K, T>
+# define INLINE_MAP(K, T, N)	std::map<K, T>
+# define FT_ONLY(X)			true
+#endif
+
+// Con std, un eytzinger_index es un vector ordenado con búsqueda binaria: las posiciones que devuelve
+// son las mismas
+
+#if IS_FT
+# define EYTZINGER_INDEX(K)	ft::eytzinger_index<K>
+#else
+template <class Key>
+class std_eytzinger
+{
+	private:
+		std::vector<Key>	_keys;
+
+	public:
+		explicit std_eytzinger(const std::vector<Key>& sorted) :
+			_keys(sorted)
+		{}
+
+		template <class Map>
+		explicit std_eytzinger(const Map& m)
+		{
+			for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+				this->_keys.push_back(it->first);
+		}
+
+		size_t size(void) const
+		{
+			return (this->_keys.size());
+		}
+
+		size_t lower_bound(const Key& k) const
+		{
+			return (std::lower_bound(this->_keys.begin(), this->_keys.end(), k) - this->_keys.begin());
+		}
+
+		size_t upper_bound(const Key& k) const
+		{
+			return (std::upper_bound(this->_keys.begin(), this->_keys.end(), k) - this->_keys.begin());
+		}
+
+		void lower_bound(const Key* first, const Key* last, size_t* out) const
+		{
+			for (; first != last; ++first)
+				*out++ = this->lower_bound(*first);
+		}
+
+		size_t count(const Key& k) const
+		{
+			return (std::binary_search(this->_keys.begin(), this->_keys.end(), k) ? 1 : 0);
+		}
+
+		const Key& key(size_t rank) const
+		{
+			return (this->_keys[rank]);
+		}
+};
+# define EYTZINGER_INDEX(K)	std_eytzinger<K>
+#endif
+
+// map::build_parallel() deja lo mismo que vaciar el mapa e insertar los elementos uno a uno, que es lo
+// que se hace con std
+
+#if IS_FT
+template <class Map, class Iterator>
+static void build_parallel(Map& m, Iterator first, Iterator last, size_t threads)
+{
+	m.build_parallel(first, last, threads);
+}
+#else
+template <class Map, class Iterator>
+static void build_parallel(Map& m, Iterator first, Iterator last, size_t)
+{
+	m.clear();
+	m.insert(first, last);
+}
+#endif
+
+// Con std, parallel_for_each() y parallel_reduce() recorren el mapa en orden en un solo hilo. Con ft se
+// llaman sin ft:: y las encuentra por los argumentos.
+
+#if !IS_FT
+template <class Map, class Function>
+static void parallel_for_each(Map& m, Function f, size_t)
+{
+	std::for_each(m.begin(), m.end(), f);
+}
+
+template <class Map, class Result, class Op>
+static Result parallel_reduce(const Map& m, Result init, Op op, size_t)
+{
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		init = op(init, *it);
+	return (init);
+}
+#endif
+
+// Para parallel_for_each(): dobla el valor de cada elemento
+
+struct double_value
+{
+	template <class Pair>
+	void operator() (Pair& p) const
+	{
+		p.second *= 2;
+	}
+};
+
+// Para parallel_reduce(): suma los valores, y junta las claves en orden (que no es conmutativo)
+
+struct sum_values
+{
+	template <class Pair>
+	long operator() (long acc, const Pair& p) const
+	{
+		return (acc + p.second);
+	}
+
+	long operator() (long a, long b) const
+	{
+		return (a + b);
+	}
+};
+
+struct join_keys
+{
+	template <class Pair>
+	std::string operator() (const std::string& acc, const Pair& p) const
+	{
+		std::ostringstream	o;
+
+		o << acc << p.first << ' ';
+		return (o.str());
+	}
+
+	std::string operator() (const std::string& a, const std::string& b) const
+	{
+		return (a + b);
+	}
+};
+
+// Los contadores de stats() solo existen en ft: las comprobaciones van dentro de FT_ONLY(), y con std
+// reset_stats() no hace nada
+
+#if IS_FT
+template <class Map>
+static void reset_stats(Map& m)
+{
+	m.reset_stats();
+}
+
+// Si el histograma cuenta las mismas búsquedas que lookups, y como mucho los nodos visitados (el último
+// cubo junta las búsquedas más largas)
+
+static bool histogram_consistent(const ft::tree_stats& s)
+{
+	size_t	lookups = 0;
+	size_t	visited = 0;
+
+	for (size_t i = 0; i < ft::tree_stats::buckets; i++)
+	{
+		lookups += s.histogram[i];
+		visited += s.histogram[i] * i;
+	}
+	return (lookups == s.lookups && visited <= s.visited);
+}
+#else
+template <class Map>
+static void reset_stats(Map&)
+{}
+#endif
+
+// Con std, save_map() guarda el mapa como texto (detrás de la misma marca que usa ft al principio del
+// fichero), load_map() lo vuelve a leer y map_snapshot es un std::map cargado del fichero. Los errores son
+// también std::runtime_error.
+
+#if IS_FT
+# define MAP_SNAPSHOT(K, T)	ft::map_snapshot<K, T>
+#else
+template <class Map>
+static void save_map(const Map& src, const char* path)
+{
+	std::ofstream	out(path);
+
+	out << "FTMAPSN1\n";
+	for (typename Map::const_iterator it = src.begin(); it != src.end(); ++it)
+		out << it->first << ' ' << it->second << '\n';
+	if (!out)
+		throw std::runtime_error("save_map: write failed");
+}
+
+template <class Map>
+static void load_map(Map& dst, const char* path)
+{
+	std::ifstream					in(path);
+	std::string						magic;
+	typename Map::key_type			k;
+	typename Map::mapped_type		v;
+
+	if (!in)
+		throw std::runtime_error("load_map: cannot open file");
+	if (!std::getline(in, magic) || magic != "FTMAPSN1")
+		throw std::runtime_error("load_map: bad header");
+	dst.clear();
+	while (in >> k >> v)
+		dst.insert(std::make_pair(k, v));
+}
+
+template <class Key, class T>
+class std_snapshot : public std::map<Key, T>
+{
+	public:
+		explicit std_snapshot(const char* path)
+		{
+			load_map(*this, path);
+		}
+};
+# define MAP_SNAPSHOT(K, T)	std_snapshot<K, T>
+#endif
+
+// map::compact() no cambia el contenido del mapa, así que con std no hace nada
+
+#if IS_FT
+template <class Map>
+static void compact_map(Map& m)
+{
+	m.compact();
+}
+#else
+template <class Map>
+static void compact_map(Map&)
+{}
+#endif
+
+// vector::resize_default_init() deja sin inicializar los elementos nuevos de tipos triviales: con std se
+// usa resize(), y solo se imprimen los elementos que ya estaban
+
+#if IS_FT
+template <class Vector>
+static void resize_default_init(Vector& v, typename Vector::size_type n)
+{
+	v.resize_default_init(n);
+}
+#else
+template <class Vector>
+static void resize_default_init(Vector& v, typename Vector::size_type n)
+{
+	v.resize(n);
+}
+#endif
+
+// vector::shrink_to_fit() es de C++11: con std se copia el vector y se cambia por la copia, que tiene la
+// capacidad justa
+
+#if IS_FT
+template <class Vector>
+static void shrink_vector(Vector& v)
+{
+	v.shrink_to_fit();
+}
+#else
+template <class Vector>
+static void shrink_vector(Vector& v)
+{
+	Vector(v).swap(v);
+}
+#endif
+
+// Con std, las operaciones de map_algebra.hpp son std::set_union, std::set_intersection y
+// std::set_difference sobre los dos mapas (que también se quedan con el elemento del primero si la clave
+// está en los dos). Con ft se llaman sin ft:: y las encuentra por los argumentos.
+
+#if !IS_FT
+template <class Map>
+static Map map_union(const Map& a, const Map& b)
+{
+	Map	ret;
+
+	std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::inserter(ret, ret.end()), a.value_comp());
+	return (ret);
+}
+
+template <class Map>
+static Map map_intersection(const Map& a, const Map& b)
+{
+	Map	ret;
+
+	std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::inserter(ret, ret.end()), a.value_comp());
+	return (ret);
+}
+
+template <class Map>
+static Map map_difference(const Map& a, const Map& b)
+{
+	Map	ret;
+
+	std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::inserter(ret, ret.end()), a.value_comp());
+	return (ret);
+}
+
+template <class Map>
+static void map_union_inplace(Map& a, const Map& b)
+{
+	Map	ret(map_union(a, b));
+
+	a.swap(ret);
+}
+
+template <class Map>
+static void map_intersection_inplace(Map& a, const Map& b)
+{
+	Map	ret(map_intersection(a, b));
+
+	a.swap(ret);
+}
+
+template <class Map>
+static void map_difference_inplace(Map& a, const Map& b)
+{
+	Map	ret(map_difference(a, b));
+
+	a.swap(ret);
+}
+#endif
+
+// Con std, un map::finger que busca desde la raíz cada vez
+
+#if IS_FT
+# define MAP_FINGER(M)		M::finger
+#else
+template <class Map>
+class std_finger
+{
+	private:
+		Map*	_map;
+
+	public:
+		explicit std_finger(Map& m) :
+			_map(&m)
+		{}
+
+		typename Map::iterator find(const typename Map::key_type& k)
+		{
+			return (this->_map->find(k));
+		}
+
+		typename Map::iterator lower_bound(const typename Map::key_type& k)
+		{
+			return (this->_map->lower_bound(k));
+		}
+
+		void reset(void)
+		{}
+};
+# define MAP_FINGER(M)		std_finger<M>
+#endif
+
+// Las claves de std::string se imprimen con los bytes que no son letras en hexadecimal, para que se vean
+// los \0 y los 0xff
+
+static void print_key(const std::string& k)
+{
+	static const char	hex[] = "0123456789abcdef";
+
+	std::cout << '"';
+	for (size_t i = 0; i < k.size(); i++)
+	{
+		unsigned char	c = k[i];
+
+		if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '/')
+			std::cout << c;
+		else
+			std::cout << "\\x" << hex[c >> 4] << hex[c & 15];
+	}
+	std::cout << '"';
+}
+
+// Si los elementos de un vector (que no esté vacío) están dentro del propio objeto
+
+template <class Vector>
+static bool in_object(const Vector& v)
+{
+	const char*	p = reinterpret_cast<const char*>(&v.front());
+	const char*	o = reinterpret_cast<const char*>(&v);
+
+	return (p >= o && p < o + sizeof(v));
+}
+
+// Si, al llenar v con n push_back(), cada vez que cambia la capacidad es a la que pide Growth (solo se
+// usa dentro de FT_ONLY(): con std la capacidad es la que decida la stl)
+
+template <class Growth, class Vector>
+static bool follows_growth(Vector& v, int n)
+{
+	bool	ok = true;
+
+	for (int i = 0; i < n; i++)
+	{
+		size_t	cap = v.capacity();
+
+		v.push_back(typename Vector::value_type());
+		if (v.capacity() != cap)
+			ok = ok && v.capacity() == Growth::next_capacity(cap, cap + 1, sizeof(typename Vector::value_type));
+	}
+	return (ok);
+}
+
+// Si todos los elementos de un mapa están dentro del propio objeto
+
+template <class Map>
+static bool map_in_object(const Map& m)
+{
+	const char*	o = reinterpret_cast<const char*>(&m);
+
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+	{
+		const char*	p = reinterpret_cast<const char*>(&*it);
+
+		if (p < o || p >= o + sizeof(m))
+			return (false);
+	}
+	return (true);
+}
+
+// Un struct que se copia byte a byte, con relleno entre sus miembros
+
+struct point
+{
+	char	tag;
+	int		x;
+	double	y;
+};
+
+static point make_point(char tag, int x, double y)
+{
+	point	p;
+
+	p.tag = tag;
+	p.x = x;
+	p.y = y;
+	return (p);
+}
+
+static bool operator== (const point& a, const point& b)
+{
+	return (a.tag == b.tag && a.x == b.x && a.y == b.y);
+}
+
+static bool operator< (const point& a, const point& b)
+{
+	return (a.x < b.x || (a.x == b.x && a.tag < b.tag));
+}
+
+static std::ostream& operator<< (std::ostream& o, const point& p)
+{
+	return (o << p.tag << p.x << '/' << p.y);
+}
+
+// Guarda su valor en memoria propia y cuenta cuántos hay vivos. Solo apunta fuera de sí mismo, así que se
+// puede mover por bytes (ver common/is_trivially_relocatable.hpp), y se marca como tal
+
+struct boxed
+{
+	static long	live;
+	int*		value;
+
+	boxed(int v = 0) :
+		value(new int(v))
+	{
+		++live;
+	}
+
+	boxed(const boxed& src) :
+		value(new int(*src.value))
+	{
+		++live;
+	}
+
+	boxed& operator=(const boxed& src)
+	{
+		*this->value = *src.value;
+		return (*this);
+	}
+
+	~boxed(void)
+	{
+		delete this->value;
+		--live;
+	}
+};
+
+long	boxed::live = 0;
+
+static std::ostream& operator<< (std::ostream& o, const boxed& b)
+{
+	return (o << *b.value);
+}
+
+namespace ft
+{
+	template <>
+	struct is_trivially_relocatable<boxed>
+	{
+		static const bool value = true;
+	};
+}
+
+// Se apunta a sí mismo, así que no se puede mover por bytes: ok() deja de ser true si alguien lo hace
+
+struct anchored
+{
+	const anchored*	self;
+	int				value;
+
+	anchored(int v = 0) :
+		self(this),
+		value(v)
+	{}
+
+	anchored(const anchored& src) :
+		self(this),
+		value(src.value)
+	{}
+
+	anchored& operator=(const anchored& src)
+	{
+		this->value = src.value;
+		return (*this);
+	}
+
+	bool ok(void) const
+	{
+		return (this->self == this);
+	}
+};
+
+// Cuenta las copias que se hacen de él, para comprobar que algo copia cada valor una sola vez
+
+struct copy_counter
+{
+	static size_t	copies;
+	int				value;
+
+	copy_counter(int v = 0) :
+		value(v)
+	{}
+
+	copy_counter(const copy_counter& src) :
+		value(src.value)
+	{
+		++copies;
+	}
+
+	copy_counter& operator=(const copy_counter& src)
+	{
+		this->value = src.value;
+		return (*this);
+	}
+};
+
+size_t	copy_counter::copies = 0;
+
+// Imprime el tamaño de un mapa de ints, sus primeros elementos y una suma de todos que depende del orden
+
+template <class Map>
+static void print_map_sum(const char* name, const Map& m)
+{
+	long	sum = 0;
+	long	i = 0;
+
+	std::cout << name << " (" << m.size() << "):";
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it, ++i)
+	{
+		sum += (i + 1) * (static_cast<long>(it->first) * 3 + it->second);
+		if (i < 8)
+			std::cout << ' ' << it->first << '=' << it->second;
+	}
+	std::cout << (i > 8 ? " ..." : "") << " sum " << sum << std::endl;
+}
+
+// Imprime el tamaño y los elementos de un vector (de ints o de strings)
+
+template <class Vector>
+static void print_vector(const char* name, const Vector& v)
+{
+	std::cout << name << " (" << v.size() << "):";
+	for (typename Vector::const_iterator it = v.begin(); it != v.end(); ++it)
+		std::cout << ' ' << *it;
+	std::cout << std::endl;
+}
+
 int main()
 {
 	std::cout << "Testing " << ASSTR(NS) << " containers" << std::endl << std::endl;
@@ -55,6 +699,23 @@ int main()
 		std::cout << std::endl;
 	}
 
+	{
+		std::cout << "\n---------- FT Vector (empty fill constructor) ----------" << std::endl;
+		// Con n = 0 no se debe reservar nada: antes se reservaba un bloque que el destructor no liberaba
+		// (se ve compilando con -fsanitize=address)
+		for (int i = 0; i < 3; i++)
+		{
+			NS::vector<int> none(0, 42);
+			NS::vector<int> copy(none);
+			std::cout << "none: size " << none.size() << ", capacity " << none.capacity()
+				<< ", empty " << none.empty() << std::endl;
+			std::cout << "copy: size " << copy.size() << ", capacity " << copy.capacity() << std::endl;
+		}
+		NS::vector<int> none(0);
+		none.push_back(7);
+		std::cout << "after push_back: size " << none.size() << ", front " << none.front() << std::endl;
+	}
+
 	{
 		std::cout << "\n------------- FT Vector (operator=)-------------" << std::endl;
 		NS::vector<int> foo(3, 100);
@@ -558,7 +1219,598 @@ int main()
 			std::cout << "foo is greater than or equal to baz" << std::endl;
 	}
 
-	std::cout << "\n\n\n*************************************************************************" << std::endl;
+	{
+		std::cout << "\n------------- FT Vector (insert & erase one element) -------------" << std::endl;
+
+		NS::vector<int>					v;
+		NS::vector<int>::iterator		it;
+
+		for (int i = 0; i < 8; i++)
+			v.push_back(i * 10);
+		v.reserve(20);
+		it = v.insert(v.begin() + 2, v[5]);
+		std::cout << "inserted " << *it << " at " << it - v.begin() << std::endl;
+		it = v.insert(v.begin(), v.back());
+		std::cout << "inserted " << *it << " at " << it - v.begin() << std::endl;
+		it = v.insert(v.end(), v.front());
+		std::cout << "inserted " << *it << " at " << it - v.begin() << std::endl;
+		print_vector("v", v);
+		it = v.erase(v.begin() + 3);
+		std::cout << "after erase " << *it << " at " << it - v.begin() << std::endl;
+		it = v.erase(v.begin());
+		std::cout << "after erase " << *it << " at " << it - v.begin() << std::endl;
+		it = v.erase(v.end() - 1);
+		std::cout << "erase last returns end: " << (it == v.end()) << std::endl;
+		print_vector("v", v);
+		std::cout << "capacity: " << v.capacity() << std::endl;
+
+		NS::vector<std::string>				s(5, "abc");
+		NS::vector<std::string>::iterator	sit;
+
+		s[1] = "defghijklmnopqrstuvwxyz";
+		s[3] = "x";
+		std::cout << "full: " << (s.size() == s.capacity()) << std::endl;
+		sit = s.insert(s.begin() + 2, s[1]);
+		std::cout << "inserted " << *sit << " at " << sit - s.begin() << std::endl;
+		sit = s.insert(s.begin() + 1, s[3]);
+		std::cout << "inserted " << *sit << " at " << sit - s.begin() << std::endl;
+		sit = s.insert(s.end(), s[0]);
+		std::cout << "inserted " << *sit << " at " << sit - s.begin() << std::endl;
+		print_vector("s", s);
+		sit = s.erase(s.begin() + 1);
+		std::cout << "after erase " << *sit << " at " << sit - s.begin() << std::endl;
+		sit = s.erase(s.end() - 2);
+		std::cout << "after erase " << *sit << " at " << sit - s.begin() << std::endl;
+		while (!s.empty())
+			s.erase(s.begin());
+		print_vector("s", s);
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (fill insert & range erase) -------------" << std::endl;
+
+		NS::vector<std::string>				s;
+		NS::vector<std::string>::iterator	it;
+
+		for (int i = 0; i < 6; i++)
+			s.push_back(std::string(i + 1, 'a' + i));
+		s.reserve(30);
+		s.insert(s.begin() + 4, 5, s[1]);
+		print_vector("s", s);
+		s.insert(s.begin() + 1, 2, s.back());
+		print_vector("s", s);
+		s.insert(s.begin() + 3, 0, std::string("zzz"));
+		s.insert(s.end(), 3, std::string("end"));
+		print_vector("s", s);
+		std::cout << "capacity: " << s.capacity() << std::endl;
+		s.insert(s.begin() + 2, 40, s[0]);
+		print_vector("s", s);
+
+		it = s.erase(s.begin() + 5, s.begin() + 5);
+		std::cout << "erased nothing at " << it - s.begin() << std::endl;
+		it = s.erase(s.begin() + 1, s.begin() + 30);
+		std::cout << "after erase " << *it << " at " << it - s.begin() << std::endl;
+		it = s.erase(s.begin(), s.begin() + 3);
+		std::cout << "after erase " << *it << " at " << it - s.begin() << std::endl;
+		it = s.erase(s.end() - 4, s.end());
+		std::cout << "erase tail returns end: " << (it == s.end()) << std::endl;
+		print_vector("s", s);
+		it = s.erase(s.begin(), s.end());
+		std::cout << "erase all returns end: " << (it == s.end()) << ", empty: " << s.empty() << std::endl;
+
+		NS::vector<int>		v(4, 7);
+
+		v.insert(v.begin() + 1, 6, 3);
+		v.insert(v.begin() + 9, 1, v[1]);
+		v.insert(v.begin(), 2, v[9]);
+		print_vector("v", v);
+		v.erase(v.begin() + 2, v.end() - 2);
+		print_vector("v", v);
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (ranges from other containers) -------------" << std::endl;
+
+		NS::map<int, int>	m;
+
+		for (int i = 0; i < 10; i++)
+			m[i * 3] = i * i;
+
+		NS::vector<NS::pair<int, int> >	pv(m.begin(), m.end());
+
+		std::cout << "pairs (" << pv.size() << "):";
+		for (size_t i = 0; i < pv.size(); i++)
+			std::cout << ' ' << pv[i].first << '=' << pv[i].second;
+		std::cout << std::endl;
+		pv.assign(m.find(9), m.find(21));
+		pv.insert(pv.begin() + 1, m.rbegin(), m.rend());
+		std::cout << "pairs (" << pv.size() << "):";
+		for (size_t i = 0; i < pv.size(); i++)
+			std::cout << ' ' << pv[i].first << '=' << pv[i].second;
+		std::cout << std::endl;
+
+		std::list<int>		l;
+
+		for (int i = 0; i < 7; i++)
+			l.push_back(100 - i);
+
+		NS::vector<int>		v(l.begin(), l.end());
+
+		print_vector("from list", v);
+		v.insert(v.begin() + 3, l.rbegin(), l.rend());
+		print_vector("from list", v);
+		v.assign(l.begin(), l.begin());
+		print_vector("from list", v);
+
+		std::istringstream				in("4 8 15 16 23 42");
+		NS::vector<int>					iv((std::istream_iterator<int>(in)), std::istream_iterator<int>());
+
+		print_vector("from istream", iv);
+		in.clear();
+		in.str("1 2 3");
+		iv.insert(iv.begin() + 2, std::istream_iterator<int>(in), std::istream_iterator<int>());
+		print_vector("from istream", iv);
+		in.clear();
+		in.str("-1 -2 -3 -4 -5 -6 -7 -8 -9 -10 -11 -12 -13 -14 -15 -16 -17 -18 -19 -20");
+		iv.insert(iv.end(), std::istream_iterator<int>(in), std::istream_iterator<int>());
+		print_vector("from istream", iv);
+		in.clear();
+		in.str("9 9 9");
+		iv.assign(std::istream_iterator<int>(in), std::istream_iterator<int>());
+		print_vector("from istream", iv);
+		std::cout << "capacity >= size: " << (iv.capacity() >= iv.size()) << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (insert a range of itself) -------------" << std::endl;
+
+		int					arr[] = {1, 2, 3, 4, 5};
+		NS::vector<int>		v(arr, arr + 5);
+
+		std::cout << "full: " << (v.size() == v.capacity()) << std::endl;
+		v.insert(v.end(), v.begin(), v.end());
+		print_vector("v", v);
+		v.insert(v.begin() + 2, v.begin() + 5, v.end());
+		print_vector("v", v);
+		v.reserve(100);
+		v.insert(v.begin() + 4, v.begin(), v.begin() + 3);
+		print_vector("v", v);
+		v.insert(v.end(), v.begin() + 1, v.end() - 1);
+		print_vector("v", v);
+
+		NS::vector<std::string>		s(3, "abcdefghijklmnopqrstuvwxyz");
+
+		s[1] = "x";
+		s.insert(s.begin() + 1, s.begin(), s.end());
+		print_vector("s", s);
+		s.reserve(50);
+		s.insert(s.begin() + 5, s.begin(), s.begin() + 4);
+		print_vector("s", s);
+		s.insert(s.end(), s.begin(), s.end());
+		print_vector("s", s);
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (operator= keeps the capacity) -------------" << std::endl;
+
+		NS::vector<std::string>		a(10, "abcdefghijklmnopqrstuvwxyz");
+		NS::vector<std::string>		b(3, "b");
+		NS::vector<std::string>		c;
+
+		a.reserve(40);
+		a = b;
+		print_vector("a", a);
+		std::cout << "capacity: " << a.capacity() << std::endl;
+		b.assign(25, "defghijklmnopqrstuvwxyz");
+		a = b;
+		print_vector("a", a);
+		std::cout << "capacity: " << a.capacity() << std::endl;
+		b.assign(50, "c");
+		a = b;
+		std::cout << "size: " << a.size() << ", capacity: " << a.capacity() << std::endl;
+		a = c;
+		std::cout << "size: " << a.size() << ", capacity: " << a.capacity() << std::endl;
+		c = a;
+		std::cout << "size: " << c.size() << ", capacity: " << c.capacity() << std::endl;
+		b = b;
+		std::cout << "size: " << b.size() << ", front: " << b.front() << std::endl;
+
+		NS::vector<int>		v(100, 1);
+		NS::vector<int>		w(60, 2);
+
+		v = w;
+		std::cout << "size: " << v.size() << ", capacity: " << v.capacity() << std::endl;
+		w.assign(80, 3);
+		v = w;
+		std::cout << "size: " << v.size() << ", capacity: " << v.capacity() << ", back: " << v.back() << std::endl;
+		w.assign(120, 4);
+		v = w;
+		std::cout << "size: " << v.size() << ", capacity: " << v.capacity() << ", back: " << v.back() << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (resize grow & shrink) -------------" << std::endl;
+
+		NS::vector<std::string>		s;
+		size_t						cap;
+
+		s.resize(4, "abcdefghijklmnopqrstuvwxyz");
+		print_vector("s", s);
+		s.resize(7);
+		s.resize(30, "x");
+		std::cout << "size: " << s.size() << ", capacity >= size: " << (s.capacity() >= s.size()) << std::endl;
+		std::cout << "s[3]: " << s[3] << ", s[5]: \"" << s[5] << "\", s[29]: " << s[29] << std::endl;
+		cap = s.capacity();
+		s.resize(5);
+		print_vector("s", s);
+		std::cout << "same capacity: " << (s.capacity() == cap) << std::endl;
+		s.resize(5, "y");
+		s.resize(cap, "z");
+		std::cout << "size: " << s.size() << ", same capacity: " << (s.capacity() == cap) << ", back: " << s.back() << std::endl;
+		s.resize(0);
+		std::cout << "size: " << s.size() << ", same capacity: " << (s.capacity() == cap) << std::endl;
+
+		NS::vector<int>		v(3, 5);
+
+		v.resize(1000, 6);
+		std::cout << "size: " << v.size() << ", v[2]: " << v[2] << ", v[3]: " << v[3] << ", v[999]: " << v[999] << std::endl;
+		v.resize(2);
+		print_vector("v", v);
+		v.resize(4);
+		print_vector("v", v);
+		resize_default_init(v, 2000);
+		std::cout << "size: " << v.size() << ", capacity >= size: " << (v.capacity() >= v.size()) << std::endl;
+		for (size_t i = 4; i < v.size(); i++)
+			v[i] = i;
+		resize_default_init(v, 10);
+		print_vector("v", v);
+	}
+
+	{
+		std::cout << "\n------------- FT small_vector -------------" << std::endl;
+
+		typedef SMALL_VECTOR(int, 4)			small_int;
+		typedef SMALL_VECTOR(std::string, 3)	small_str;
+
+		small_int	v;
+
+		for (int i = 1; i <= 4; i++)
+			v.push_back(i);
+		std::cout << "inline: " << FT_ONLY(in_object(v)) << std::endl;
+		v.push_back(5);
+		std::cout << "heap: " << FT_ONLY(!in_object(v)) << std::endl;
+		print_vector("v", v);
+		v.insert(v.begin() + 2, 10, 0);
+		v.erase(v.begin() + 1, v.end() - 1);
+		print_vector("v", v);
+
+		small_int	c(v);
+
+		std::cout << "copy inline: " << FT_ONLY(in_object(c)) << ", equal: " << (c == v) << std::endl;
+		c.assign(6, 7);
+		v = c;
+		std::cout << "assigned heap: " << FT_ONLY(!in_object(v)) << ", equal: " << (c == v) << std::endl;
+
+		small_str	a(2, "abcdefghijklmnopqrstuvwxyz");
+		small_str	b(3, "b");
+		small_str	h(10, "h");
+
+		a.swap(b);
+		std::cout << "inline <-> inline: " << FT_ONLY(in_object(a) && in_object(b)) << std::endl;
+		print_vector("a", a);
+		print_vector("b", b);
+		a.swap(h);
+		std::cout << "inline <-> heap: " << FT_ONLY(!in_object(a) && in_object(h)) << std::endl;
+		print_vector("a", a);
+		print_vector("h", h);
+		h.swap(a);
+		std::cout << "heap <-> inline: " << FT_ONLY(in_object(a) && !in_object(h)) << std::endl;
+		print_vector("a", a);
+		print_vector("h", h);
+		b.assign(5, "c");
+		b.swap(h);
+		std::cout << "heap <-> heap: " << FT_ONLY(!in_object(b) && !in_object(h)) << std::endl;
+		print_vector("b", b);
+		print_vector("h", h);
+		std::cout << "compare: " << (a < b) << (b < h) << (h == h) << std::endl;
+
+		NS::stack<int, small_int>	st;
+
+		for (int i = 0; i < 8; i++)
+			st.push(i * i);
+		while (st.size() > 2)
+			st.pop();
+		std::cout << "stack top: " << st.top() << ", size: " << st.size() << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (shrink_to_fit) -------------" << std::endl;
+
+		NS::vector<std::string>		s(100, "abcdefghijklmnopqrstuvwxyz");
+
+		s.resize(10);
+		shrink_vector(s);
+		std::cout << "size: " << s.size() << ", capacity: " << s.capacity() << ", back: " << s.back() << std::endl;
+		shrink_vector(s);
+		std::cout << "size: " << s.size() << ", capacity: " << s.capacity() << std::endl;
+		s.clear();
+		shrink_vector(s);
+		std::cout << "size: " << s.size() << ", capacity: " << s.capacity() << std::endl;
+		s.push_back("x");
+		print_vector("s", s);
+
+		typedef SMALL_VECTOR(std::string, 4)	small_str;
+
+		small_str	sv;
+
+		for (int i = 0; i < 30; i++)
+			sv.push_back(std::string(i + 1, 'a' + i % 26));
+		sv.resize(3);
+		shrink_vector(sv);
+		std::cout << "back inline: " << FT_ONLY(in_object(sv) && sv.capacity() == 4) << std::endl;
+		print_vector("sv", sv);
+		sv.push_back("dddd");
+		std::cout << "still inline: " << FT_ONLY(in_object(sv)) << std::endl;
+		sv.push_back("eeeee");
+		std::cout << "heap again: " << FT_ONLY(!in_object(sv)) << std::endl;
+		print_vector("sv", sv);
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (shrinking growth policy) -------------" << std::endl;
+
+		typedef SHRINKING_VECTOR(int, ft::double_growth_policy)					shrinking_int;
+		typedef SHRINKING_VECTOR(int, ft::min_capacity_growth_policy<16>)		shrinking_min16;
+
+		shrinking_int	v;
+		size_t			cap;
+		bool			stable;
+
+		for (int i = 0; i < 1000; i++)
+			v.push_back(i);
+		while (v.size() > 255)
+			v.pop_back();
+		std::cout << "shrunk: " << FT_ONLY(v.capacity() < 1000) << ", back: " << v.back() << std::endl;
+		cap = v.capacity();
+		stable = true;
+		for (int i = 0; i < 100; i++)
+		{
+			v.push_back(i);
+			v.push_back(i);
+			v.pop_back();
+			v.pop_back();
+			v.pop_back();
+			v.push_back(i);
+			stable = stable && v.capacity() == cap;
+		}
+		std::cout << "capacity stable where it shrank: " << stable << ", size: " << v.size() << std::endl;
+		while (v.size() > 127)
+			v.pop_back();
+		cap = v.capacity();
+		stable = true;
+		for (int i = 0; i < 100; i++)
+		{
+			v.push_back(i);
+			v.pop_back();
+			stable = stable && v.capacity() == cap;
+		}
+		std::cout << "capacity stable around 1/4: " << stable << ", size: " << v.size() << std::endl;
+		v.clear();
+		std::cout << "clear keeps capacity: " << (v.capacity() == cap) << std::endl;
+		stable = true;
+		for (int i = 0; i < 100; i++)
+		{
+			v.push_back(i);
+			v.pop_back();
+			stable = stable && v.capacity() == cap;
+		}
+		std::cout << "capacity stable between 0 and 1: " << stable << std::endl;
+		for (int i = 0; i < 100; i++)
+			v.push_back(i);
+		cap = v.capacity();
+		v.clear();
+		stable = true;
+		for (int round = 0; round < 10; round++)
+		{
+			stable = stable && v.capacity() == cap;
+			for (int i = 0; i < 100; i++)
+				v.push_back(i);
+			stable = stable && v.capacity() == cap;
+			v.clear();
+		}
+		std::cout << "capacity stable filling and clearing: " << stable << std::endl;
+		shrink_vector(v);
+		std::cout << "shrink_to_fit frees: " << (v.capacity() == 0) << std::endl;
+
+		shrinking_min16		m(100, 1);
+
+		while (!m.empty())
+			m.pop_back();
+		std::cout << "floor: " << FT_ONLY(m.capacity() == 16) << std::endl;
+		stable = true;
+		cap = m.capacity();
+		for (int i = 0; i < 100; i++)
+		{
+			m.push_back(i);
+			m.pop_back();
+			stable = stable && m.capacity() == cap;
+		}
+		std::cout << "capacity stable at the floor: " << stable << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (trivially copyable elements) -------------" << std::endl;
+
+		std::cout << "point is trivially copyable: " << FT_ONLY(ft::is_trivially_copyable<point>::value
+			&& !ft::is_trivially_copyable<std::string>::value) << std::endl;
+
+		NS::vector<point>	v;
+		point				arr[5];
+
+		for (int i = 0; i < 5; i++)
+			arr[i] = make_point('a' + i, i * i, i / 2.0);
+		for (int i = 0; i < 20; i++)
+			v.push_back(make_point('k', i, -i));
+		v.assign(arr, arr + 5);
+		print_vector("assigned from an array", v);
+		v.insert(v.begin() + 2, arr, arr + 3);
+		v.insert(v.end() - 1, 4, arr[2]);
+		print_vector("inserted", v);
+		v.erase(v.begin() + 1, v.begin() + 5);
+		v.erase(v.begin());
+		print_vector("erased", v);
+
+		NS::vector<point>	c(v);
+		NS::vector<point>	small(1, arr[4]);
+		NS::vector<point>	big(30, arr[3]);
+
+		std::cout << "copy: " << (c == v) << ", capacity " << c.capacity() << std::endl;
+		small = v;
+		big = v;
+		std::cout << "assigned to a smaller and a bigger vector: " << (small == v) << (big == v)
+			<< ", big keeps its capacity " << (big.capacity() >= 30) << std::endl;
+		c.resize(12, arr[1]);
+		c.reserve(100);
+		print_vector("resized", c);
+		c.swap(v);
+		std::cout << "swap: " << c.size() << ' ' << v.size() << ", v > c " << (v > c) << std::endl;
+
+		NS::vector<int>			ints;
+		const NS::vector<int>	empty;
+
+		for (int i = 0; i < 1000; i++)
+			ints.push_back(i * 3);
+		NS::vector<int>	head(ints.begin(), ints.begin() + 300);
+
+		ints.insert(ints.begin() + 500, head.begin(), head.end());
+		ints.erase(ints.begin() + 10, ints.begin() + 900);
+
+		NS::vector<int>	ints_copy(ints);
+
+		ints_copy = empty;
+		print_vector("empty copy", ints_copy);
+		ints_copy = ints;
+		std::cout << "ints: " << ints_copy.size() << ' ' << ints_copy.front() << ' ' << ints_copy[9] << ' '
+			<< ints_copy[10] << ' ' << ints_copy.back() << ", equal " << (ints_copy == ints) << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (relocatable elements) -------------" << std::endl;
+
+		std::cout << "traits: " << FT_ONLY(ft::is_trivially_relocatable<boxed>::value
+			&& !ft::is_trivially_relocatable<anchored>::value
+			&& (ft::is_trivially_relocatable<ft::pair<int, boxed> >::value)) << std::endl;
+		{
+			NS::vector<boxed>					b;
+			NS::vector<NS::pair<int, boxed> >	pairs;
+
+			for (int i = 0; i < 100; i++)
+			{
+				b.push_back(boxed(i));
+				pairs.push_back(NS::make_pair(i, boxed(-i)));
+			}
+			b.insert(b.begin() + 10, 5, boxed(-1));
+			b.insert(b.begin(), b[50]);
+			b.erase(b.begin() + 20, b.begin() + 90);
+			b.erase(b.begin() + 3);
+			b.reserve(500);
+			pairs.erase(pairs.begin(), pairs.begin() + 95);
+			pairs.insert(pairs.begin() + 2, NS::make_pair(7, boxed(7)));
+			print_vector("boxed", b);
+			std::cout << "pairs:";
+			for (size_t i = 0; i < pairs.size(); i++)
+				std::cout << ' ' << pairs[i].first << '=' << pairs[i].second;
+			std::cout << std::endl << "live == size: " << (boxed::live == static_cast<long>(b.size() + pairs.size())) << std::endl;
+
+			NS::vector<boxed>	copy(b);
+
+			copy.resize(3);
+			copy.resize(6, boxed(9));
+			b.swap(copy);
+			print_vector("resized copy", b);
+		}
+		std::cout << "all destroyed: " << (boxed::live == 0) << std::endl;
+
+		NS::vector<anchored>	a;
+		bool					ok = true;
+		long					sum = 0;
+
+		for (int i = 0; i < 100; i++)
+			a.push_back(anchored(i));
+		a.insert(a.begin() + 5, 20, anchored(-1));
+		a.erase(a.begin() + 30, a.begin() + 60);
+		a.insert(a.begin(), anchored(1000));
+		a.erase(a.begin() + 1);
+		a.reserve(1000);
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			ok = ok && a[i].ok();
+			sum += static_cast<long>(i + 1) * a[i].value;
+		}
+		std::cout << "anchored: size " << a.size() << ", sum " << sum << ", never moved by bytes " << ok << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Vector (growth policies & realloc_allocator) -------------" << std::endl;
+
+		GROWTH_VECTOR(int, ft::half_growth_policy)							half;
+		GROWTH_VECTOR(int, ft::page_growth_policy)							page;
+		GROWTH_VECTOR(std::string, ft::min_capacity_growth_policy<16>)		min16;
+		GROWTH_VECTOR(int, ft::double_growth_policy)						twice;
+
+		std::cout << "half: " << FT_ONLY(follows_growth<ft::half_growth_policy>(half, 1000)) << ", page: "
+			<< FT_ONLY(follows_growth<ft::page_growth_policy>(page, 5000) && page.capacity() * sizeof(int) % 4096 == 0)
+			<< ", double: " << FT_ONLY(follows_growth<ft::double_growth_policy>(twice, 1000)) << std::endl;
+		min16.push_back("a");
+		std::cout << "min 16: " << FT_ONLY(min16.capacity() == 16) << std::endl;
+		for (int i = 0; i < 40; i++)
+			min16.push_back(std::string(i % 7 + 1, 'a' + i % 26));
+		min16.insert(min16.begin() + 3, 20, "ins");
+		min16.erase(min16.begin() + 10, min16.begin() + 50);
+		print_vector("min16", min16);
+
+		half.resize(10);
+		half.insert(half.begin() + 5, 3, 7);
+		print_vector("half", half);
+
+		REALLOC_VECTOR(int)			r;
+		REALLOC_VECTOR(boxed)		rb;
+		REALLOC_VECTOR(std::string)	rs;
+		REALLOC_VECTOR(anchored)	ra;
+		long						sum = 0;
+		bool						ok = true;
+
+		for (int i = 0; i < 100000; i++)
+			r.push_back(i);
+		for (int i = 0; i < 3000; i++)
+		{
+			rb.push_back(boxed(i));
+			rs.push_back(std::string(i % 40, 'x'));
+			ra.push_back(anchored(i));
+		}
+		r.insert(r.begin() + 10, 1000, -1);
+		r.erase(r.begin(), r.begin() + 5);
+		for (size_t i = 0; i < r.size(); i++)
+			sum += static_cast<long>(i % 1000) * r[i];
+		for (size_t i = 0; i < ra.size(); i++)
+			ok = ok && ra[i].ok() && ra[i].value == static_cast<int>(i);
+		std::cout << "realloc ints: size " << r.size() << ", sum " << sum << ", page sized "
+			<< FT_ONLY(r.capacity() * sizeof(int) % 4096 == 0) << std::endl;
+		std::cout << "realloc boxed: " << rb.size() << ' ' << rb[0] << ' ' << rb[2999] << ", live "
+			<< (boxed::live == 3000) << ", strings: " << rs.size() << ' ' << rs[39] << ", anchored never moved by bytes "
+			<< ok << std::endl;
+
+		REALLOC_VECTOR(int)	copy(r.begin(), r.begin() + 10);
+
+		copy = r;
+		copy.resize(20);
+		r.swap(copy);
+		rb.clear();
+		std::cout << "copy: " << copy.size() << ", swapped: " << r.size() << ' ' << r.back() << ", cleared boxed live "
+			<< (boxed::live == 0) << std::endl;
+	}
+
+	std::cout << "\n\n\n*************************************************************************" << std::endl;
 	std::cout << "\t\t\t\tMap" << std::endl;
 	std::cout << "*************************************************************************" << std::endl;
 
@@ -691,6 +1943,38 @@ int main()
 		std::cout << "Is map now empty (should be 1)?  " << mymap.empty() << std::endl;
 	}
 
+	{
+		std::cout << "\n------------- FT Map (end() taken while empty) -------------" << std::endl;
+		NS::map<int, int>			m;
+		NS::map<int, int>::iterator	e = m.end();
+		m[1] = 1;
+		std::cout << "find(2) == old end(): " << (m.find(2) == e) << std::endl;
+		std::cout << "++begin() == old end(): " << (++m.begin() == e) << std::endl;
+		m.clear();
+		std::cout << "after clear, begin() == old end(): " << (m.begin() == e) << std::endl;
+
+		NS::map<int, int>			copy(m);
+		NS::map<int, int>::iterator	ce = copy.end();
+		copy[5] = 5;
+		copy[3] = 3;
+		std::cout << "copy of an empty map, find(4) == old end(): " << (copy.find(4) == ce) << std::endl;
+
+		NS::map<int, int>	other;
+		other[7] = 7;
+		m.swap(other);
+		std::cout << "after swap, find(8) == old end(): " << (m.find(8) == e) << ", other.begin() == other.end(): "
+			<< (other.begin() == other.end()) << std::endl;
+		other.swap(m);
+		std::cout << "swapped back, other.find(7) != other.end(): " << (other.find(7) != other.end())
+			<< ", m.find(7) == old end(): " << (m.find(7) == e) << std::endl;
+
+		NS::multimap<int, int>				mm;
+		NS::multimap<int, int>::iterator	me = mm.end();
+		mm.insert(NS::make_pair(1, 1));
+		mm.insert(NS::make_pair(1, 2));
+		std::cout << "multimap upper_bound(1) == old end(): " << (mm.upper_bound(1) == me) << std::endl;
+	}
+
 	{
 		std::cout << "\n------------- FT Map (size) -------------" << std::endl;
 		NS::map<char, int> mymap;
@@ -920,6 +2204,1037 @@ int main()
 		std::cout << ret.second->first << " => " << ret.second->second << std::endl;
 	}
 
+	{
+		std::cout << "\n------------- FT Map (compact) -------------" << std::endl;
+		// compact() en medio de inserciones y borrados: el contenido, el orden y end() no cambian, y el
+		// mapa sigue funcionando igual después
+		NS::map<int, int> m;
+		compact_map(m);
+		std::cout << "empty map after compact: size " << m.size() << ", begin == end " << (m.begin() == m.end()) << std::endl;
+		m[5] = 5;
+		compact_map(m);
+		std::cout << "one element after compact: " << m.begin()->first << " => " << m.begin()->second << std::endl;
+		srand(7);
+		for (int round = 0; round < 6; round++)
+		{
+			for (int i = 0; i < 300; i++)
+				m[rand() % 1000] += round + 1;
+			for (int i = 0; i < 150; i++)
+				m.erase(rand() % 1000);
+			if (round % 2 == 1)
+				m.erase(m.lower_bound(100 * round), m.lower_bound(100 * round + 50));
+			NS::map<int, int>::iterator end = m.end();
+			compact_map(m);
+			long sum = 0;
+			int prev = 0;
+			bool sorted = true;
+			for (NS::map<int, int>::iterator it = m.begin(); it != m.end(); ++it)
+			{
+				sorted = sorted && (it == m.begin() || it->first > prev);
+				prev = it->first;
+				sum += it->first * it->second;
+			}
+			std::cout << "round " << round << ": size " << m.size() << ", end kept " << (end == m.end())
+				<< ", sorted " << sorted << ", sum " << sum << ", front " << m.begin()->first
+				<< ", back " << m.rbegin()->first << ", lower_bound(500) " << m.lower_bound(500)->first
+				<< ", count(m.begin()->first + 1) " << m.count(m.begin()->first + 1) << std::endl;
+			m.insert(NS::make_pair(-round - 1, round));
+			m.erase(m.find(m.rbegin()->first));
+			m[2000 + round] = round;
+		}
+		NS::map<int, int> copy(m);
+		compact_map(copy);
+		std::cout << "copy == m after compact: " << (copy == m) << ", size " << copy.size() << std::endl;
+		copy.clear();
+		compact_map(copy);
+		copy[1] = 1;
+		std::cout << "cleared, compacted and refilled: size " << copy.size() << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Map (compact copies each value once) -------------" << std::endl;
+
+		NS::map<int, copy_counter>	m;
+		long						sum = 0;
+
+		for (int i = 0; i < 1000; i++)
+			m.insert(NS::make_pair((i * 37) % 1000, copy_counter(i)));
+		copy_counter::copies = 0;
+		compact_map(m);
+		std::cout << "one copy per value: " << FT_ONLY(copy_counter::copies == m.size()) << std::endl;
+		for (NS::map<int, copy_counter>::iterator it = m.begin(); it != m.end(); ++it)
+			sum += it->first * 3 + it->second.value;
+		std::cout << "size: " << m.size() << ", sum: " << sum << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Map (finger) -------------" << std::endl;
+		// Búsquedas con finger que avanzan, retroceden y saltan, mezcladas con inserciones y borrados de
+		// otros elementos. Si se borra el elemento donde está el finger, hay que llamar a reset().
+		typedef NS::map<int, int> int_map;
+		int_map m;
+		for (int i = 0; i <= 1000; i += 2)
+			m[i] = i / 2;
+		MAP_FINGER(int_map) f(m);
+		long found = 0;
+		long sum = 0;
+		for (int k = 0; k <= 1001; k++)
+		{
+			NS::map<int, int>::iterator it = f.find(k);
+			if (it != m.end())
+			{
+				found++;
+				sum += it->second;
+			}
+		}
+		std::cout << "forward find: found " << found << ", sum " << sum << std::endl;
+		found = 0;
+		sum = 0;
+		for (int k = 1005; k >= -5; k -= 3)
+		{
+			NS::map<int, int>::iterator it = f.lower_bound(k);
+			if (it == m.end())
+				found++;
+			else
+				sum += it->first;
+		}
+		std::cout << "backward lower_bound: at end " << found << ", sum " << sum << std::endl;
+		srand(11);
+		found = 0;
+		sum = 0;
+		for (int i = 0; i < 3000; i++)
+		{
+			int k = (i * 7) % 1200 - 100 + rand() % 5;
+			int op = rand() % 4;
+			if (op == 0)
+				m[k | 1] = i;										// Claves impares: nunca es el elemento del finger
+			else if (op == 1)
+			{
+				NS::map<int, int>::iterator it = f.lower_bound(k);
+				if (it != m.end())
+				{
+					NS::map<int, int>::iterator next = it;
+					if (++next != m.end())
+						m.erase(next);								// El siguiente, no en el que está el finger
+					sum += it->first;
+				}
+			}
+			else if (op == 2)
+			{
+				NS::map<int, int>::iterator it = f.find(k);
+				if (it != m.end())
+				{
+					found++;
+					sum += it->second;
+					if (rand() % 8 == 0)
+					{
+						m.erase(it);
+						f.reset();
+					}
+				}
+			}
+			else
+			{
+				NS::map<int, int>::iterator it = f.lower_bound(rand() % 1200 - 100);
+				sum += (it == m.end()) ? -1 : it->first;
+			}
+		}
+		std::cout << "mixed: found " << found << ", sum " << sum << ", size " << m.size() << std::endl;
+		std::cout << "find(-1000) == end: " << (f.find(-1000) == m.end()) << ", lower_bound(5000) == end: "
+			<< (f.lower_bound(5000) == m.end()) << ", lower_bound(-1000): " << f.lower_bound(-1000)->first << std::endl;
+		m.clear();
+		f.reset();
+		std::cout << "empty: find(0) == end: " << (f.find(0) == m.end()) << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Map (union, intersection & difference) -------------" << std::endl;
+
+		NS::map<int, int>	a;
+		NS::map<int, int>	b;
+		NS::map<int, int>	empty;
+
+		for (int i = 0; i < 200; i++)
+		{
+			a[(i * 7) % 311] = i;
+			b[(i * 11) % 257 + 100] = -i;
+		}
+		print_map_sum("a", a);
+		print_map_sum("b", b);
+		print_map_sum("a | b", map_union(a, b));
+		print_map_sum("b | a", map_union(b, a));
+		print_map_sum("a & b", map_intersection(a, b));
+		print_map_sum("b & a", map_intersection(b, a));
+		print_map_sum("a - b", map_difference(a, b));
+		print_map_sum("b - a", map_difference(b, a));
+		print_map_sum("a | empty", map_union(a, empty));
+		print_map_sum("empty & a", map_intersection(empty, a));
+		print_map_sum("empty - a", map_difference(empty, a));
+
+		NS::map<int, int>	c(a);
+
+		map_union_inplace(c, b);
+		std::cout << "a |= b: " << (c == map_union(a, b)) << std::endl;
+		c = a;
+		map_intersection_inplace(c, b);
+		std::cout << "a &= b: " << (c == map_intersection(a, b)) << std::endl;
+		c = a;
+		map_difference_inplace(c, b);
+		std::cout << "a -= b: " << (c == map_difference(a, b)) << std::endl;
+		c = b;
+		map_intersection_inplace(c, a);
+		std::cout << "b &= a: " << (c == map_intersection(b, a)) << std::endl;
+		c = a;
+		map_union_inplace(c, c);
+		map_intersection_inplace(c, c);
+		std::cout << "a |= a, a &= a: " << (c == a) << std::endl;
+		map_difference_inplace(c, c);
+		print_map_sum("a -= a", c);
+		map_union_inplace(c, b);
+		print_map_sum("empty |= b", c);
+		map_difference_inplace(c, empty);
+		map_intersection_inplace(c, empty);
+		print_map_sum("b &= empty", c);
+
+		NS::map<int, int>	base;
+		NS::map<int, int>	gap;
+
+		for (int i = 0; i < 1000; i++)
+			base[i < 500 ? i : 1000000 + i] = i;
+		for (int i = 0; i < 40000; i++)
+			gap[1000 + i * 20] = -i;
+		c = base;
+		map_union_inplace(c, gap);
+		print_map_sum("in one gap |=", c);
+		std::cout << "same as union: " << (c == map_union(base, gap)) << std::endl;
+		c.erase(c.find(1000 + 20 * 20000));
+		c[1000 + 20 * 20000 + 1] = 7;
+		map_union_inplace(c, gap);
+		print_map_sum("in one gap |= again", c);
+		map_difference_inplace(c, gap);
+		print_map_sum("in one gap -=", c);
+		map_union_inplace(gap, base);
+		map_intersection_inplace(gap, base);
+		std::cout << "gap & base: " << (gap == base) << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Eytzinger index -------------" << std::endl;
+
+		for (int n = 0; n <= 70; n += (n < 20 ? 1 : 7))			// Árboles llenos y con el último nivel a medias
+		{
+			NS::vector<int>	keys;
+
+			for (int i = 0; i < n; i++)
+				keys.push_back(i * 3 - 20);
+
+			EYTZINGER_INDEX(int)	idx(keys);
+			long					sum = 0;
+			bool					keys_ok = (idx.size() == keys.size());
+
+			for (int k = -25; k < 3 * n - 15; k++)
+				sum += idx.lower_bound(k) * 7 + idx.upper_bound(k) * 3 + idx.count(k);
+			for (int r = 0; r < n; r++)
+				keys_ok = keys_ok && idx.key(r) == keys[r];
+			std::cout << "n " << n << ": sum " << sum << ", key(rank) " << keys_ok << std::endl;
+		}
+
+		NS::vector<int>	keys;
+
+		for (int i = 0; i < 1000; i++)
+			keys.push_back((i * i) % 7919 - 4000);
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+		EYTZINGER_INDEX(int)	idx(keys);
+		int						probes[50];
+		size_t					ranks[50];
+		bool					batch_ok = true;
+
+		for (int i = 0; i < 50; i++)
+			probes[i] = i * 173 - 4100;
+		idx.lower_bound(probes, probes + 50, ranks);
+		for (int i = 0; i < 50; i++)
+			batch_ok = batch_ok && ranks[i] == idx.lower_bound(probes[i]);
+		std::cout << "size " << idx.size() << ", batch matches lower_bound " << batch_ok << ", ranks:";
+		for (int i = 0; i < 50; i += 7)
+			std::cout << ' ' << ranks[i];
+		std::cout << std::endl;
+
+		NS::map<std::string, int>	m;
+
+		for (int i = 0; i < 40; i++)
+			m[std::string(1 + i % 5, 'a' + (i * 7) % 26)] = i;
+
+		EYTZINGER_INDEX(std::string)	words(m);
+		const char*						probe_words[] = {"", "a", "aa", "bbbbb", "c", "m", "zz", "zzzzzz"};
+
+		std::cout << "from a map: size " << words.size() << ", lower_bound:";
+		for (size_t i = 0; i < sizeof(probe_words) / sizeof(probe_words[0]); i++)
+			std::cout << ' ' << words.lower_bound(probe_words[i]);
+		std::cout << ", key(0) " << words.key(0) << ", key(last) " << words.key(words.size() - 1) << std::endl;
+	}
+
+
+	{
+		std::cout << "\n------------- FT Map (save_map, load_map & map_snapshot) -------------" << std::endl;
+
+		const char*					path = "ft_containers_snapshot.tmp";
+		NS::map<int, int>			m;
+		NS::map<int, int>			loaded;
+		NS::map<int, int>			empty;
+
+		for (int i = 0; i < 300; i++)
+			m[(i * 37) % 1009 - 500] = i;
+		save_map(m, path);
+		loaded[12345] = 1;									// load_map() reemplaza lo que hubiera
+		load_map(loaded, path);
+		print_map_sum("loaded", loaded);
+		std::cout << "loaded == m: " << (loaded == m) << std::endl;
+		loaded[0] = 0;
+		loaded.erase(loaded.begin());
+		print_map_sum("loaded after insert & erase", loaded);
+
+		{
+			MAP_SNAPSHOT(int, int)	snap(path);
+			long					sum = 0;
+			long					i = 0;
+			bool					found = true;
+
+			for (MAP_SNAPSHOT(int, int)::const_iterator it = snap.begin(); it != snap.end(); ++it, ++i)
+				sum += (i + 1) * (static_cast<long>(it->first) * 3 + it->second);
+			for (NS::map<int, int>::iterator it = m.begin(); it != m.end(); ++it)
+				found = found && snap.find(it->first) != snap.end() && snap.find(it->first)->second == it->second;
+			std::cout << "snapshot size " << snap.size() << ", sum " << sum << ", finds every key " << found << std::endl;
+			std::cout << "count(-500) " << snap.count(-500) << ", count(-499) " << snap.count(-499)
+				<< ", find(10000) == end " << (snap.find(10000) == snap.end())
+				<< ", lower_bound(0) " << snap.lower_bound(0)->first << ", upper_bound(0) " << snap.upper_bound(0)->first
+				<< ", upper_bound(1000) == end " << (snap.upper_bound(1000) == snap.end()) << std::endl;
+		}
+
+		save_map(empty, path);
+		load_map(loaded, path);
+		std::cout << "empty round trip: " << loaded.empty() << std::endl;
+
+		std::FILE*	f = std::fopen(path, "w");
+		std::fputs("not a snapshot", f);
+		std::fclose(f);
+		try
+		{
+			load_map(loaded, path);
+			std::cout << "garbage file loaded" << std::endl;
+		}
+		catch (std::runtime_error&)
+		{
+			std::cout << "garbage file: runtime_error, map untouched " << loaded.empty() << std::endl;
+		}
+		std::remove(path);
+		try
+		{
+			MAP_SNAPSHOT(int, int)	snap(path);
+
+			std::cout << "missing file opened" << std::endl;
+		}
+		catch (std::runtime_error&)
+		{
+			std::cout << "missing file: runtime_error" << std::endl;
+		}
+	}
+
+
+	{
+		std::cout << "\n------------- FT Map (stats) -------------" << std::endl;
+
+		NS::map<int, int>	m;
+		NS::set<int>		s;
+		size_t				found = 0;
+
+		for (int i = 1; i <= 127; i++)
+		{
+			m[i] = i;
+			s.insert(-i);
+		}
+		std::cout << "allocs: " << FT_ONLY(m.stats().node_allocs == 127 && m.stats().node_frees == 0)
+			<< ", sorted inserts make a list: " << FT_ONLY(m.stats().height == 127 && m.stats().max_height == 127)
+			<< ", set too: " << FT_ONLY(s.stats().height == 127) << std::endl;
+		reset_stats(m);
+		std::cout << "reset: " << FT_ONLY(m.stats().lookups == 0 && m.stats().comparisons == 0
+			&& m.stats().node_allocs == 0 && m.stats().max_height == 127) << std::endl;
+		for (int i = 0; i <= 128; i++)
+			found += m.count(i);
+		std::cout << "found " << found << ", lookups: " << FT_ONLY(m.stats().lookups == 129)
+			<< ", comparisons: " << FT_ONLY(m.stats().comparisons >= m.stats().visited) << std::endl;
+
+		std::cout << "histogram: " << FT_ONLY(histogram_consistent(m.stats()) && m.stats().max_visited >= 64) << std::endl;
+		compact_map(m);
+		std::cout << "compacted: " << FT_ONLY(m.stats().height <= 8 && m.stats().max_height == 127) << std::endl;
+		reset_stats(m);
+		for (int i = 1; i <= 27; i++)
+			m.erase(i * 4);
+		std::cout << "size " << m.size() << ", frees: "
+			<< FT_ONLY(m.stats().node_frees == 27 && m.stats().node_allocs == 0) << std::endl;
+		m.clear();
+		std::cout << "cleared: " << FT_ONLY(m.stats().node_frees == 127 && m.stats().height == 0) << std::endl;
+	}
+
+
+	{
+		std::cout << "\n------------- FT Map (build_parallel) -------------" << std::endl;
+
+		NS::vector<NS::pair<int, int> >	input;
+		std::list<NS::pair<int, int> >	list;
+		NS::map<int, int>				m;
+		NS::multimap<int, int>			mm;
+
+		for (int i = 0; i < 5000; i++)
+			input.push_back(NS::make_pair((i * 7919) % 3001, i));	// Desordenadas y con claves repetidas
+		for (size_t threads = 0; threads <= 8; threads += (threads < 2 ? 1 : 3))
+		{
+			m[-1] = -1;												// Se reemplaza lo que hubiera
+			build_parallel(m, input.begin(), input.end(), threads);
+			std::cout << threads << " threads: ";
+			print_map_sum("m", m);
+			std::cout << "balanced: " << FT_ONLY(m.stats().height <= 13) << std::endl;
+		}
+		m.insert(NS::make_pair(5000, 1));
+		m.erase(0);
+		print_map_sum("m after insert & erase", m);
+
+		build_parallel(mm, input.begin(), input.end(), 4);
+		long	sum = 0;
+		long	i = 0;
+		for (NS::multimap<int, int>::iterator it = mm.begin(); it != mm.end(); ++it, ++i)
+			sum += (i + 1) * (it->first * 3 + it->second);			// Depende del orden de los repetidos
+		std::cout << "multimap keeps every element in input order: size " << mm.size() << ", sum " << sum << std::endl;
+
+		for (int i = 0; i < 3; i++)
+			list.push_back(NS::make_pair(3 - i, i));
+		build_parallel(m, list.begin(), list.end(), 4);
+		print_map_sum("from a list", m);
+		build_parallel(m, list.begin(), list.begin(), 4);
+		print_map_sum("empty range", m);
+		m[7] = 7;
+		print_map_sum("empty range, then insert", m);
+	}
+
+
+	{
+		std::cout << "\n------------- FT Map (parallel_for_each & parallel_reduce) -------------" << std::endl;
+
+		NS::map<int, int>	m;
+		NS::map<int, int>	list;
+		NS::map<int, int>	empty;
+
+		for (int i = 0; i < 10000; i++)
+		{
+			m[(i * 7919) % 10007] = i % 100;
+			if (i < 500)
+				list[i] = i;											// Insertadas en orden: el árbol es una lista
+		}
+		for (size_t threads = 0; threads <= 8; threads += (threads < 2 ? 1 : 3))
+		{
+			long	before = parallel_reduce(m, 0L, sum_values(), threads);
+
+			parallel_for_each(m, double_value(), threads);
+			std::cout << threads << " threads: sum " << before << " -> " << parallel_reduce(m, 0L, sum_values(), threads)
+				<< ", list sum " << parallel_reduce(list, 0L, sum_values(), threads) << std::endl;
+		}
+		print_map_sum("m", m);
+		parallel_for_each(list, double_value(), 4);
+		print_map_sum("list", list);
+
+		NS::map<int, int>	small;
+
+		for (int i = 0; i < 40; i++)
+			small[(i * 13) % 41] = i;
+
+		const NS::map<int, int>&	csmall = small;
+
+		std::cout << "keys in order: " << parallel_reduce(csmall, std::string(), join_keys(), 4) << std::endl;
+		std::cout << "empty: " << parallel_reduce(empty, 0L, sum_values(), 4) << ", \""
+			<< parallel_reduce(empty, std::string(), join_keys(), 4) << "\"" << std::endl;
+		parallel_for_each(empty, double_value(), 4);
+	}
+
+
+	{
+		std::cout << "\n------------- FT Map (prefix_less) -------------" << std::endl;
+
+		typedef NS::map<std::string, int, PREFIX_LESS(std::string)>	prefix_map;
+
+		prefix_map				m;
+		NS::set<std::string, PREFIX_LESS(std::string)>	s;
+		const std::string		base("/usr/share");
+		const char				bytes[] = {'\0', '\x01', 'a', '\x7f', '\x80', '\xff'};
+		int						n = 0;
+
+		for (size_t len = 0; len <= 12; len++)					// Más cortas, iguales y más largas que el prefijo
+			for (size_t b = 0; b < sizeof(bytes); b++)
+			{
+				std::string	k = base.substr(0, len);
+
+				if (len % 3 == 0)
+					k += bytes[b];
+				else if (len)
+					k[len - 1] = bytes[b];
+				m[k] = n++;
+				s.insert(k + k);
+			}
+		m[std::string(8, '\0')] = n++;
+		m[std::string(9, '\0')] = n++;
+		m[std::string(8, '\0') + "a"] = n++;
+		std::cout << "size " << m.size() << ", set size " << s.size() << std::endl;
+		for (prefix_map::iterator it = m.begin(); it != m.end(); ++it)
+		{
+			print_key(it->first);
+			std::cout << '=' << it->second << ' ';
+		}
+		std::cout << std::endl;
+
+		const char*	probes[] = {"", "/", "/usr", "/usr/sh", "/usr/shar", "/usr/share", "/usr/share/", "/v"};
+		for (size_t i = 0; i < sizeof(probes) / sizeof(probes[0]); i++)
+		{
+			prefix_map::iterator	lb = m.lower_bound(probes[i]);
+			prefix_map::iterator	ub = m.upper_bound(probes[i]);
+
+			std::cout << '"' << probes[i] << "\": count " << m.count(probes[i]) << ", lower_bound ";
+			print_key(lb == m.end() ? "end" : lb->first);
+			std::cout << ", upper_bound ";
+			print_key(ub == m.end() ? "end" : ub->first);
+			std::cout << ", set lower_bound ";
+			print_key(s.lower_bound(probes[i]) == s.end() ? "end" : *s.lower_bound(probes[i]));
+			std::cout << std::endl;
+		}
+
+		prefix_map	copy(m);
+
+		copy.erase(copy.begin(), copy.lower_bound("/usr/sh"));
+		compact_map(copy);
+		std::cout << "copy size " << copy.size() << ", front ";
+		print_key(copy.begin()->first);
+		std::cout << ", find(\"/usr/share\") " << copy.find("/usr/share")->second << ", copy < m " << (copy < m) << std::endl;
+		m.swap(copy);
+		std::cout << "swapped: " << m.size() << ' ' << copy.size() << ", key_comp()(\"a\", \"b\") " << m.key_comp()("a", "b") << std::endl;
+	}
+
+
+	{
+		std::cout << "\n------------- FT Map (splay policies) -------------" << std::endl;
+
+		typedef POLICY_MAP(int, int, ft::splay_tree_policy)			splay_map;
+		typedef POLICY_MAP(int, int, ft::sampled_splay_tree_policy)	sampled_map;
+
+		splay_map	m;
+		sampled_map	sm;
+		long		sum = 0;
+
+		for (int i = 0; i < 2000; i++)
+		{
+			m[(i * 7919) % 2003] = i;
+			sm.insert(NS::make_pair((i * 7919) % 2003, i));
+		}
+		print_map_sum("splay", m);
+		print_map_sum("sampled", sm);
+		for (int round = 0; round < 200; round++)					// Unas pocas claves se buscan casi siempre
+		{
+			int	k = (round % 10 < 8 ? round % 4 * 500 : (round * 37) % 2003);
+
+			if (m.find(k) != m.end())
+				sum += m.find(k)->second;
+			if (sm.find(k) != sm.end())
+				sum += sm.find(k)->second;
+			sum += m.count(k + 1) + (sm.lower_bound(k) == sm.end() ? -1 : sm.lower_bound(k)->first);
+		}
+		std::cout << "lookups sum " << sum << ", rotations: " << FT_ONLY(m.stats().rotations > 0 && sm.stats().rotations > 0)
+			<< ", sampled rotates less: " << FT_ONLY(sm.stats().rotations < m.stats().rotations) << std::endl;
+		m.find(1234);
+		std::cout << "found key at the root: " << FT_ONLY(m.get_root()->data.first == 1234) << std::endl;
+
+		const splay_map&	cm = m;
+
+		std::cout << "const find: " << cm.find(7)->first << ", doesn't move the root: "
+			<< FT_ONLY(m.get_root()->data.first == 1234) << std::endl;
+		for (int i = 0; i < 2000; i += 3)
+		{
+			m.erase(i);
+			sm.erase(sm.find(i + 1) == sm.end() ? sm.begin() : sm.find(i + 1));
+		}
+		print_map_sum("splay after erase", m);
+		print_map_sum("sampled after erase", sm);
+
+		splay_map	copy(m);
+
+		copy[-1] = -1;
+		std::cout << "copy: " << copy.size() << ", copy > m " << (copy > m) << ", lower_bound(1000) " << copy.lower_bound(1000)->first
+			<< ", upper_bound(1000) " << copy.upper_bound(1000)->first << std::endl;
+		m.swap(copy);
+		m.clear();
+		m[3] = 3;
+		print_map_sum("cleared and refilled", m);
+	}
+
+
+	{
+		std::cout << "\n------------- FT Map (inline nodes) -------------" << std::endl;
+
+		typedef INLINE_MAP(int, int, 4)				inline_map;
+		typedef INLINE_MAP(int, std::string, 2)		inline_str;
+
+		inline_map	m;
+
+		for (int i = 4; i > 0; i--)
+			m[i * 10] = i;
+		std::cout << "inline: " << FT_ONLY(map_in_object(m)) << std::endl;
+		m[25] = 5;
+		m[35] = 6;
+		std::cout << "some on the heap: " << FT_ONLY(!map_in_object(m)) << std::endl;
+		print_map_sum("m", m);
+		m.erase(10);
+		m.erase(25);
+		m.erase(m.find(40));
+		m[5] = 7;
+		m[45] = 8;
+		m.erase(35);
+		print_map_sum("m", m);
+
+		inline_map	c(m);
+
+		std::cout << "copy inline: " << FT_ONLY(map_in_object(c)) << ", equal: " << (c == m) << std::endl;
+		for (int i = 0; i < 20; i++)
+			c[100 + i] = i;
+		m = c;
+		std::cout << "assigned: " << (m == c) << ", ";
+		print_map_sum("m", m);
+		m.clear();
+		m[1] = 1;
+		m[2] = 2;
+		std::cout << "cleared and refilled inline: " << FT_ONLY(map_in_object(m)) << std::endl;
+		m.swap(c);
+		print_map_sum("swapped m", m);
+		print_map_sum("swapped c", c);
+		std::cout << "small side inline after swap: " << FT_ONLY(map_in_object(c)) << std::endl;
+		compact_map(m);
+		print_map_sum("compacted", m);
+
+		inline_str	s;
+		inline_str	t;
+
+		s[2] = "abcdefghijklmnopqrstuvwxyz";
+		s[1] = "b";
+		t[3] = "c";
+		s.swap(t);
+		std::cout << "strings: " << s.size() << ' ' << s.begin()->second << ", " << t.size() << ' ' << t.rbegin()->second
+			<< ", inline: " << FT_ONLY(map_in_object(s) && map_in_object(t)) << std::endl;
+		for (int i = 0; i < 10; i++)
+			t[i * 3] = std::string(i + 1, 'x');
+		t.erase(t.begin(), t.lower_bound(20));
+		std::cout << "t:";
+		for (inline_str::iterator it = t.begin(); it != t.end(); ++it)
+			std::cout << ' ' << it->first << '=' << it->second;
+		std::cout << std::endl;
+	}
+
+
+	{
+		std::cout << "\n------------- FT Map (helpers on inline and splay maps) -------------" << std::endl;
+
+		typedef INLINE_MAP(int, int, 4)								inline_map;
+		typedef POLICY_MAP(int, int, ft::splay_tree_policy)			splay_map;
+		typedef POLICY_MAP(int, int, ft::sampled_splay_tree_policy)	sampled_map;
+
+		const char*	path = "ft_containers_snapshot.tmp";
+		inline_map	ia;
+		inline_map	ib;
+		splay_map	sa;
+		splay_map	sb;
+		sampled_map	pa;
+
+		for (int i = 0; i < 9; i++)
+		{
+			ia[(i * 5) % 11] = i;
+			ib[(i * 3) % 7 + 4] = -i;
+		}
+		for (int i = 0; i < 300; i++)
+		{
+			sa[(i * 7) % 311] = i;
+			sb[(i * 11) % 257 + 100] = -i;
+			pa[(i * 13) % 401] = i;
+		}
+		sa.find(5);													// Que la forma ya no sea la de las inserciones
+		sb.find(200);
+		print_map_sum("inline a | b", map_union(ia, ib));
+		print_map_sum("inline a & b", map_intersection(ia, ib));
+		print_map_sum("inline a - b", map_difference(ia, ib));
+		print_map_sum("splay a | b", map_union(sa, sb));
+		print_map_sum("splay a & b", map_intersection(sa, sb));
+		print_map_sum("splay b - a", map_difference(sb, sa));
+
+		inline_map	ic(ia);
+		splay_map	sc(sa);
+
+		map_union_inplace(ic, ib);
+		print_map_sum("inline a |= b", ic);
+		map_intersection_inplace(ic, ia);
+		print_map_sum("then &= a", ic);
+		map_difference_inplace(ic, ib);
+		print_map_sum("then -= b", ic);
+		map_difference_inplace(sc, sb);
+		print_map_sum("splay a -= b", sc);
+		map_union_inplace(sc, sb);
+		print_map_sum("then |= b", sc);
+		map_intersection_inplace(sc, sb);
+		print_map_sum("then &= b", sc);
+
+		parallel_for_each(ia, double_value(), 3);
+		parallel_for_each(sa, double_value(), 3);
+		std::cout << "parallel: inline " << parallel_reduce(ia, 0L, sum_values(), 3) << ", splay "
+			<< parallel_reduce(sa, 0L, sum_values(), 3) << ", sampled " << parallel_reduce(pa, 0L, sum_values(), 3)
+			<< ", keys " << parallel_reduce(ia, std::string(), join_keys(), 2) << std::endl;
+
+		NS::vector<NS::pair<int, int> >	input(sb.begin(), sb.end());
+
+		std::reverse(input.begin(), input.end());
+		build_parallel(ic, input.begin(), input.begin() + 3, 2);
+		build_parallel(sc, input.begin(), input.end(), 4);
+		print_map_sum("inline build_parallel", ic);
+		print_map_sum("splay build_parallel", sc);
+
+		save_map(sa, path);
+		load_map(ic, path);
+		print_map_sum("splay saved, inline loaded", ic);
+		save_map(ib, path);
+		load_map(sc, path);
+		print_map_sum("inline saved, splay loaded", sc);
+		{
+			MAP_SNAPSHOT(int, int)	snap(path);
+
+			std::cout << "snapshot of the inline map: size " << snap.size() << ", find(4) " << snap.find(4)->second
+				<< ", count(3) " << snap.count(3) << std::endl;
+		}
+		std::remove(path);
+
+		EYTZINGER_INDEX(int)	from_inline(ia);
+		EYTZINGER_INDEX(int)	from_splay(sa);
+		EYTZINGER_INDEX(int)	from_sampled(pa);
+
+		std::cout << "eytzinger: sizes " << from_inline.size() << ' ' << from_splay.size() << ' ' << from_sampled.size()
+			<< ", lower_bound(6) " << from_inline.lower_bound(6) << ' ' << from_splay.lower_bound(6) << ' '
+			<< from_sampled.lower_bound(6) << ", key(7) " << from_inline.key(7) << ' ' << from_splay.key(7) << ' '
+			<< from_sampled.key(7) << std::endl;
+	}
+
+
+
+	std::cout << "\n\n*************************************************************************" << std::endl;
+	std::cout << "\t\t\t\tMultimap" << std::endl;
+	std::cout << "*************************************************************************" << std::endl;
+
+	{
+		std::cout << "\n------------- FT Multimap (insert & iterator) -------------" << std::endl;
+		NS::multimap<char, int> mymm;
+		mymm.insert(NS::pair<char, int>('a', 100));
+		mymm.insert(NS::pair<char, int>('z', 150));
+		NS::multimap<char, int>::iterator it = mymm.insert(NS::pair<char, int>('b', 75));
+		mymm.insert(it, NS::pair<char, int>('c', 300));
+		mymm.insert(it, NS::pair<char, int>('d', 400));
+		mymm.insert(NS::pair<char, int>('b', 25));
+		mymm.insert(NS::pair<char, int>('b', 50));
+		std::cout << "mymm contains (repeated keys in insertion order):" << std::endl;
+		for (it = mymm.begin(); it != mymm.end(); ++it)
+			std::cout << it->first << " => " << it->second << std::endl;
+		std::cout << "size: " << mymm.size() << std::endl;
+
+		NS::multimap<char, int> copy(mymm);
+		NS::multimap<char, int> range(mymm.begin(), mymm.find('c'));
+		std::cout << "copy == mymm: " << (copy == mymm) << ", range < mymm: " << (range < mymm) << std::endl;
+		std::cout << "range contains:";
+		for (NS::multimap<char, int>::reverse_iterator rit = range.rbegin(); rit != range.rend(); ++rit)
+			std::cout << ' ' << rit->first << ':' << rit->second;
+		std::cout << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Multimap (count, equal_range & erase) -------------" << std::endl;
+		NS::multimap<char, int> mymm;
+		mymm.insert(NS::make_pair('x', 10));
+		mymm.insert(NS::make_pair('y', 20));
+		mymm.insert(NS::make_pair('y', 30));
+		mymm.insert(NS::make_pair('y', 40));
+		mymm.insert(NS::make_pair('z', 50));
+		mymm.insert(NS::make_pair('z', 60));
+		for (char c = 'w'; c <= 'z'; c++)
+		{
+			std::cout << "There are " << mymm.count(c) << " elements with key " << c << ":";
+			NS::pair<NS::multimap<char, int>::iterator, NS::multimap<char, int>::iterator> ret = mymm.equal_range(c);
+			for (NS::multimap<char, int>::iterator it = ret.first; it != ret.second; ++it)
+				std::cout << ' ' << it->second;
+			std::cout << std::endl;
+		}
+		std::cout << "lower_bound(y): " << mymm.lower_bound('y')->second << std::endl;
+		std::cout << "upper_bound(y): " << mymm.upper_bound('y')->second << std::endl;
+		std::cout << "erase(y) removed " << mymm.erase('y') << " elements" << std::endl;
+		mymm.erase(mymm.begin());
+		std::cout << "mymm now contains:";
+		for (NS::multimap<char, int>::const_iterator it = mymm.begin(); it != mymm.end(); ++it)
+			std::cout << ' ' << it->first << ':' << it->second;
+		std::cout << std::endl;
+		mymm.clear();
+		std::cout << "size after clear: " << mymm.size() << std::endl;
+	}
+
+
+	std::cout << "\n\n*************************************************************************" << std::endl;
+	std::cout << "\t\t\t\tSet" << std::endl;
+	std::cout << "*************************************************************************" << std::endl;
+
+	{
+		std::cout << "\n------------- FT Set (construct & iterator) -------------" << std::endl;
+		int myints[] = {75, 23, 65, 42, 13, 23, 75};
+		NS::set<int> first;
+		NS::set<int> second(myints, myints + 7);
+		NS::set<int> third(second);
+		std::cout << "first size: " << first.size() << std::endl;
+		std::cout << "second contains:";
+		for (NS::set<int>::iterator it = second.begin(); it != second.end(); ++it)
+			std::cout << ' ' << *it;
+		std::cout << std::endl << "third in reverse:";
+		for (NS::set<int>::reverse_iterator rit = third.rbegin(); rit != third.rend(); ++rit)
+			std::cout << ' ' << *rit;
+		std::cout << std::endl;
+		first = third;
+		std::cout << "first == second: " << (first == second) << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Set (insert, erase & find) -------------" << std::endl;
+		NS::set<std::string> myset;
+		NS::pair<NS::set<std::string>::iterator, bool> ret;
+		ret = myset.insert("pear");
+		std::cout << "insert pear: " << *ret.first << " " << ret.second << std::endl;
+		ret = myset.insert("apple");
+		ret = myset.insert("pear");
+		std::cout << "insert pear again: " << *ret.first << " " << ret.second << std::endl;
+		myset.insert(myset.begin(), "fig");
+		myset.insert("kiwi");
+		myset.insert("banana");
+		std::cout << "myset contains:";
+		for (NS::set<std::string>::iterator it = myset.begin(); it != myset.end(); ++it)
+			std::cout << ' ' << *it;
+		std::cout << std::endl;
+		std::cout << "erase(fig): " << myset.erase("fig") << ", erase(plum): " << myset.erase("plum") << std::endl;
+		myset.erase(myset.find("banana"));
+		std::cout << "count(kiwi): " << myset.count("kiwi") << ", count(fig): " << myset.count("fig") << std::endl;
+		std::cout << "find(plum) == end(): " << (myset.find("plum") == myset.end()) << std::endl;
+		myset.erase(myset.begin(), myset.find("pear"));
+		std::cout << "myset now contains:";
+		for (NS::set<std::string>::iterator it = myset.begin(); it != myset.end(); ++it)
+			std::cout << ' ' << *it;
+		std::cout << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Set (bounds, swap & compare) -------------" << std::endl;
+		NS::set<int> myset;
+		for (int i = 1; i < 10; i++)
+			myset.insert(i * 10);
+		std::cout << "lower_bound(30): " << *myset.lower_bound(30) << std::endl;
+		std::cout << "upper_bound(60): " << *myset.upper_bound(60) << std::endl;
+		std::cout << "equal_range(35): " << *myset.equal_range(35).first << " " << *myset.equal_range(35).second << std::endl;
+		myset.erase(myset.lower_bound(30), myset.upper_bound(60));
+		NS::set<int> other;
+		other.insert(5);
+		other.swap(myset);
+		std::cout << "other contains:";
+		for (NS::set<int>::iterator it = other.begin(); it != other.end(); ++it)
+			std::cout << ' ' << *it;
+		std::cout << std::endl << "myset size: " << myset.size() << std::endl;
+		std::cout << "myset < other: " << (myset < other) << ", myset >= other: " << (myset >= other) << std::endl;
+		std::cout << "key_comp()(1, 2): " << myset.key_comp()(1, 2) << ", value_comp()(2, 1): " << myset.value_comp()(2, 1) << std::endl;
+	}
+
+
+	std::cout << "\n\n*************************************************************************" << std::endl;
+	std::cout << "\t\t\t\tMultiset" << std::endl;
+	std::cout << "*************************************************************************" << std::endl;
+
+	{
+		std::cout << "\n------------- FT Multiset -------------" << std::endl;
+		int myints[] = {10, 73, 12, 22, 73, 73, 12};
+		NS::multiset<int> mymultiset(myints, myints + 7);
+		std::cout << "mymultiset contains:";
+		for (NS::multiset<int>::iterator it = mymultiset.begin(); it != mymultiset.end(); ++it)
+			std::cout << ' ' << *it;
+		std::cout << std::endl;
+		std::cout << "73 appears " << mymultiset.count(73) << " times, 5 appears " << mymultiset.count(5) << " times" << std::endl;
+		mymultiset.insert(12);
+		NS::pair<NS::multiset<int>::iterator, NS::multiset<int>::iterator> ret = mymultiset.equal_range(12);
+		std::cout << "equal_range(12):";
+		for (NS::multiset<int>::iterator it = ret.first; it != ret.second; ++it)
+			std::cout << ' ' << *it;
+		std::cout << std::endl;
+		std::cout << "erase(73) removed " << mymultiset.erase(73) << " elements" << std::endl;
+		mymultiset.erase(mymultiset.find(10));
+		NS::multiset<int> copy;
+		copy = mymultiset;
+		std::cout << "copy contains:";
+		for (NS::multiset<int>::reverse_iterator rit = copy.rbegin(); rit != copy.rend(); ++rit)
+			std::cout << ' ' << *rit;
+		std::cout << std::endl << "copy == mymultiset: " << (copy == mymultiset) << std::endl;
+	}
+
+
+	std::cout << "\n\n*************************************************************************" << std::endl;
+	std::cout << "\t\t\t\tRadix map" << std::endl;
+	std::cout << "*************************************************************************" << std::endl;
+
+
+	{
+		std::cout << "\n------------- FT Radix map (insert, find & erase) -------------" << std::endl;
+		RADIX_MAP(int, int) m;
+		srand(42);
+		for (int i = 0; i < 3000; i++)
+		{
+			int k = rand() % 2000 - 1000;						// Negativos también, que tienen el bit de signo puesto
+			NS::pair<RADIX_MAP(int, int)::iterator, bool> ret = m.insert(NS::make_pair(k, i));
+			if (i % 500 == 0)
+				std::cout << "insert(" << k << "): " << ret.second << ", value " << ret.first->second << std::endl;
+		}
+		m[-2147483647 - 1] = 1;
+		m[2147483647] = 2;
+		m[0] = 3;
+		long sum = 0;
+		int prev = 0;
+		bool sorted = true;
+		for (RADIX_MAP(int, int)::iterator it = m.begin(); it != m.end(); ++it)
+		{
+			if (it != m.begin() && it->first <= prev)
+				sorted = false;
+			prev = it->first;
+			sum += static_cast<long>(it->first) * 7 + it->second;
+		}
+		std::cout << "size " << m.size() << ", sorted " << sorted << ", sum " << sum << std::endl;
+		std::cout << "front " << m.begin()->first << ", back " << m.rbegin()->first << std::endl;
+		int erased = 0;
+		for (int k = -1000; k < 1000; k += 3)
+			erased += m.erase(k);
+		m.erase(m.find(2147483647));
+		std::cout << "erased " << erased << ", size " << m.size() << ", count(3) " << m.count(3)
+			<< ", count(4) " << m.count(4) << ", find(-1000) == end: " << (m.find(-1000) == m.end()) << std::endl;
+		RADIX_MAP(int, int)::iterator first = m.lower_bound(-100);
+		RADIX_MAP(int, int)::iterator last = m.upper_bound(100);
+		m.erase(first, last);
+		std::cout << "after erase [-100, 100], size " << m.size() << ":";
+		for (RADIX_MAP(int, int)::iterator it = m.lower_bound(-130); it != m.upper_bound(130); ++it)
+			std::cout << ' ' << it->first;
+		std::cout << std::endl;
+		int probes[] = {-2147483647 - 1, -1001, -1000, -101, -99, 0, 99, 101, 998, 999, 1000, 2147483647};
+		for (size_t i = 0; i < sizeof(probes) / sizeof(int); i++)
+		{
+			RADIX_MAP(int, int)::iterator lb = m.lower_bound(probes[i]);
+			RADIX_MAP(int, int)::iterator ub = m.upper_bound(probes[i]);
+			std::cout << "bounds(" << probes[i] << "): ";
+			if (lb == m.end())
+				std::cout << "end";
+			else
+				std::cout << lb->first;
+			std::cout << ' ';
+			if (ub == m.end())
+				std::cout << "end";
+			else
+				std::cout << ub->first;
+			std::cout << std::endl;
+		}
+		m.clear();
+		std::cout << "after clear: size " << m.size() << ", empty " << m.empty() << std::endl;
+	}
+
+	{
+		std::cout << "\n------------- FT Radix map (string keys) -------------" << std::endl;
+		// Claves que comparten mucho más de 8 bytes (el prefijo que se salta cada nodo), claves que son
+		// prefijo de otras, la cadena vacía, y claves con bytes \0 y 0xff, que tienen que ordenarse como
+		// unsigned char igual que en std::string
+		const std::string	base = "common/prefix/shared/by/all/keys/";
+		RADIX_MAP(std::string, int) m;
+		m[base + "a"] = 1;
+		m[base + "ab"] = 2;
+		m[base + "abc/more/than/eight/bytes/long/x"] = 3;
+		m[base + "abc/more/than/eight/bytes/long/y"] = 4;
+		m[base] = 5;
+		m[base.substr(0, 9)] = 6;
+		m[base.substr(0, 17)] = 7;
+		m[""] = 8;
+		m[std::string(1, '\0')] = 9;
+		m[std::string(2, '\0')] = 10;
+		m[std::string("a\0b", 3)] = 11;
+		m[std::string("a\0", 2)] = 12;
+		m["a"] = 13;
+		m["a\xff"] = 14;
+		m["\xff"] = 15;
+		m["\xff\xff"] = 16;
+		m[std::string("\xff\0", 2)] = 17;
+		m[base + std::string("\0\xff", 2)] = 18;
+		m[base + "\xff"] = 19;
+		for (int i = 0; i < 200; i++)
+		{
+			char	buf[16];
+
+			for (int j = 0; j < 15; j++)
+				buf[j] = "ab\0\xff"[rand() % 4];
+			buf[15] = 'z';
+			m[base + "r" + std::string(buf, rand() % 16 + 1)] += i;
+		}
+		std::cout << "size " << m.size() << std::endl;
+		int n = 0;
+		long sum = 0;
+		bool sorted = true;
+		std::string prev;
+		for (RADIX_MAP(std::string, int)::iterator it = m.begin(); it != m.end(); ++it, ++n)
+		{
+			if (it != m.begin() && !(prev < it->first))
+				sorted = false;
+			prev = it->first;
+			sum += (n + 1) * it->second;
+			if (it->first.compare(0, base.size() + 1, base + "r") != 0)	// Las al azar solo cuentan en la suma
+			{
+				print_key(it->first);
+				std::cout << " => " << it->second << std::endl;
+			}
+		}
+		std::cout << "sorted " << sorted << ", sum " << sum << std::endl;
+		std::string probes[] = {"", std::string(1, '\0'), "a", std::string("a\0a", 3), "\xff", "\xff\xff\xff",
+			base.substr(0, 12), base + "a", base + "abc", base + "abc/more/than/eight/bytes/long/xx", base + "r",
+			base + std::string("r\0\0", 3), base + "r\xff", base + "\xff\xff"};
+		for (size_t i = 0; i < sizeof(probes) / sizeof(std::string); i++)
+		{
+			RADIX_MAP(std::string, int)::iterator lb = m.lower_bound(probes[i]);
+			RADIX_MAP(std::string, int)::iterator ub = m.upper_bound(probes[i]);
+			std::cout << "bounds(";
+			print_key(probes[i]);
+			std::cout << "): ";
+			if (lb == m.end())
+				std::cout << "end";
+			else
+				print_key(lb->first);
+			std::cout << ' ';
+			if (ub == m.end())
+				std::cout << "end";
+			else
+				print_key(ub->first);
+			std::cout << std::endl;
+		}
+		std::cout << "erase(\\0): " << m.erase(std::string(1, '\0')) << ", erase(\\0\\0\\0): " << m.erase(std::string(3, '\0'))
+			<< ", erase(base): " << m.erase(base) << std::endl;
+		m.erase(m.lower_bound(base + "a"), m.lower_bound(base + "b"));
+		m.erase(m.lower_bound(base + "r"), m.lower_bound(base + "r\xff\xff"));
+		std::cout << "after erasing [base + a, base + b) and most of base + r, size " << m.size() << ":";
+		for (RADIX_MAP(std::string, int)::iterator it = m.begin(); it != m.end(); ++it)
+		{
+			std::cout << ' ';
+			print_key(it->first);
+		}
+		std::cout << std::endl;
+	}
+
 
 	std::cout << "\n\n*************************************************************************" << std::endl;
 	std::cout << "\t\t\t\tStack" << std::endl;